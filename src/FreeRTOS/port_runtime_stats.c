@@ -0,0 +1,76 @@
+/*
+ * Run time statistics for the FreeRTOS kernel (configGENERATE_RUN_TIME_STATS)
+ *
+ * The run time counter is RTC2, clocked by the LFCLK without prescaler (32768Hz). A TIMER
+ * would be more precise, but it would keep the HFCLK running and the CPU would never really
+ * sleep while the statistics are enabled. The 24 bits of the RTC are extended to 32 bits by
+ * counting the overflows (every 512s).
+ *
+ * Context switches and the time spent in the instrumented interrupt handlers are also
+ * accounted here.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if configGENERATE_RUN_TIME_STATS == 1
+
+static volatile uint32_t overflowCount = 0;
+static volatile uint32_t contextSwitchCount = 0;
+static volatile uint32_t isrRunTime = 0;
+static void* previousTask = NULL;
+
+void vPortConfigureRunTimeStatsTimer(void) {
+  NRF_RTC2->PRESCALER = 0;
+  NRF_RTC2->EVENTS_OVRFLW = 0;
+  NRF_RTC2->INTENSET = RTC_INTENSET_OVRFLW_Msk;
+  NVIC_SetPriority(RTC2_IRQn, _PRIO_APP_LOWEST);
+  NVIC_ClearPendingIRQ(RTC2_IRQn);
+  NVIC_EnableIRQ(RTC2_IRQn);
+  NRF_RTC2->TASKS_START = 1;
+}
+
+void RTC2_IRQHandler(void) {
+  if (NRF_RTC2->EVENTS_OVRFLW) {
+    NRF_RTC2->EVENTS_OVRFLW = 0;
+    overflowCount++;
+  }
+}
+
+uint32_t ulPortGetRunTimeCounterValue(void) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  uint32_t overflows = overflowCount;
+  uint32_t counter = NRF_RTC2->COUNTER;
+  /* The overflow may not be handled yet, when called from the kernel or from an interrupt handler */
+  if (NRF_RTC2->EVENTS_OVRFLW) {
+    overflows++;
+    counter = NRF_RTC2->COUNTER;
+  }
+  __set_PRIMASK(primask);
+  return (overflows << 24) | counter;
+}
+
+void vPortTaskSwitchedIn(void* task) {
+  if (task != previousTask) {
+    previousTask = task;
+    contextSwitchCount++;
+  }
+}
+
+uint32_t ulPortGetContextSwitchCount(void) {
+  return contextSwitchCount;
+}
+
+void vPortIsrExit(uint32_t isrStart) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  isrRunTime += ulPortGetRunTimeCounterValue() - isrStart;
+  __set_PRIMASK(primask);
+}
+
+uint32_t ulPortGetIsrRunTime(void) {
+  return isrRunTime;
+}
+
+#endif
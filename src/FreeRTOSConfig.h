@@ -83,7 +83,11 @@
 #define configUSE_MALLOC_FAILED_HOOK   0
 
 /* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS        0
+#ifdef USE_RUNTIME_STATS
+  #define configGENERATE_RUN_TIME_STATS 1
+#else
+  #define configGENERATE_RUN_TIME_STATS 0
+#endif
 #define configUSE_TRACE_FACILITY             1
 #define configUSE_STATS_FORMATTING_FUNCTIONS 0
 
@@ -185,6 +189,26 @@ standard names - or at least those used in the unmodified vector table. */
     #include <stdint.h>
 extern uint32_t SystemCoreClock;
   #endif
+
+  /* Run time statistics, implemented in port_runtime_stats.c. The counter runs at 32768Hz. */
+  #if (configGENERATE_RUN_TIME_STATS == 1)
+    #include <stdint.h>
+    #ifdef __cplusplus
+extern "C" {
+    #endif
+void vPortConfigureRunTimeStatsTimer(void);
+uint32_t ulPortGetRunTimeCounterValue(void);
+void vPortTaskSwitchedIn(void* task);
+uint32_t ulPortGetContextSwitchCount(void);
+void vPortIsrExit(uint32_t isrStart);
+uint32_t ulPortGetIsrRunTime(void);
+    #ifdef __cplusplus
+}
+    #endif
+    #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() vPortConfigureRunTimeStatsTimer()
+    #define portGET_RUN_TIME_COUNTER_VALUE()         ulPortGetRunTimeCounterValue()
+    #define traceTASK_SWITCHED_IN()                  vPortTaskSwitchedIn(pxCurrentTCB)
+  #endif
 #endif /* !assembler */
 
 /** Implementation note:  Use this with caution and set this to 1 ONLY for debugging
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include "components/ble/NotificationManager.h"
 #include "systemtask/SystemTask.h"
+#include "logging/Trace.h"
 
 using namespace Pinetime::Controllers;
 
@@ -53,6 +54,7 @@ int AlertNotificationService::OnAlert(uint16_t conn_handle, uint16_t attr_handle
 
     // Ignore notifications with empty message
     const auto packetLen = OS_MBUF_PKTLEN(ctxt->om);
+    Pinetime::Logging::Trace::Scope trace {Pinetime::Logging::Trace::Events::BleAlert, packetLen};
     if (packetLen <= headerSize) {
       return 0;
     }
@@ -61,24 +63,24 @@ int AlertNotificationService::OnAlert(uint16_t conn_handle, uint16_t attr_handle
     auto messageSize = std::min(maxMessageSize, (bufferSize - headerSize));
     Categories category;
 
-    NotificationManager::Notification notif;
-    os_mbuf_copydata(ctxt->om, headerSize, messageSize - 1, notif.message.data());
+    char message[maxMessageSize + 1];
+    os_mbuf_copydata(ctxt->om, headerSize, messageSize - 1, message);
     os_mbuf_copydata(ctxt->om, 0, 1, &category);
-    notif.message[messageSize - 1] = '\0';
-    notif.size = messageSize;
+    message[messageSize - 1] = '\0';
 
     // TODO convert all ANS categories to NotificationController categories
+    NotificationManager::Categories notificationCategory;
     switch (category) {
       case Categories::Call:
-        notif.category = Pinetime::Controllers::NotificationManager::Categories::IncomingCall;
+        notificationCategory = Pinetime::Controllers::NotificationManager::Categories::IncomingCall;
         break;
       default:
-        notif.category = Pinetime::Controllers::NotificationManager::Categories::SimpleAlert;
+        notificationCategory = Pinetime::Controllers::NotificationManager::Categories::SimpleAlert;
         break;
     }
 
     auto event = Pinetime::System::Messages::OnNewNotification;
-    notificationManager.Push(std::move(notif));
+    notificationManager.Push(notificationCategory, message, messageSize);
     systemTask.PushMessage(event);
   }
   return 0;
@@ -0,0 +1,175 @@
+#include "components/ble/ConnectionParameters.h"
+#include <nrf_log.h>
+#define min // workaround: nimble's min/max macros conflict with libstdc++
+#define max
+#include <host/ble_gap.h>
+#undef max
+#undef min
+#include "systemtask/SystemTask.h"
+#include "utility/LockGuard.h"
+
+using namespace Pinetime::Controllers;
+using Pinetime::Utility::LockGuard;
+
+constexpr ConnectionParameters::Parameters ConnectionParameters::idleParameters;
+constexpr ConnectionParameters::Parameters ConnectionParameters::bulkParameters;
+
+namespace {
+  void IdleTimerCallback(TimerHandle_t xTimer) {
+    auto* systemTask = static_cast<Pinetime::System::SystemTask*>(pvTimerGetTimerID(xTimer));
+    systemTask->PushMessage(Pinetime::System::Messages::BleConnectionIdleTimerExpired);
+  }
+}
+
+ConnectionParameters::ConnectionParameters(Pinetime::System::SystemTask& systemTask) : systemTask {systemTask} {
+}
+
+void ConnectionParameters::Init() {
+  mutex = xSemaphoreCreateMutex();
+  ASSERT(mutex != nullptr);
+  idleTimer = xTimerCreate("connParams", pdMS_TO_TICKS(idleDelay), pdFALSE, &systemTask, IdleTimerCallback);
+}
+
+void ConnectionParameters::OnConnect(uint16_t connectionHandle) {
+  LockGuard lock {mutex};
+  SetAppliedProfile(Profiles::Default);
+  this->connectionHandle = connectionHandle;
+  connected = true;
+  requestPending = false;
+  requestedProfile = Profiles::Default;
+
+  ble_gap_conn_desc desc;
+  if (ble_gap_conn_find(connectionHandle, &desc) == 0) {
+    interval = desc.conn_itvl;
+    latency = desc.conn_latency;
+  }
+
+  if (activities != 0) {
+    Request(Profiles::Bulk);
+  } else {
+    xTimerStart(idleTimer, 0);
+  }
+}
+
+void ConnectionParameters::OnDisconnect() {
+  LockGuard lock {mutex};
+  xTimerStop(idleTimer, 0);
+  SetAppliedProfile(Profiles::Default);
+  connected = false;
+  requestPending = false;
+  requestedProfile = Profiles::Default;
+  // The transfers are aborted with the connection
+  activities = 0;
+}
+
+void ConnectionParameters::OnParametersUpdated(int status) {
+  LockGuard lock {mutex};
+  if (!connected) {
+    return;
+  }
+  requestPending = false;
+
+  ble_gap_conn_desc desc;
+  if (ble_gap_conn_find(connectionHandle, &desc) == 0) {
+    interval = desc.conn_itvl;
+    latency = desc.conn_latency;
+  }
+  NRF_LOG_INFO("[ConnParams] status=%d interval=%d latency=%d", status, interval, latency);
+
+  if (status != 0) {
+    nbRejectedRequests++;
+    return;
+  }
+
+  // The update might have been initiated by the central : keep the profile only if the parameters are in its range
+  const Parameters& parameters = (requestedProfile == Profiles::Bulk) ? bulkParameters : idleParameters;
+  if (requestedProfile != Profiles::Default && interval >= parameters.intervalMin && interval <= parameters.intervalMax &&
+      latency == parameters.latency) {
+    SetAppliedProfile(requestedProfile);
+  } else {
+    SetAppliedProfile(Profiles::Default);
+  }
+
+  // The profile has changed while the previous request was in progress
+  Profiles wanted = (activities != 0) ? Profiles::Bulk : requestedProfile;
+  if (wanted != appliedProfile && wanted != Profiles::Default) {
+    Request(wanted);
+  }
+}
+
+void ConnectionParameters::StartActivity(Activities activity) {
+  LockGuard lock {mutex};
+  bool wasIdle = (activities == 0);
+  activities |= static_cast<uint8_t>(activity);
+  if (wasIdle && connected) {
+    xTimerStop(idleTimer, 0);
+    Request(Profiles::Bulk);
+  }
+}
+
+void ConnectionParameters::StopActivity(Activities activity) {
+  LockGuard lock {mutex};
+  activities &= ~static_cast<uint8_t>(activity);
+  if (activities == 0 && connected) {
+    xTimerStart(idleTimer, 0);
+  }
+}
+
+void ConnectionParameters::OnIdleTimer() {
+  LockGuard lock {mutex};
+  if (activities == 0 && connected) {
+    Request(Profiles::Idle);
+  }
+}
+
+void ConnectionParameters::Request(Profiles profile) {
+  requestedProfile = profile;
+  if (profile == appliedProfile || requestPending) {
+    // A pending request is followed by a new one if needed, see OnParametersUpdated()
+    return;
+  }
+
+  const Parameters& parameters = (profile == Profiles::Bulk) ? bulkParameters : idleParameters;
+  ble_gap_upd_params params {};
+  params.itvl_min = parameters.intervalMin;
+  params.itvl_max = parameters.intervalMax;
+  params.latency = parameters.latency;
+  params.supervision_timeout = parameters.supervisionTimeout;
+  params.min_ce_len = 0;
+  params.max_ce_len = 0;
+
+  nbRequests++;
+  int res = ble_gap_update_params(connectionHandle, &params);
+  if (res == 0) {
+    requestPending = true;
+  } else {
+    NRF_LOG_INFO("[ConnParams] update request failed : %d", res);
+    nbRejectedRequests++;
+  }
+}
+
+void ConnectionParameters::SetAppliedProfile(Profiles profile) {
+  uint32_t now = xTaskGetTickCount();
+  if (connected) {
+    timeInProfile[static_cast<uint8_t>(appliedProfile)] += now - profileStart;
+  }
+  profileStart = now;
+  appliedProfile = profile;
+}
+
+ConnectionParameters::Statistics ConnectionParameters::GetStatistics() {
+  LockGuard lock {mutex};
+  Statistics statistics {};
+  for (uint8_t i = 0; i < nbProfiles; i++) {
+    uint32_t ticks = timeInProfile[i];
+    if (connected && i == static_cast<uint8_t>(appliedProfile)) {
+      ticks += xTaskGetTickCount() - profileStart;
+    }
+    statistics.timeInProfile[i] = ticks / configTICK_RATE_HZ;
+  }
+  statistics.nbRequests = nbRequests;
+  statistics.nbRejectedRequests = nbRejectedRequests;
+  statistics.interval = connected ? interval : 0;
+  statistics.latency = connected ? latency : 0;
+  return statistics;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include <timers.h>
+
+namespace Pinetime {
+  namespace System {
+    class SystemTask;
+  }
+  namespace Controllers {
+    /* Requests connection parameters that depend on the BLE activity :
+     *  - Bulk : short interval, no slave latency, while a file transfer or a firmware update is running
+     *  - Idle : long interval and slave latency, the rest of the time
+     * Until the first request is accepted, the parameters chosen by the central are used (Default).
+     *
+     * The idle parameters are requested some time after the end of the last activity (or after the connection),
+     * so that consecutive transfers and the service discovery are not slowed down.
+     *
+     * The state is updated from the BLE host task (GAP events) and from SystemTask (activities, idle timer), under a mutex.
+     * The idle timer only posts a message : the request is sent from SystemTask, not from the timer task.
+     */
+    class ConnectionParameters {
+    public:
+      enum class Profiles : uint8_t { Default, Idle, Bulk };
+      enum class Activities : uint8_t { FileTransfer = 0x01, FirmwareUpdate = 0x02 };
+      static constexpr uint8_t nbProfiles = 3;
+
+      struct Statistics {
+        // Connected time spent with the parameters of each profile, in seconds
+        uint32_t timeInProfile[nbProfiles];
+        uint16_t nbRequests;
+        uint16_t nbRejectedRequests;
+        // Current parameters, interval in units of 1.25ms
+        uint16_t interval;
+        uint16_t latency;
+      };
+
+      explicit ConnectionParameters(Pinetime::System::SystemTask& systemTask);
+      void Init();
+      void OnConnect(uint16_t connectionHandle);
+      void OnDisconnect();
+      // BLE_GAP_EVENT_CONN_UPDATE
+      void OnParametersUpdated(int status);
+
+      void StartActivity(Activities activity);
+      void StopActivity(Activities activity);
+
+      Profiles CurrentProfile() const {
+        return appliedProfile;
+      }
+      Statistics GetStatistics();
+
+      // Called by SystemTask when the idle timer has expired
+      void OnIdleTimer();
+
+    private:
+      struct Parameters {
+        uint16_t intervalMin;
+        uint16_t intervalMax;
+        uint16_t latency;
+        uint16_t supervisionTimeout;
+      };
+      // Within the limits accepted by iOS and Android : interval >= 15ms, interval * (latency + 1) <= 2s
+      // and supervision timeout > 3 * interval * (latency + 1)
+      static constexpr Parameters idleParameters {80, 120, 4, 500};
+      static constexpr Parameters bulkParameters {12, 24, 0, 400};
+      static constexpr uint32_t idleDelay = 10000; // ms
+
+      Pinetime::System::SystemTask& systemTask;
+      TimerHandle_t idleTimer;
+      SemaphoreHandle_t mutex;
+      uint16_t connectionHandle;
+      bool connected = false;
+      uint8_t activities = 0;
+      Profiles requestedProfile = Profiles::Default;
+      Profiles appliedProfile = Profiles::Default;
+      bool requestPending = false;
+
+      uint32_t profileStart = 0;
+      uint32_t timeInProfile[nbProfiles] = {0};
+      uint16_t nbRequests = 0;
+      uint16_t nbRejectedRequests = 0;
+      uint16_t interval = 0;
+      uint16_t latency = 0;
+
+      void Request(Profiles profile);
+      void SetAppliedProfile(Profiles profile);
+    };
+  }
+}
@@ -0,0 +1,230 @@
+#include "components/ble/DebugService.h"
+#include <algorithm>
+#include <cstring>
+#include <nrf_log.h>
+#include <task.h>
+#include "components/ble/ConnectionParameters.h"
+#include "components/fs/FS.h"
+#include "logging/Trace.h"
+#include "systemtask/SystemMonitor.h"
+
+using namespace Pinetime::Controllers;
+
+namespace {
+  // 0005yyxx-78fc-48fe-8e23-433b3a1942d0
+  constexpr ble_uuid128_t CharUuid(uint8_t x, uint8_t y) {
+    return ble_uuid128_t {.u = {.type = BLE_UUID_TYPE_128},
+                          .value = {0xd0, 0x42, 0x19, 0x3a, 0x3b, 0x43, 0x23, 0x8e, 0xfe, 0x48, 0xfc, 0x78, x, y, 0x05, 0x00}};
+  }
+
+  // 00050000-78fc-48fe-8e23-433b3a1942d0
+  constexpr ble_uuid128_t BaseUuid() {
+    return CharUuid(0x00, 0x00);
+  }
+
+  constexpr ble_uuid128_t debugServiceUuid {BaseUuid()};
+  constexpr ble_uuid128_t runTimeStatsCharUuid {CharUuid(0x01, 0x00)};
+  constexpr ble_uuid128_t traceDumpCharUuid {CharUuid(0x02, 0x00)};
+  constexpr ble_uuid128_t storageStatsCharUuid {CharUuid(0x03, 0x00)};
+  constexpr ble_uuid128_t connectionStatsCharUuid {CharUuid(0x04, 0x00)};
+  constexpr ble_uuid128_t wakeUpStatsCharUuid {CharUuid(0x05, 0x00)};
+
+  uint8_t* Write16(uint8_t* buffer, uint16_t value) {
+    buffer[0] = value & 0xff;
+    buffer[1] = value >> 8;
+    return buffer + 2;
+  }
+
+  uint8_t* Write32(uint8_t* buffer, uint32_t value) {
+    return Write16(Write16(buffer, value & 0xffff), value >> 16);
+  }
+
+  int DebugServiceCallback(uint16_t conn_handle, uint16_t attr_handle, struct ble_gatt_access_ctxt* ctxt, void* arg) {
+    auto* debugService = static_cast<DebugService*>(arg);
+    return debugService->OnCommand(conn_handle, attr_handle, ctxt);
+  }
+}
+
+DebugService::DebugService(Controllers::FS& fs,
+                           Controllers::ConnectionParameters& connectionParameters,
+                           const Pinetime::System::SystemMonitor& systemMonitor)
+  : fs {fs},
+    connectionParameters {connectionParameters},
+    systemMonitor {systemMonitor},
+    characteristicDefinition {{.uuid = &runTimeStatsCharUuid.u,
+                               .access_cb = DebugServiceCallback,
+                               .arg = this,
+                               .flags = BLE_GATT_CHR_F_READ,
+                               .val_handle = &runTimeStatsHandle},
+                              {.uuid = &traceDumpCharUuid.u,
+                               .access_cb = DebugServiceCallback,
+                               .arg = this,
+                               .flags = BLE_GATT_CHR_F_WRITE,
+                               .val_handle = &traceDumpHandle},
+                              {.uuid = &storageStatsCharUuid.u,
+                               .access_cb = DebugServiceCallback,
+                               .arg = this,
+                               .flags = BLE_GATT_CHR_F_READ,
+                               .val_handle = &storageStatsHandle},
+                              {.uuid = &connectionStatsCharUuid.u,
+                               .access_cb = DebugServiceCallback,
+                               .arg = this,
+                               .flags = BLE_GATT_CHR_F_READ,
+                               .val_handle = &connectionStatsHandle},
+                              {.uuid = &wakeUpStatsCharUuid.u,
+                               .access_cb = DebugServiceCallback,
+                               .arg = this,
+                               .flags = BLE_GATT_CHR_F_READ,
+                               .val_handle = &wakeUpStatsHandle},
+                              {0}},
+    serviceDefinition {
+      {.type = BLE_GATT_SVC_TYPE_PRIMARY, .uuid = &debugServiceUuid.u, .characteristics = characteristicDefinition},
+      {0},
+    } {
+}
+
+void DebugService::Init() {
+  int res = 0;
+  res = ble_gatts_count_cfg(serviceDefinition);
+  ASSERT(res == 0);
+
+  res = ble_gatts_add_svcs(serviceDefinition);
+  ASSERT(res == 0);
+}
+
+int DebugService::OnCommand(uint16_t connectionHandle, uint16_t attributeHandle, ble_gatt_access_ctxt* context) {
+  if (attributeHandle == runTimeStatsHandle) {
+    return OnRunTimeStatsRequested(context);
+  }
+  if (attributeHandle == traceDumpHandle) {
+    return OnTraceDumpRequested();
+  }
+  if (attributeHandle == storageStatsHandle) {
+    return OnStorageStatsRequested(context);
+  }
+  if (attributeHandle == connectionStatsHandle) {
+    return OnConnectionStatsRequested(context);
+  }
+  if (attributeHandle == wakeUpStatsHandle) {
+    return OnWakeUpStatsRequested(context);
+  }
+  return 0;
+}
+
+int DebugService::OnRunTimeStatsRequested(ble_gatt_access_ctxt* context) {
+#if configGENERATE_RUN_TIME_STATS == 1
+  if (snapshotSize == 0 || xTaskGetTickCount() - snapshotTime > snapshotLifetime) {
+    TakeSnapshot();
+    NRF_LOG_INFO("Debug-runtimestats : window = %dms", runTimeStats.WindowMs());
+  }
+
+  int res = os_mbuf_append(context->om, snapshot, snapshotSize);
+  return (res == 0) ? 0 : BLE_ATT_ERR_INSUFFICIENT_RES;
+#else
+  // The firmware is not built with the run time statistics
+  return BLE_ATT_ERR_REQ_NOT_SUPPORTED;
+#endif
+}
+
+#if configGENERATE_RUN_TIME_STATS == 1
+void DebugService::TakeSnapshot() {
+  runTimeStats.Update();
+
+  uint8_t* position = Write32(snapshot, runTimeStats.WindowMs());
+  position = Write32(position, runTimeStats.ContextSwitches());
+  position = Write16(position, runTimeStats.IsrUsage());
+  position = Write16(position, runTimeStats.IdleUsage());
+  *position++ = runTimeStats.NbTasks();
+  for (uint8_t i = 0; i < runTimeStats.NbTasks(); i++) {
+    const auto& task = runTimeStats.Tasks()[i];
+    strncpy(reinterpret_cast<char*>(position), task.name, taskNameSize);
+    position = Write16(position + taskNameSize, task.usage);
+  }
+
+  snapshotSize = position - snapshot;
+  snapshotTime = xTaskGetTickCount();
+}
+#endif
+
+int DebugService::OnTraceDumpRequested() {
+#ifdef USE_TRACE
+  return DumpTrace() ? 0 : BLE_ATT_ERR_UNLIKELY;
+#else
+  // The firmware is not built with the tracer
+  return BLE_ATT_ERR_REQ_NOT_SUPPORTED;
+#endif
+}
+
+int DebugService::OnStorageStatsRequested(ble_gatt_access_ctxt* context) {
+  const auto& statistics = fs.GetCacheStatistics();
+  uint8_t buffer[4 * sizeof(uint32_t)];
+  Write32(Write32(Write32(Write32(buffer, statistics.hits), statistics.misses), statistics.flashReads), statistics.flashWrites);
+
+  int res = os_mbuf_append(context->om, buffer, sizeof(buffer));
+  return (res == 0) ? 0 : BLE_ATT_ERR_INSUFFICIENT_RES;
+}
+
+int DebugService::OnConnectionStatsRequested(ble_gatt_access_ctxt* context) {
+  auto statistics = connectionParameters.GetStatistics();
+  uint8_t buffer[ConnectionParameters::nbProfiles * sizeof(uint32_t) + 4 * sizeof(uint16_t)];
+  uint8_t* position = buffer;
+  for (uint8_t i = 0; i < ConnectionParameters::nbProfiles; i++) {
+    position = Write32(position, statistics.timeInProfile[i]);
+  }
+  position = Write16(position, statistics.nbRequests);
+  position = Write16(position, statistics.nbRejectedRequests);
+  position = Write16(position, statistics.interval);
+  Write16(position, statistics.latency);
+
+  int res = os_mbuf_append(context->om, buffer, sizeof(buffer));
+  return (res == 0) ? 0 : BLE_ATT_ERR_INSUFFICIENT_RES;
+}
+
+int DebugService::OnWakeUpStatsRequested(ble_gatt_access_ctxt* context) {
+  static constexpr uint8_t nbMessages = static_cast<uint8_t>(Pinetime::System::Messages::NbMessages);
+  uint8_t buffer[sizeof(uint32_t) + 1 + nbMessages * sizeof(uint32_t)];
+  uint8_t* position = Write32(buffer, xTaskGetTickCount() / configTICK_RATE_HZ);
+  *position++ = nbMessages;
+  for (uint8_t i = 0; i < nbMessages; i++) {
+    position = Write32(position, systemMonitor.WakeUpCount(static_cast<Pinetime::System::Messages>(i)));
+  }
+
+  int res = os_mbuf_append(context->om, buffer, sizeof(buffer));
+  return (res == 0) ? 0 : BLE_ATT_ERR_INSUFFICIENT_RES;
+}
+
+#ifdef USE_TRACE
+// The file starts with a header (magic "ITTR", version, record size, number of records, timestamp frequency),
+// followed by the records as they are in memory, oldest first.
+bool DebugService::DumpTrace() {
+  using Pinetime::Logging::Trace;
+  static constexpr uint8_t version = 1;
+  static constexpr uint8_t chunkSize = 16;
+
+  Trace::Pause();
+  uint16_t nbRecords = Trace::Size();
+  NRF_LOG_INFO("Debug-trace : dumping %d records", nbRecords);
+
+  lfs_file_t file;
+  bool ok = fs.FileOpen(&file, traceFileName, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) == 0;
+  if (ok) {
+    uint8_t header[12] = {'I', 'T', 'T', 'R', version, sizeof(Trace::Record)};
+    Write32(Write16(header + 6, nbRecords), Trace::timestampFrequency);
+    ok = fs.FileWrite(&file, header, sizeof(header)) == sizeof(header);
+
+    Trace::Record chunk[chunkSize];
+    for (uint16_t i = 0; ok && i < nbRecords; i += chunkSize) {
+      uint16_t count = std::min<uint16_t>(chunkSize, nbRecords - i);
+      for (uint16_t j = 0; j < count; j++) {
+        chunk[j] = Trace::At(i + j);
+      }
+      int size = count * sizeof(Trace::Record);
+      ok = fs.FileWrite(&file, reinterpret_cast<const uint8_t*>(chunk), size) == size;
+    }
+    ok = (fs.FileClose(&file) == 0) && ok;
+  }
+
+  Trace::Resume();
+  return ok;
+}
+#endif
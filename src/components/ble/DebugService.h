@@ -0,0 +1,69 @@
+#pragma once
+#define min // workaround: nimble's min/max macros conflict with libstdc++
+#define max
+#include <host/ble_gap.h>
+#undef max
+#undef min
+#include <FreeRTOS.h>
+#include "systemtask/RunTimeStats.h"
+
+namespace Pinetime {
+  namespace System {
+    class SystemMonitor;
+  }
+  namespace Controllers {
+    class ConnectionParameters;
+    class FS;
+
+    class DebugService {
+    public:
+      DebugService(Controllers::FS& fs,
+                   Controllers::ConnectionParameters& connectionParameters,
+                   const Pinetime::System::SystemMonitor& systemMonitor);
+      void Init();
+      int OnCommand(uint16_t connectionHandle, uint16_t attributeHandle, ble_gatt_access_ctxt* context);
+
+      // windowMs, contextSwitches, isr, idle, nbTasks, then name and usage of each task
+      static constexpr uint8_t headerSize = 4 + 4 + 2 + 2 + 1;
+      static constexpr uint8_t taskNameSize = 4;
+      static constexpr uint8_t taskSize = taskNameSize + 2;
+
+      // Written when the trace dump characteristic is written, see tools/trace_decode.py
+      static constexpr const char* traceFileName = "/trace.bin";
+
+    private:
+      Controllers::FS& fs;
+      Controllers::ConnectionParameters& connectionParameters;
+      const Pinetime::System::SystemMonitor& systemMonitor;
+
+      struct ble_gatt_chr_def characteristicDefinition[6];
+      struct ble_gatt_svc_def serviceDefinition[2];
+
+      uint16_t runTimeStatsHandle;
+      uint16_t traceDumpHandle;
+      uint16_t storageStatsHandle;
+      uint16_t connectionStatsHandle;
+      uint16_t wakeUpStatsHandle;
+#if configGENERATE_RUN_TIME_STATS == 1
+      // The statistics are computed over the time elapsed since the previous read
+      Pinetime::System::RunTimeStats runTimeStats;
+
+      // A long read calls the callback once per part, they must all see the same snapshot
+      static constexpr TickType_t snapshotLifetime = pdMS_TO_TICKS(1000);
+      uint8_t snapshot[headerSize + Pinetime::System::RunTimeStats::maxTaskCount * taskSize];
+      uint8_t snapshotSize = 0;
+      TickType_t snapshotTime = 0;
+
+      void TakeSnapshot();
+#endif
+      int OnRunTimeStatsRequested(ble_gatt_access_ctxt* context);
+      int OnTraceDumpRequested();
+      int OnStorageStatsRequested(ble_gatt_access_ctxt* context);
+      int OnConnectionStatsRequested(ble_gatt_access_ctxt* context);
+      int OnWakeUpStatsRequested(ble_gatt_access_ctxt* context);
+#ifdef USE_TRACE
+      bool DumpTrace();
+#endif
+    };
+  }
+}
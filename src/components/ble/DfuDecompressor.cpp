@@ -0,0 +1,168 @@
+#include "components/ble/DfuDecompressor.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace Pinetime::Controllers;
+
+constexpr uint8_t DfuDecompressor::magic[4];
+
+bool DfuDecompressor::IsCompressed(const uint8_t* data, size_t size) {
+  return size >= sizeof(magic) && std::memcmp(data, magic, sizeof(magic)) == 0;
+}
+
+void DfuDecompressor::Init(size_t maxSize) {
+  this->maxSize = maxSize;
+  state = States::Header;
+  headerIndex = 0;
+  nbFlags = 0;
+  matchIndex = 0;
+  shift = 0;
+  remaining = 0;
+  written = 0;
+  crc.Reset();
+}
+
+void DfuDecompressor::ParseHeader() {
+  decompressedSize = header[4] | (header[5] << 8) | (header[6] << 16) | (static_cast<uint32_t>(header[7]) << 24);
+  expectedCrc = header[8] | (header[9] << 8);
+  windowBits = header[10];
+
+  if (decompressedSize == 0 || decompressedSize > maxSize || windowBits < 8 || windowBits > maxWindowBits) {
+    state = States::Error;
+    return;
+  }
+  state = States::Flags;
+}
+
+void DfuDecompressor::EndOfMatch() {
+  if (distance > written || remaining > decompressedSize - written) {
+    state = States::Error;
+    return;
+  }
+  state = States::Copy;
+}
+
+size_t DfuDecompressor::Decompress(const uint8_t*& data, size_t& size, uint8_t* output, size_t outputSize) {
+  static constexpr size_t windowMask = (1 << maxWindowBits) - 1;
+  size_t produced = 0;
+  while (produced < outputSize) {
+    switch (state) {
+      case States::Header:
+        if (size == 0) {
+          return produced;
+        }
+        header[headerIndex++] = *data++;
+        size--;
+        if (headerIndex == headerSize) {
+          ParseHeader();
+        }
+        break;
+
+      case States::Flags:
+        if (size == 0) {
+          return produced;
+        }
+        flags = *data++;
+        size--;
+        nbFlags = 8;
+        state = States::Token;
+        break;
+
+      case States::Token:
+        if (nbFlags == 0) {
+          state = States::Flags;
+          break;
+        }
+        if ((flags & 1) != 0) {
+          flags >>= 1;
+          nbFlags--;
+          matchIndex = 0;
+          state = States::Match;
+          break;
+        }
+        if (size == 0) {
+          return produced;
+        }
+        flags >>= 1;
+        nbFlags--;
+        output[produced] = *data++;
+        size--;
+        window[written & windowMask] = output[produced];
+        crc.Update(output + produced, 1);
+        produced++;
+        written++;
+        if (written == decompressedSize) {
+          state = States::Done;
+        }
+        break;
+
+      case States::Match: {
+        if (size == 0) {
+          return produced;
+        }
+        matchBytes[matchIndex++] = *data++;
+        size--;
+        if (matchIndex < 2) {
+          break;
+        }
+        uint16_t token = matchBytes[0] | (matchBytes[1] << 8);
+        uint16_t lengthMask = (1 << (16 - windowBits)) - 1;
+        distance = (token & ((1 << windowBits) - 1)) + 1;
+        remaining = (token >> windowBits) + minMatch;
+        if ((token >> windowBits) == lengthMask) {
+          shift = 0;
+          state = States::MatchExtra;
+        } else {
+          EndOfMatch();
+        }
+        break;
+      }
+
+      case States::MatchExtra: {
+        if (size == 0) {
+          return produced;
+        }
+        uint8_t byte = *data++;
+        size--;
+        if (shift > 21) {
+          state = States::Error;
+          break;
+        }
+        remaining += static_cast<size_t>(byte & 0x7f) << shift;
+        shift += 7;
+        if ((byte & 0x80) == 0) {
+          EndOfMatch();
+        }
+        break;
+      }
+
+      case States::Copy: {
+        size_t n = std::min(remaining, outputSize - produced);
+        for (size_t i = 0; i < n; i++) {
+          uint8_t byte = window[(written - distance) & windowMask];
+          window[written & windowMask] = byte;
+          output[produced + i] = byte;
+          written++;
+        }
+        crc.Update(output + produced, n);
+        produced += n;
+        remaining -= n;
+        if (written == decompressedSize) {
+          state = States::Done;
+        } else if (remaining == 0) {
+          state = States::Token;
+        }
+        break;
+      }
+
+      case States::Done:
+      case States::Error:
+        return produced;
+    }
+  }
+  return produced;
+}
+
+bool DfuDecompressor::IsValid() const {
+  return state == States::Done && crc.Value() == expectedCrc;
+}
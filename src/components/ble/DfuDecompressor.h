@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "components/crc/Crc.h"
+
+namespace Pinetime {
+  namespace Controllers {
+    /* Decompresses a DFU stream compressed with tools/dfu_compress.py (LZSS). All the values are little-endian :
+     *  - Header : magic "ITDZ", decompressed size (uint32), CRC16 of the decompressed data (uint16),
+     *             window size in bits (uint8, 8 to maxWindowBits), reserved (uint8)
+     *  - Tokens, in groups of 8 preceded by a flag byte (LSB first) :
+     *     - flag 0 : literal byte
+     *     - flag 1 : match, uint16 (distance - 1) | ((length - minMatch) << windowBits). When the length field
+     *                is all ones, a varint follows and is added to the length.
+     * The decompressed data are an image or a patch (see DfuPatch).
+     *
+     * The data are decompressed as they are received. Only the window (2KB) is kept in RAM.
+     */
+    class DfuDecompressor {
+    public:
+      static bool IsCompressed(const uint8_t* data, size_t size);
+
+      void Init(size_t maxSize);
+
+      // Consumes the compressed data and writes the decompressed data in the output buffer.
+      // Returns the number of bytes written in the output buffer, it stops when the output is full,
+      // all the data are consumed or all the data have been decompressed.
+      size_t Decompress(const uint8_t*& data, size_t& size, uint8_t* output, size_t outputSize);
+
+      bool HasHeader() const {
+        return state != States::Header;
+      }
+      size_t Size() const {
+        return decompressedSize;
+      }
+      bool IsDone() const {
+        return state == States::Done;
+      }
+      bool HasFailed() const {
+        return state == States::Error;
+      }
+      bool IsValid() const;
+
+    private:
+      enum class States : uint8_t { Header, Flags, Token, Match, MatchExtra, Copy, Done, Error };
+      static constexpr uint8_t magic[4] = {'I', 'T', 'D', 'Z'};
+      static constexpr size_t headerSize = 12;
+      static constexpr uint8_t maxWindowBits = 11;
+      static constexpr size_t minMatch = 3;
+
+      States state = States::Error;
+      size_t maxSize = 0;
+      uint8_t header[headerSize];
+      uint8_t headerIndex = 0;
+      size_t decompressedSize = 0;
+      uint16_t expectedCrc = 0;
+      uint8_t windowBits = 0;
+      Pinetime::Tools::Crc16 crc;
+
+      uint8_t flags = 0;
+      uint8_t nbFlags = 0;
+      uint8_t matchBytes[2];
+      uint8_t matchIndex = 0;
+      uint8_t shift = 0;
+      size_t distance = 0;
+      size_t remaining = 0;
+      size_t written = 0;
+
+      uint8_t window[1 << maxWindowBits];
+
+      void ParseHeader();
+      void EndOfMatch();
+    };
+  }
+}
@@ -0,0 +1,149 @@
+#include "components/ble/DfuPatch.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace Pinetime::Controllers;
+
+constexpr uint8_t DfuPatch::magic[4];
+
+namespace {
+  uint32_t ReadUint32(const uint8_t* data) {
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+  }
+
+  uint16_t ReadUint16(const uint8_t* data) {
+    return data[0] | (data[1] << 8);
+  }
+}
+
+bool DfuPatch::IsPatch(const uint8_t* data, size_t size) {
+  // The decompressed data might be received 1 byte at a time : the whole magic number is checked with the header
+  return size > 0 && std::memcmp(data, magic, std::min(size, sizeof(magic))) == 0;
+}
+
+void DfuPatch::Init(const uint8_t* source, size_t maxSourceSize, size_t maxTargetSize) {
+  this->source = source;
+  this->maxSourceSize = maxSourceSize;
+  this->maxTargetSize = maxTargetSize;
+  state = States::Header;
+  headerIndex = 0;
+  value = 0;
+  shift = 0;
+  remaining = 0;
+  sourcePosition = 0;
+  written = 0;
+  targetCrc.Reset();
+}
+
+void DfuPatch::ParseHeader() {
+  sourceSize = ReadUint32(header + 4);
+  targetSize = ReadUint32(header + 8);
+  uint16_t sourceCrc = ReadUint16(header + 12);
+  expectedTargetCrc = ReadUint16(header + 14);
+
+  // The patch can only be applied on the image it was generated from
+  if (!IsPatch(header, headerSize) || sourceSize > maxSourceSize || targetSize == 0 || targetSize > maxTargetSize ||
+      Pinetime::Tools::Crc16::Compute(source, sourceSize) != sourceCrc) {
+    state = States::Error;
+    return;
+  }
+  state = States::Command;
+}
+
+void DfuPatch::Produce(const uint8_t* data, size_t size) {
+  targetCrc.Update(data, size);
+  written += size;
+  remaining -= size;
+  if (remaining == 0) {
+    state = (written == targetSize) ? States::Done : States::Command;
+  }
+}
+
+size_t DfuPatch::Apply(const uint8_t*& data, size_t& size, uint8_t* output, size_t outputSize) {
+  size_t produced = 0;
+  while (produced < outputSize) {
+    switch (state) {
+      case States::Header:
+        if (size == 0) {
+          return produced;
+        }
+        header[headerIndex++] = *data++;
+        size--;
+        if (headerIndex == headerSize) {
+          ParseHeader();
+        }
+        break;
+
+      case States::Command:
+      case States::Offset: {
+        if (size == 0) {
+          return produced;
+        }
+        uint8_t byte = *data++;
+        size--;
+        if (shift > 28) {
+          state = States::Error;
+          break;
+        }
+        value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+        shift += 7;
+        if ((byte & 0x80) != 0) {
+          break;
+        }
+
+        uint32_t varint = value;
+        value = 0;
+        shift = 0;
+        if (state == States::Command) {
+          remaining = varint >> 1;
+          if (remaining == 0 || remaining > targetSize - written) {
+            state = States::Error;
+          } else {
+            state = ((varint & 1) != 0) ? States::Offset : States::Insert;
+          }
+        } else {
+          int32_t delta = static_cast<int32_t>(varint >> 1) ^ -static_cast<int32_t>(varint & 1);
+          int64_t position = static_cast<int64_t>(sourcePosition) + delta;
+          if (position < 0 || position + remaining > sourceSize) {
+            state = States::Error;
+          } else {
+            sourcePosition = position;
+            state = States::Copy;
+          }
+        }
+        break;
+      }
+
+      case States::Insert: {
+        if (size == 0) {
+          return produced;
+        }
+        size_t n = std::min({remaining, size, outputSize - produced});
+        std::memcpy(output + produced, data, n);
+        data += n;
+        size -= n;
+        Produce(output + produced, n);
+        produced += n;
+        break;
+      }
+
+      case States::Copy: {
+        size_t n = std::min(remaining, outputSize - produced);
+        std::memcpy(output + produced, source + sourcePosition, n);
+        sourcePosition += n;
+        Produce(output + produced, n);
+        produced += n;
+        break;
+      }
+
+      case States::Done:
+      case States::Error:
+        return produced;
+    }
+  }
+  return produced;
+}
+
+bool DfuPatch::IsValid() const {
+  return state == States::Done && targetCrc.Value() == expectedTargetCrc;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "components/crc/Crc.h"
+
+namespace Pinetime {
+  namespace Controllers {
+    /* Rebuilds a firmware image from the running image and a patch (see tools/dfu_delta.py).
+     * All the values are little-endian :
+     *  - Header : magic "ITDP", source size (uint32), target size (uint32),
+     *             CRC16 of the source (uint16), CRC16 of the target (uint16)
+     *  - Commands : varint (length << 1 | type)
+     *     - type 0 (insert) : followed by 'length' bytes that are copied to the image
+     *     - type 1 (copy) : followed by a zigzag varint, the offset in the source relative to the end of the previous copy.
+     *                       'length' bytes are copied from the source to the image.
+     * The patch ends when 'target size' bytes have been written.
+     *
+     * The patch is applied as it is received : the parser keeps its state between the calls to Apply().
+     */
+    class DfuPatch {
+    public:
+      static bool IsPatch(const uint8_t* data, size_t size);
+
+      void Init(const uint8_t* source, size_t maxSourceSize, size_t maxTargetSize);
+
+      // Consumes the data of the patch and writes the bytes of the image in the output buffer.
+      // Returns the number of bytes written in the output buffer, it stops when the output is full,
+      // all the data are consumed or the image is complete.
+      size_t Apply(const uint8_t*& data, size_t& size, uint8_t* output, size_t outputSize);
+
+      bool HasHeader() const {
+        return state != States::Header;
+      }
+      size_t TargetSize() const {
+        return targetSize;
+      }
+      bool IsDone() const {
+        return state == States::Done;
+      }
+      bool HasFailed() const {
+        return state == States::Error;
+      }
+      bool IsValid() const;
+
+    private:
+      enum class States : uint8_t { Header, Command, Offset, Insert, Copy, Done, Error };
+      static constexpr uint8_t magic[4] = {'I', 'T', 'D', 'P'};
+      static constexpr size_t headerSize = 16;
+
+      States state = States::Error;
+      const uint8_t* source = nullptr;
+      size_t maxSourceSize = 0;
+      size_t maxTargetSize = 0;
+      uint8_t header[headerSize];
+      uint8_t headerIndex = 0;
+      size_t sourceSize = 0;
+      size_t targetSize = 0;
+      uint16_t expectedTargetCrc = 0;
+      Pinetime::Tools::Crc16 targetCrc;
+
+      uint32_t value = 0;
+      uint8_t shift = 0;
+      size_t remaining = 0;
+      size_t sourcePosition = 0;
+      size_t written = 0;
+
+      void ParseHeader();
+      void Produce(const uint8_t* data, size_t size);
+    };
+  }
+}
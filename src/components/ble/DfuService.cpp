@@ -1,4 +1,5 @@
 #include "components/ble/DfuService.h"
+#include <algorithm>
 #include <cstring>
 #include "components/ble/BleController.h"
 #include "drivers/SpiNorFlash.h"
@@ -127,7 +128,7 @@ int DfuService::WritePacketHandler(uint16_t connectionHandle, os_mbuf* om) {
         vTaskDelay(50); // 50ms
       }
 
-      dfuImage.Erase();
+      dfuImage.Erase(applicationSize);
 
       uint8_t data[] {16, 1, 1};
       notificationManager.Send(connectionHandle, controlPointCharacteristicHandle, data, 3);
@@ -158,12 +159,15 @@ int DfuService::WritePacketHandler(uint16_t connectionHandle, os_mbuf* om) {
     }
 
     case States::Data: {
+      // The size of the packets depends on the MTU : with a large MTU, they might be split in several mbufs
       nbPacketReceived++;
-      dfuImage.Append(om->om_data, om->om_len);
-      bytesReceived += om->om_len;
+      for (os_mbuf* buffer = om; buffer != nullptr; buffer = SLIST_NEXT(buffer, om_next)) {
+        dfuImage.Append(buffer->om_data, buffer->om_len);
+        bytesReceived += buffer->om_len;
+      }
       bleController.FirmwareUpdateCurrentBytes(bytesReceived);
 
-      if ((nbPacketReceived % nbPacketsToNotify) == 0 && bytesReceived != applicationSize) {
+      if (nbPacketsToNotify > 0 && (nbPacketReceived % nbPacketsToNotify) == 0 && bytesReceived != applicationSize) {
         uint8_t data[5] {static_cast<uint8_t>(Opcodes::PacketReceiptNotification),
                          (uint8_t)(bytesReceived & 0x000000FFu),
                          (uint8_t)(bytesReceived >> 8u),
@@ -172,6 +176,16 @@ int DfuService::WritePacketHandler(uint16_t connectionHandle, os_mbuf* om) {
         NRF_LOG_INFO("[DFU] -> Send packet notification: %d bytes received", bytesReceived);
         notificationManager.Send(connectionHandle, controlPointCharacteristicHandle, data, 5);
       }
+      if (dfuImage.HasFailed()) {
+        uint8_t data[3] {static_cast<uint8_t>(Opcodes::Response),
+                         static_cast<uint8_t>(Opcodes::ReceiveFirmwareImage),
+                         static_cast<uint8_t>(ErrorCodes::OperationFailed)};
+        NRF_LOG_INFO("[DFU] -> The image could not be decompressed or patched");
+        notificationManager.Send(connectionHandle, controlPointCharacteristicHandle, data, 3);
+        bleController.State(Pinetime::Controllers::Ble::FirmwareUpdateStates::Error);
+        Reset();
+        return 0;
+      }
       if (dfuImage.IsComplete()) {
         uint8_t data[3] {static_cast<uint8_t>(Opcodes::Response),
                          static_cast<uint8_t>(Opcodes::ReceiveFirmwareImage),
@@ -244,8 +258,7 @@ int DfuService::ControlPointHandler(uint16_t connectionHandle, os_mbuf* om) {
         NRF_LOG_INFO("[DFU] -> Receive firmware image requested, but we are not in Start Init");
         return 0;
       }
-      // TODO the chunk size is dependant of the implementation of the host application...
-      dfuImage.Init(20, applicationSize, expectedCrc);
+      dfuImage.Init(applicationSize, expectedCrc);
       NRF_LOG_INFO("[DFU] -> Starting receive firmware");
       state = States::Data;
       return 0;
@@ -348,37 +361,126 @@ void DfuService::NotificationManager::Reset() {
   xTimerStop(timer, 0);
 }
 
-void DfuService::DfuImage::Init(size_t chunkSize, size_t totalSize, uint16_t expectedCrc) {
-  if (chunkSize != 20)
-    return;
-  this->chunkSize = chunkSize;
+void DfuService::DfuImage::Init(size_t totalSize, uint16_t expectedCrc) {
   this->totalSize = totalSize;
   this->expectedCrc = expectedCrc;
+  this->receivedSize = 0;
+  this->decompressedSize = 0;
+  this->imageSize = 0;
+  this->isPatch = false;
+  this->isCompressed = false;
+  this->bufferWriteIndex = 0;
+  this->totalWriteIndex = 0;
+  this->crc.Reset();
   this->ready = true;
 }
 
-void DfuService::DfuImage::Append(uint8_t* data, size_t size) {
-  if (!ready)
+void DfuService::DfuImage::Append(const uint8_t* data, size_t size) {
+  if (!ready || receivedSize == totalSize)
+    return;
+
+  // The CRC of the DFU protocol is computed on the data as they are transferred
+  size = std::min(size, totalSize - receivedSize);
+  crc.Update(data, size);
+  if (receivedSize == 0 && DfuDecompressor::IsCompressed(data, size)) {
+    NRF_LOG_INFO("[DFU] Compressed update");
+    isCompressed = true;
+    decompressor.Init(maxSize);
+  }
+  receivedSize += size;
+
+  if (!isCompressed) {
+    AppendData(data, size);
     return;
-  ASSERT(size <= 20);
+  }
 
-  std::memcpy(tempBuffer + bufferWriteIndex, data, size);
-  bufferWriteIndex += size;
+  uint8_t decompressed[64];
+  size_t produced;
+  do {
+    produced = decompressor.Decompress(data, size, decompressed, sizeof(decompressed));
+    AppendData(decompressed, produced);
+  } while (produced > 0 || (size > 0 && !decompressor.IsDone() && !decompressor.HasFailed()));
+}
+
+void DfuService::DfuImage::AppendData(const uint8_t* data, size_t size) {
+  if (size == 0)
+    return;
 
-  if (bufferWriteIndex == bufferSize) {
-    spiNorFlash.Write(writeOffset + totalWriteIndex, tempBuffer, bufferWriteIndex);
-    totalWriteIndex += bufferWriteIndex;
-    bufferWriteIndex = 0;
+  if (decompressedSize == 0) {
+    if (DfuPatch::IsPatch(data, size)) {
+      NRF_LOG_INFO("[DFU] Delta update");
+      isPatch = true;
+      patch.Init(reinterpret_cast<const uint8_t*>(sourceOffset), maxSize, maxSize - trailerSize);
+    } else {
+      SetImageSize(isCompressed ? decompressor.Size() : totalSize);
+    }
   }
+  decompressedSize += size;
 
-  if (bufferWriteIndex > 0 && totalWriteIndex + bufferWriteIndex == totalSize) {
-    spiNorFlash.Write(writeOffset + totalWriteIndex, tempBuffer, bufferWriteIndex);
-    totalWriteIndex += bufferWriteIndex;
-    if (totalSize < maxSize)
-      WriteMagicNumber();
+  if (isPatch) {
+    ApplyPatch(data, size);
+  } else {
+    AppendImage(data, size);
   }
 }
 
+void DfuService::DfuImage::SetImageSize(size_t size) {
+  imageSize = size;
+  eraseSize = std::min(((imageSize + sectorSize - 1) / sectorSize) * sectorSize, maxSize - trailerSize);
+}
+
+void DfuService::DfuImage::AppendImage(const uint8_t* data, size_t size) {
+  while (size > 0) {
+    size_t copySize = std::min(size, bufferSize - bufferWriteIndex);
+    std::memcpy(tempBuffer + bufferWriteIndex, data, copySize);
+    bufferWriteIndex += copySize;
+    data += copySize;
+    size -= copySize;
+
+    if (bufferWriteIndex == bufferSize) {
+      WriteBuffer();
+    }
+  }
+
+  if (totalWriteIndex + bufferWriteIndex == imageSize) {
+    FinishImage();
+  }
+}
+
+void DfuService::DfuImage::ApplyPatch(const uint8_t* data, size_t size) {
+  // A copy from the running image does not consume any data : continue until the patch needs more data
+  size_t produced;
+  do {
+    produced = patch.Apply(data, size, tempBuffer + bufferWriteIndex, bufferSize - bufferWriteIndex);
+    if (imageSize == 0 && patch.HasHeader() && !patch.HasFailed()) {
+      SetImageSize(patch.TargetSize());
+    }
+    bufferWriteIndex += produced;
+    if (bufferWriteIndex == bufferSize) {
+      WriteBuffer();
+    }
+  } while (produced > 0 || (size > 0 && !patch.IsDone() && !patch.HasFailed()));
+
+  if (patch.IsDone() && totalWriteIndex != imageSize) {
+    FinishImage();
+  }
+}
+
+void DfuService::DfuImage::WriteBuffer() {
+  EraseUntil(totalWriteIndex + bufferWriteIndex);
+  spiNorFlash.Write(writeOffset + totalWriteIndex, tempBuffer, bufferWriteIndex);
+  totalWriteIndex += bufferWriteIndex;
+  bufferWriteIndex = 0;
+  EraseAhead();
+}
+
+void DfuService::DfuImage::FinishImage() {
+  if (bufferWriteIndex > 0)
+    WriteBuffer();
+  if (imageSize < maxSize)
+    WriteMagicNumber();
+}
+
 void DfuService::DfuImage::WriteMagicNumber() {
   uint32_t magic[4] = {
     // TODO When this variable is a static constexpr, the values written to the memory are not correct. Why?
@@ -392,49 +494,48 @@ void DfuService::DfuImage::WriteMagicNumber() {
   spiNorFlash.Write(offset, reinterpret_cast<const uint8_t*>(magic), 4 * sizeof(uint32_t));
 }
 
-void DfuService::DfuImage::Erase() {
-  for (size_t erased = 0; erased < maxSize; erased += 0x1000) {
-    spiNorFlash.SectorErase(writeOffset + erased);
+void DfuService::DfuImage::Erase(size_t imageSize) {
+  // Only the part of the slot that will receive the image is erased, and only its first sector is erased
+  // now : the next sectors and blocks are erased while the data are being received (see EraseAhead()).
+  eraseSize = std::min(((imageSize + sectorSize - 1) / sectorSize) * sectorSize, maxSize - trailerSize);
+  spiNorFlash.Erase(writeOffset + (maxSize - trailerSize), trailerSize);
+  erasedSize = 0;
+  if (eraseSize > 0) {
+    spiNorFlash.SectorErase(writeOffset);
+    erasedSize = sectorSize;
   }
+  EraseAhead();
 }
 
-bool DfuService::DfuImage::Validate() {
-  uint32_t chunkSize = 200;
-  size_t currentOffset = 0;
-  uint16_t crc = 0;
-
-  bool first = true;
-  while (currentOffset < totalSize) {
-    uint32_t readSize = (totalSize - currentOffset) > chunkSize ? chunkSize : (totalSize - currentOffset);
-
-    spiNorFlash.Read(writeOffset + currentOffset, tempBuffer, readSize);
-    if (first) {
-      crc = ComputeCrc(tempBuffer, readSize, NULL);
-      first = false;
-    } else
-      crc = ComputeCrc(tempBuffer, readSize, &crc);
-    currentOffset += readSize;
+void DfuService::DfuImage::EraseUntil(size_t offset) {
+  while (erasedSize < offset && erasedSize < eraseSize) {
+    erasedSize += spiNorFlash.StartErase(writeOffset + erasedSize, eraseSize - erasedSize);
   }
-
-  return (crc == expectedCrc);
 }
 
-uint16_t DfuService::DfuImage::ComputeCrc(uint8_t const* p_data, uint32_t size, uint16_t const* p_crc) {
-  uint16_t crc = (p_crc == NULL) ? 0xFFFF : *p_crc;
-
-  for (uint32_t i = 0; i < size; i++) {
-    crc = (uint8_t)(crc >> 8) | (crc << 8);
-    crc ^= p_data[i];
-    crc ^= (uint8_t)(crc & 0xFF) >> 4;
-    crc ^= (crc << 8) << 4;
-    crc ^= ((crc & 0xFF) << 4) << 1;
+void DfuService::DfuImage::EraseAhead() {
+  // The pages are programmed while the memory is erasing the next block (see SpiNorFlash::Write()) :
+  // the erase front stays ahead of the data as long as a new erase is started as soon as the previous one is done.
+  if (erasedSize < eraseSize && !spiNorFlash.IsErasing()) {
+    erasedSize += spiNorFlash.StartErase(writeOffset + erasedSize, eraseSize - erasedSize);
   }
+}
 
-  return crc;
+bool DfuService::DfuImage::Validate() {
+  return IsComplete() && crc.Value() == expectedCrc && (!isCompressed || decompressor.IsValid()) && (!isPatch || patch.IsValid());
 }
 
 bool DfuService::DfuImage::IsComplete() {
+  if (!ready || receivedSize != totalSize)
+    return false;
+  return imageSize > 0 && totalWriteIndex == imageSize;
+}
+
+bool DfuService::DfuImage::HasFailed() const {
   if (!ready)
     return false;
-  return totalWriteIndex == totalSize;
+  bool allDataReceived = (receivedSize == totalSize);
+  if (isCompressed && (decompressor.HasFailed() || (allDataReceived && !decompressor.IsDone())))
+    return true;
+  return isPatch && (patch.HasFailed() || (allDataReceived && !patch.IsDone()));
 }
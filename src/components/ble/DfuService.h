@@ -2,6 +2,9 @@
 
 #include <cstdint>
 #include <array>
+#include "components/crc/Crc.h"
+#include "components/ble/DfuPatch.h"
+#include "components/ble/DfuDecompressor.h"
 
 #define min // workaround: nimble's min/max macros conflict with libstdc++
 #define max
@@ -50,27 +53,56 @@ namespace Pinetime {
       public:
         DfuImage(Pinetime::Drivers::SpiNorFlash& spiNorFlash) : spiNorFlash {spiNorFlash} {
         }
-        void Init(size_t chunkSize, size_t totalSize, uint16_t expectedCrc);
-        void Erase();
-        void Append(uint8_t* data, size_t size);
+        void Init(size_t totalSize, uint16_t expectedCrc);
+        void Erase(size_t imageSize);
+        void Append(const uint8_t* data, size_t size);
         bool Validate();
         bool IsComplete();
+        // The received patch cannot be applied to the running image
+        bool HasFailed() const;
 
       private:
         Pinetime::Drivers::SpiNorFlash& spiNorFlash;
-        static constexpr size_t bufferSize = 200;
+        // The data are written one page of the memory at a time, whatever the size of the packets
+        static constexpr size_t bufferSize = 256;
         bool ready = false;
-        size_t chunkSize = 0;
+        // Size of the received data (the image or the patch, compressed or not)
         size_t totalSize = 0;
+        size_t receivedSize = 0;
+        // Size of the data once decompressed
+        size_t decompressedSize = 0;
+        // Size of the image written in the OTA slot, only known once the header of a patch
+        // or of a compressed stream has been received
+        size_t imageSize = 0;
         size_t maxSize = 475136;
         size_t bufferWriteIndex = 0;
         size_t totalWriteIndex = 0;
         static constexpr size_t writeOffset = 0x40000;
+        // The running image (MCUBoot primary slot), in the internal flash
+        static constexpr size_t sourceOffset = 0x8000;
+        bool isPatch = false;
+        DfuPatch patch;
+        bool isCompressed = false;
+        DfuDecompressor decompressor;
+        static constexpr size_t sectorSize = 0x1000;
+        // The end of the slot contains the MCUBoot trailer (magic number, swap status) and must be erased
+        static constexpr size_t trailerSize = 2 * sectorSize;
         uint8_t tempBuffer[bufferSize];
         uint16_t expectedCrc = 0;
-
+        // Computed while the data are received, Validate() does not need to read the image back
+        Pinetime::Tools::Crc16 crc;
+        size_t eraseSize = 0;
+        size_t erasedSize = 0;
+
+        void AppendData(const uint8_t* data, size_t size);
+        void AppendImage(const uint8_t* data, size_t size);
+        void SetImageSize(size_t size);
+        void ApplyPatch(const uint8_t* data, size_t size);
+        void WriteBuffer();
+        void FinishImage();
         void WriteMagicNumber();
-        uint16_t ComputeCrc(uint8_t const* p_data, uint32_t size, uint16_t const* p_crc);
+        void EraseUntil(size_t offset);
+        void EraseAhead();
       };
 
     private:
@@ -1,9 +1,12 @@
+#include <algorithm>
 #include <nrf_log.h>
 #include "FSService.h"
 #include "components/ble/BleController.h"
 #include "systemtask/SystemTask.h"
+#include "utility/LockGuard.h"
 
 using namespace Pinetime::Controllers;
+using Pinetime::Utility::LockGuard;
 
 constexpr ble_uuid16_t FSService::fsServiceUuid;
 constexpr ble_uuid128_t FSService::fsVersionUuid;
@@ -14,6 +17,11 @@ int FSServiceCallback(uint16_t conn_handle, uint16_t attr_handle, struct ble_gat
   return fsService->OnFSServiceRequested(conn_handle, attr_handle, ctxt);
 }
 
+void SessionTimerCallback(TimerHandle_t xTimer) {
+  auto* fsService = static_cast<FSService*>(pvTimerGetTimerID(xTimer));
+  fsService->OnSessionTimeout();
+}
+
 FSService::FSService(Pinetime::System::SystemTask& systemTask, Pinetime::Controllers::FS& fs)
   : systemTask {systemTask},
     fs {fs},
@@ -26,7 +34,8 @@ FSService::FSService(Pinetime::System::SystemTask& systemTask, Pinetime::Control
                                 .uuid = &fsTransferUuid.u,
                                 .access_cb = FSServiceCallback,
                                 .arg = this,
-                                .flags = BLE_GATT_CHR_F_WRITE | BLE_GATT_CHR_F_READ | BLE_GATT_CHR_F_NOTIFY,
+                                .flags = BLE_GATT_CHR_F_WRITE | BLE_GATT_CHR_F_WRITE_NO_RSP | BLE_GATT_CHR_F_READ |
+                                         BLE_GATT_CHR_F_NOTIFY,
                                 .val_handle = &transferCharacteristicHandle,
                               },
                               {0}},
@@ -40,6 +49,11 @@ FSService::FSService(Pinetime::System::SystemTask& systemTask, Pinetime::Control
 }
 
 void FSService::Init() {
+  mutex = xSemaphoreCreateMutex();
+  ASSERT(mutex != nullptr);
+  sessionTimer = xTimerCreate("fsSession", pdMS_TO_TICKS(sessionTimeout), pdFALSE, this, SessionTimerCallback);
+  ASSERT(sessionTimer != nullptr);
+
   int res = 0;
   res = ble_gatts_count_cfg(serviceDefinition);
   ASSERT(res == 0);
@@ -55,7 +69,16 @@ int FSService::OnFSServiceRequested(uint16_t connectionHandle, uint16_t attribut
     return (res == 0) ? 0 : BLE_ATT_ERR_INSUFFICIENT_RES;
   }
   if (attributeHandle == transferCharacteristicHandle) {
-    return FSCommandHandler(connectionHandle, context->om);
+    LockGuard lock {mutex};
+    int res = FSCommandHandler(connectionHandle, context->om);
+    if (session.state == FSState::IDLE) {
+      NRF_LOG_INFO("[FS_S] -> done ");
+      xTimerStop(sessionTimer, 0);
+      systemTask.PushMessage(Pinetime::System::Messages::StopFileTransfer);
+    } else {
+      xTimerReset(sessionTimer, 0);
+    }
+    return res;
   }
   return 0;
 }
@@ -63,128 +86,97 @@ int FSService::OnFSServiceRequested(uint16_t connectionHandle, uint16_t attribut
 int FSService::FSCommandHandler(uint16_t connectionHandle, os_mbuf* om) {
   auto command = static_cast<commands>(om->om_data[0]);
   NRF_LOG_INFO("[FS_S] -> FSCommandHandler Command %d", command);
-  // Just always make sure we are awake...
-  systemTask.PushMessage(Pinetime::System::Messages::StartFileTransfer);
-  vTaskDelay(10);
-  while (systemTask.IsSleeping()) {
-    vTaskDelay(100); // 50ms
+  bool continuesSession = (command == commands::READ_PACING && session.state == FSState::READ) ||
+                          (command == commands::WRITE_DATA && session.state == FSState::WRITE);
+  if (!continuesSession) {
+    CloseSession();
+    // Just always make sure we are awake...
+    systemTask.PushMessage(Pinetime::System::Messages::StartFileTransfer);
+    vTaskDelay(10);
+    while (systemTask.IsSleeping()) {
+      vTaskDelay(100); // 50ms
+    }
   }
   lfs_dir_t dir = {0};
   lfs_info info = {0};
-  lfs_file f = {0};
   switch (command) {
     case commands::READ: {
       NRF_LOG_INFO("[FS_S] -> Read");
       auto* header = (ReadHeader*) om->om_data;
       uint16_t plen = header->pathlen;
-      if (plen > maxpathlen) { //> counts for null term
+      if (plen >= maxpathlen) { //> counts for null term
         return -1;
       }
       memcpy(filepath, header->pathstr, plen);
       filepath[plen] = 0; // Copy and null teminate string
-      ReadResponse resp;
-      os_mbuf* om;
-      resp.command = commands::READ_DATA;
-      resp.status = 0x01;
-      resp.chunkoff = header->chunkoff;
-      int res = fs.Stat(filepath, &info);
-      if (res == LFS_ERR_NOENT && info.type != LFS_TYPE_DIR) {
-        resp.status = (int8_t) res;
-        resp.chunklen = 0;
-        resp.totallen = 0;
-        om = ble_hs_mbuf_from_flat(&resp, sizeof(ReadResponse));
-      } else {
-        resp.chunklen = std::min(header->chunksize, info.size); // TODO add mtu somehow
-        resp.totallen = info.size;
-        fs.FileOpen(&f, filepath, LFS_O_RDONLY);
-        fs.FileSeek(&f, header->chunkoff);
-        uint8_t fileData[resp.chunklen] = {0};
-        resp.chunklen = fs.FileRead(&f, fileData, resp.chunklen);
-        om = ble_hs_mbuf_from_flat(&resp, sizeof(ReadResponse));
-        os_mbuf_append(om, fileData, resp.chunklen);
-        fs.FileClose(&f);
-      }
-
-      ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+      int res = OpenSession(FSState::READ, LFS_O_RDONLY);
+      SendReadData(connectionHandle, header->chunkoff, header->chunksize, res);
       break;
     }
     case commands::READ_PACING: {
-      NRF_LOG_INFO("[FS_S] -> Readpacing");
       auto* header = (ReadHeader*) om->om_data;
-      ReadResponse resp;
-      resp.command = commands::READ_DATA;
-      resp.status = 0x01;
-      resp.chunkoff = header->chunkoff;
-      int res = fs.Stat(filepath, &info);
-      if (res == LFS_ERR_NOENT && info.type != LFS_TYPE_DIR) {
-        resp.status = (int8_t) res;
-        resp.chunklen = 0;
-        resp.totallen = 0;
-      } else {
-        resp.chunklen = std::min(header->chunksize, info.size); // TODO add mtu somehow
-        resp.totallen = info.size;
-        fs.FileOpen(&f, filepath, LFS_O_RDONLY);
-        fs.FileSeek(&f, header->chunkoff);
-      }
-      os_mbuf* om;
-      if (resp.chunklen > 0) {
-        uint8_t fileData[resp.chunklen] = {0};
-        resp.chunklen = fs.FileRead(&f, fileData, resp.chunklen);
-        om = ble_hs_mbuf_from_flat(&resp, sizeof(ReadResponse));
-        os_mbuf_append(om, fileData, resp.chunklen);
-      } else {
-        resp.chunklen = 0;
-        om = ble_hs_mbuf_from_flat(&resp, sizeof(ReadResponse));
+      int res = 0;
+      if (session.state != FSState::READ) {
+        // The previous read has been completed, read the same file again
+        res = OpenSession(FSState::READ, LFS_O_RDONLY);
       }
-      fs.FileClose(&f);
-      ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+      SendReadData(connectionHandle, header->chunkoff, header->chunksize, res);
       break;
     }
     case commands::WRITE: {
       NRF_LOG_INFO("[FS_S] -> Write");
       auto* header = (WriteHeader*) om->om_data;
       uint16_t plen = header->pathlen;
-      if (plen > maxpathlen) { //> counts for null term
-        return -1;             // TODO make this actually return a BLE notif
+      if (plen >= maxpathlen) { //> counts for null term
+        return -1;              // TODO make this actually return a BLE notif
       }
       memcpy(filepath, header->pathstr, plen);
       filepath[plen] = 0; // Copy and null teminate string
       fileSize = header->totalSize;
-      WriteResponse resp;
-      resp.command = commands::WRITE_PACING;
-      resp.offset = header->offset;
-      resp.modTime = 0;
-
-      int res = fs.FileOpen(&f, filepath, LFS_O_RDWR | LFS_O_CREAT);
-      if (res == 0) {
-        fs.FileClose(&f);
-        resp.status = (res == 0) ? 0x01 : (int8_t) res;
+      int res = OpenSession(FSState::WRITE, LFS_O_RDWR | LFS_O_CREAT);
+      session.window = header->window;
+      SendWritePacing(connectionHandle, header->offset, res);
+      if (fileSize == 0) {
+        CloseSession();
       }
-      resp.freespace = std::min(fs.getSize() - (fs.GetFSSize() * fs.getBlockSize()), fileSize - header->offset);
-      auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(WriteResponse));
-      ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
       break;
     }
     case commands::WRITE_DATA: {
-      NRF_LOG_INFO("[FS_S] -> WriteData");
       auto* header = (WritePacing*) om->om_data;
-      WriteResponse resp;
-      resp.command = commands::WRITE_PACING;
-      resp.offset = header->offset;
+      const uint8_t* data = header->data;
       int res = 0;
-
-      if (!(res = fs.FileOpen(&f, filepath, LFS_O_RDWR | LFS_O_CREAT))) {
-        if ((res = fs.FileSeek(&f, header->offset)) >= 0) {
-          res = fs.FileWrite(&f, header->data, header->dataSize);
+      if (session.state != FSState::WRITE) {
+        res = OpenSession(FSState::WRITE, LFS_O_RDWR | LFS_O_CREAT);
+      }
+      if (sizeof(WritePacing) + header->dataSize > OS_MBUF_PKTLEN(om)) {
+        res = LFS_ERR_INVAL;
+      } else if (SLIST_NEXT(om, om_next) != nullptr) {
+        // The data is split across several mbufs
+        if (header->dataSize > maxChunkSize || os_mbuf_copydata(om, sizeof(WritePacing), header->dataSize, chunkBuffer) != 0) {
+          res = LFS_ERR_INVAL;
         }
-        fs.FileClose(&f);
+        data = chunkBuffer;
       }
-      if (res < 0) {
-        resp.status = (int8_t) res;
+      if (res == 0 && header->offset != session.offset) {
+        res = fs.FileSeek(&session.file, header->offset);
+      }
+      if (res >= 0) {
+        res = fs.FileWrite(&session.file, data, header->dataSize);
+      }
+      if (res >= 0) {
+        session.offset = header->offset + header->dataSize;
+        res = 0;
+      }
+
+      session.unacknowledged++;
+      bool done = (res < 0) || (session.offset >= static_cast<uint32_t>(fileSize));
+      if (done) {
+        int closeRes = CloseSession();
+        res = (res < 0) ? res : closeRes;
+      }
+      if (done || session.unacknowledged >= session.window) {
+        SendWritePacing(connectionHandle, header->offset, res);
       }
-      resp.freespace = std::min(fs.getSize() - (fs.GetFSSize() * fs.getBlockSize()), fileSize - header->offset);
-      auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(WriteResponse));
-      ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
       break;
     }
     case commands::DELETE: {
@@ -297,34 +289,175 @@ int FSService::FSCommandHandler(uint16_t connectionHandle, os_mbuf* om) {
       resp.status = (res == 0) ? 1 : res;
       auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(MoveResponse));
       ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+      break;
+    }
+    case commands::CHECKSUM: {
+      NRF_LOG_INFO("[FS_S] -> Checksum");
+      auto* header = (ChecksumHeader*) om->om_data;
+      uint16_t plen = header->pathlen;
+      if (plen > maxpathlen) {
+        return -1;
+      }
+      char path[plen + 1] = {0};
+      memcpy(path, header->pathstr, plen);
+      path[plen] = 0; // Copy and null teminate string
+      ChecksumResponse resp {};
+      resp.command = commands::CHECKSUM_STATUS;
+      uint32_t size = 0;
+      uint32_t crc = 0;
+      int res = ComputeChecksum(path, size, crc);
+      resp.size = size;
+      resp.crc = crc;
+      resp.status = (res == 0) ? 0x01 : (int8_t) res;
+      auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(ChecksumResponse));
+      ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+      break;
     }
     default:
       break;
   }
-  NRF_LOG_INFO("[FS_S] -> done ");
-  systemTask.PushMessage(Pinetime::System::Messages::StopFileTransfer);
   return 0;
 }
 
-// Loads resp with file data given a valid filepath header and resp
-void FSService::prepareReadDataResp(ReadHeader* header, ReadResponse* resp) {
-  // uint16_t plen = header->pathlen;
-  resp->command = commands::READ_DATA;
-  resp->chunkoff = header->chunkoff;
-  resp->status = 0x01;
-  struct lfs_info info = {};
-  int res = fs.Stat(filepath, &info);
-  if (res == LFS_ERR_NOENT && info.type != LFS_TYPE_DIR) {
-    resp->status = 0x03;
-    resp->chunklen = 0;
-    resp->totallen = 0;
-  } else {
-    lfs_file f;
-    resp->chunklen = std::min(header->chunksize, info.size);
-    resp->totallen = info.size;
-    fs.FileOpen(&f, filepath, LFS_O_RDONLY);
-    fs.FileSeek(&f, header->chunkoff);
-    resp->chunklen = fs.FileRead(&f, resp->chunk, resp->chunklen);
-    fs.FileClose(&f);
+void FSService::Reset() {
+  LockGuard lock {mutex};
+  xTimerStop(sessionTimer, 0);
+  if (session.state != FSState::IDLE) {
+    CloseSession();
+    systemTask.PushMessage(Pinetime::System::Messages::StopFileTransfer);
+  }
+}
+
+void FSService::OnSessionTimeout() {
+  // A command is being handled : it restarts or stops the timer when it's done
+  if (xSemaphoreTake(mutex, 0) != pdTRUE) {
+    return;
+  }
+  if (session.state != FSState::IDLE) {
+    NRF_LOG_INFO("[FS_S] -> session timeout");
+    CloseSession();
+    systemTask.PushMessage(Pinetime::System::Messages::StopFileTransfer);
+  }
+  xSemaphoreGive(mutex);
+}
+
+int FSService::OpenSession(FSState state, int flags) {
+  CloseSession();
+  int res = fs.FileOpen(&session.file, filepath, flags);
+  if (res < 0) {
+    return res;
+  }
+  res = fs.FileSize(&session.file);
+  if (res < 0) {
+    fs.FileClose(&session.file);
+    return res;
+  }
+  session.state = state;
+  session.size = res;
+  session.offset = 0;
+  session.window = 0;
+  session.unacknowledged = 0;
+  return 0;
+}
+
+int FSService::CloseSession() {
+  if (session.state == FSState::IDLE) {
+    return 0;
+  }
+  session.state = FSState::IDLE;
+  return fs.FileClose(&session.file);
+}
+
+uint16_t FSService::ChunkSize(uint16_t connectionHandle) const {
+  uint16_t mtu = ble_att_mtu(connectionHandle);
+  if (mtu < 3 + sizeof(ReadResponse) + 1) {
+    return 1;
+  }
+  return std::min<uint16_t>(mtu - 3 - sizeof(ReadResponse), maxChunkSize);
+}
+
+// Sends the requested length of data in as many READ_DATA notifications as needed given the MTU.
+// The client acknowledges all of them with the next READ_PACING.
+void FSService::SendReadData(uint16_t connectionHandle, uint32_t offset, uint32_t length, int status) {
+  ReadResponse resp {};
+  resp.command = commands::READ_DATA;
+  resp.chunkoff = offset;
+  if (status == 0) {
+    resp.totallen = session.size;
+    length = (offset < session.size) ? std::min(length, session.size - offset) : 0;
+    if (offset != session.offset) {
+      int res = fs.FileSeek(&session.file, offset);
+      status = (res < 0) ? res : 0;
+    }
+  }
+  if (status != 0) {
+    length = 0;
+  }
+
+  uint16_t chunkSize = ChunkSize(connectionHandle);
+  do {
+    resp.chunklen = 0;
+    if (length > 0) {
+      int res = fs.FileRead(&session.file, chunkBuffer, std::min<uint32_t>(length, chunkSize));
+      if (res < 0) {
+        status = res;
+      } else {
+        resp.chunklen = res;
+      }
+    }
+    resp.status = (status == 0) ? 0x01 : (int8_t) status;
+
+    os_mbuf* om;
+    // Wait for the previous notifications to be sent if the mbuf pool is empty
+    for (uint8_t retries = 0; (om = ble_hs_mbuf_from_flat(&resp, sizeof(ReadResponse))) == nullptr && retries < 50; retries++) {
+      vTaskDelay(2);
+    }
+    if (om == nullptr) {
+      break;
+    }
+    if (os_mbuf_append(om, chunkBuffer, resp.chunklen) != 0) {
+      os_mbuf_free_chain(om);
+      break;
+    }
+    ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+
+    resp.chunkoff += resp.chunklen;
+    length -= resp.chunklen;
+    session.offset = resp.chunkoff;
+  } while (length > 0 && resp.chunklen > 0);
+
+  if (status != 0 || session.offset >= session.size) {
+    CloseSession();
+  }
+}
+
+void FSService::SendWritePacing(uint16_t connectionHandle, uint32_t offset, int status) {
+  WriteResponse resp {};
+  resp.command = commands::WRITE_PACING;
+  resp.status = (status == 0) ? 0x01 : (int8_t) status;
+  resp.offset = offset;
+  resp.modTime = 0;
+  resp.freespace = std::min<uint32_t>(fs.getSize() - (fs.GetFSSize() * fs.getBlockSize()), fileSize - offset);
+  auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(WriteResponse));
+  ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+  session.unacknowledged = 0;
+}
+
+int FSService::ComputeChecksum(const char* path, uint32_t& size, uint32_t& crc) {
+  lfs_file f;
+  int res = fs.FileOpen(&f, path, LFS_O_RDONLY);
+  if (res < 0) {
+    return res;
+  }
+
+  Pinetime::Tools::Crc32 crc32;
+  uint8_t buffer[64];
+  size = 0;
+  while ((res = fs.FileRead(&f, buffer, sizeof(buffer))) > 0) {
+    crc32.Update(buffer, res);
+    size += res;
   }
+  fs.FileClose(&f);
+  crc = crc32.Value();
+  return (res < 0) ? res : 0;
 }
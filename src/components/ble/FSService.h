@@ -2,10 +2,15 @@
 #define min // workaround: nimble's min/max macros conflict with libstdc++
 #define max
 #include <host/ble_gap.h>
+#include <host/ble_att.h>
 #undef max
 #undef min
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include <timers.h>
 
 #include "components/fs/FS.h"
+#include "components/crc/Crc.h"
 
 namespace Pinetime {
   namespace System {
@@ -20,6 +25,10 @@ namespace Pinetime {
 
       int OnFSServiceRequested(uint16_t connectionHandle, uint16_t attributeHandle, ble_gatt_access_ctxt* context);
       void NotifyFSRaw(uint16_t connectionHandle);
+      // Closes the transfer in progress, if any (on disconnection)
+      void Reset();
+      // Called by the timer task when no command has been received for sessionTimeout during a transfer
+      void OnSessionTimeout();
 
     private:
       Pinetime::System::SystemTask& systemTask;
@@ -27,8 +36,9 @@ namespace Pinetime {
       static constexpr uint16_t FSServiceId {0xFEBB};
       static constexpr uint16_t fsVersionId {0x0100};
       static constexpr uint16_t fsTransferId {0x0200};
-      uint16_t fsVersion = {0x0004};
+      uint16_t fsVersion = {0x0005};
       static constexpr uint16_t maxpathlen = 256;
+      static constexpr uint32_t sessionTimeout = 10000; // ms
       static constexpr ble_uuid16_t fsServiceUuid {
         .u {.type = BLE_UUID_TYPE_16},
         .value = {0xFEBB}}; // {0x72, 0x65, 0x66, 0x73, 0x6e, 0x61, 0x72, 0x54, 0x65, 0x6c, 0x69, 0x46, 0xBB, 0xFE, 0xAF, 0xAD}};
@@ -61,14 +71,15 @@ namespace Pinetime {
         LISTDIR = 0x50,
         LISTDIR_ENTRY = 0x51,
         MOVE = 0x60,
-        MOVE_STATUS = 0x61
+        MOVE_STATUS = 0x61,
+        CHECKSUM = 0x70,
+        CHECKSUM_STATUS = 0x71
       };
       enum class FSState : uint8_t {
         IDLE = 0x00,
         READ = 0x01,
         WRITE = 0x02,
       };
-      FSState state;
       char filepath[maxpathlen]; // TODO ..ugh fixed filepath len
       int fileSize;
       using ReadHeader = struct __attribute__((packed)) {
@@ -99,7 +110,7 @@ namespace Pinetime {
 
       using WriteHeader = struct __attribute__((packed)) {
         commands command;
-        uint8_t padding;
+        uint8_t window; // Number of WRITE_DATA acknowledged by a single WRITE_PACING (0 and 1 : every WRITE_DATA)
         uint16_t pathlen;
         uint32_t offset;
         uint64_t modTime;
@@ -184,8 +195,48 @@ namespace Pinetime {
         uint8_t status;
       };
 
+      using ChecksumHeader = struct __attribute__((packed)) {
+        commands command;
+        uint8_t padding;
+        uint16_t pathlen;
+        char pathstr[];
+      };
+
+      // CRC32 of the whole file, as computed by zlib
+      using ChecksumResponse = struct __attribute__((packed)) {
+        commands command;
+        uint8_t status;
+        uint16_t padding;
+        uint32_t size;
+        uint32_t crc;
+      };
+
+      // READ_DATA notifications must fit in the largest MTU
+      static constexpr uint16_t maxChunkSize = MYNEWT_VAL(BLE_ATT_PREFERRED_MTU) - 3 - sizeof(ReadResponse);
+
+      // The file of a read or write transfer stays open until the transfer is complete,
+      // another command is received, the connection is lost or the client is silent for sessionTimeout.
+      // The session is used by the BLE host task and by the timer task (timeout), under the mutex.
+      struct Session {
+        FSState state = FSState::IDLE;
+        lfs_file_t file;
+        uint32_t offset = 0;
+        uint32_t size = 0;
+        uint8_t window = 0;
+        uint8_t unacknowledged = 0;
+      };
+      Session session;
+      uint8_t chunkBuffer[maxChunkSize];
+      SemaphoreHandle_t mutex;
+      TimerHandle_t sessionTimer;
+
       int FSCommandHandler(uint16_t connectionHandle, os_mbuf* om);
-      void prepareReadDataResp(ReadHeader* header, ReadResponse* resp);
+      int OpenSession(FSState state, int flags);
+      int CloseSession();
+      uint16_t ChunkSize(uint16_t connectionHandle) const;
+      void SendReadData(uint16_t connectionHandle, uint32_t offset, uint32_t length, int status);
+      void SendWritePacing(uint16_t connectionHandle, uint32_t offset, int status);
+      int ComputeChecksum(const char* path, uint32_t& size, uint32_t& crc);
     };
   }
 }
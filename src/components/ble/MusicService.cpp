@@ -16,6 +16,8 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 #include "components/ble/MusicService.h"
+#include <algorithm>
+#include <cstring>
 #include "systemtask/SystemTask.h"
 
 namespace {
@@ -124,64 +126,45 @@ void Pinetime::Controllers::MusicService::Init() {
 
 int Pinetime::Controllers::MusicService::OnCommand(uint16_t conn_handle, uint16_t attr_handle, struct ble_gatt_access_ctxt* ctxt) {
   if (ctxt->op == BLE_GATT_ACCESS_OP_WRITE_CHR) {
-    size_t notifSize = OS_MBUF_PKTLEN(ctxt->om);
-    char data[notifSize + 1];
-    data[notifSize] = '\0';
+    size_t notifSize = std::min<size_t>(OS_MBUF_PKTLEN(ctxt->om), maxStringLength);
+    char data[maxStringLength + 1] {};
     os_mbuf_copydata(ctxt->om, 0, notifSize, data);
     char* s = &data[0];
-    if (ble_uuid_cmp(ctxt->chr->uuid, &msArtistCharUuid.u) == 0) {
-      artistName = s;
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &msTrackCharUuid.u) == 0) {
-      trackName = s;
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &msAlbumCharUuid.u) == 0) {
-      albumName = s;
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &msStatusCharUuid.u) == 0) {
-      playing = s[0];
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &msRepeatCharUuid.u) == 0) {
-      repeat = s[0];
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &msShuffleCharUuid.u) == 0) {
-      shuffle = s[0];
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &msPositionCharUuid.u) == 0) {
-      trackProgress = (s[0] << 24) | (s[1] << 16) | (s[2] << 8) | s[3];
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &msTotalLengthCharUuid.u) == 0) {
-      trackLength = (s[0] << 24) | (s[1] << 16) | (s[2] << 8) | s[3];
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &msTrackNumberCharUuid.u) == 0) {
-      trackNumber = (s[0] << 24) | (s[1] << 16) | (s[2] << 8) | s[3];
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &msTrackTotalCharUuid.u) == 0) {
-      tracksTotal = (s[0] << 24) | (s[1] << 16) | (s[2] << 8) | s[3];
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &msPlaybackSpeedCharUuid.u) == 0) {
-      playbackSpeed = static_cast<float>(((s[0] << 24) | (s[1] << 16) | (s[2] << 8) | s[3])) / 100.0f;
-    }
+    state.Write([&](State& current) {
+      if (ble_uuid_cmp(ctxt->chr->uuid, &msArtistCharUuid.u) == 0) {
+        std::memcpy(current.artist, s, notifSize + 1);
+      } else if (ble_uuid_cmp(ctxt->chr->uuid, &msTrackCharUuid.u) == 0) {
+        std::memcpy(current.track, s, notifSize + 1);
+      } else if (ble_uuid_cmp(ctxt->chr->uuid, &msAlbumCharUuid.u) == 0) {
+        std::memcpy(current.album, s, notifSize + 1);
+      } else if (ble_uuid_cmp(ctxt->chr->uuid, &msStatusCharUuid.u) == 0) {
+        current.playing = s[0];
+      } else if (ble_uuid_cmp(ctxt->chr->uuid, &msRepeatCharUuid.u) == 0) {
+        current.repeat = s[0];
+      } else if (ble_uuid_cmp(ctxt->chr->uuid, &msShuffleCharUuid.u) == 0) {
+        current.shuffle = s[0];
+      } else if (ble_uuid_cmp(ctxt->chr->uuid, &msPositionCharUuid.u) == 0) {
+        current.trackProgress = (s[0] << 24) | (s[1] << 16) | (s[2] << 8) | s[3];
+      } else if (ble_uuid_cmp(ctxt->chr->uuid, &msTotalLengthCharUuid.u) == 0) {
+        current.trackLength = (s[0] << 24) | (s[1] << 16) | (s[2] << 8) | s[3];
+      } else if (ble_uuid_cmp(ctxt->chr->uuid, &msTrackNumberCharUuid.u) == 0) {
+        current.trackNumber = (s[0] << 24) | (s[1] << 16) | (s[2] << 8) | s[3];
+      } else if (ble_uuid_cmp(ctxt->chr->uuid, &msTrackTotalCharUuid.u) == 0) {
+        current.tracksTotal = (s[0] << 24) | (s[1] << 16) | (s[2] << 8) | s[3];
+      } else if (ble_uuid_cmp(ctxt->chr->uuid, &msPlaybackSpeedCharUuid.u) == 0) {
+        current.playbackSpeed = static_cast<float>(((s[0] << 24) | (s[1] << 16) | (s[2] << 8) | s[3])) / 100.0f;
+      }
+    });
   }
   return 0;
 }
 
-std::string Pinetime::Controllers::MusicService::getAlbum() const {
-  return albumName;
+bool Pinetime::Controllers::MusicService::GetState(State& destination) const {
+  return state.Read(destination);
 }
 
-std::string Pinetime::Controllers::MusicService::getArtist() const {
-  return artistName;
-}
-
-std::string Pinetime::Controllers::MusicService::getTrack() const {
-  return trackName;
-}
-
-bool Pinetime::Controllers::MusicService::isPlaying() const {
-  return playing;
-}
-
-float Pinetime::Controllers::MusicService::getPlaybackSpeed() const {
-  return playbackSpeed;
-}
-
-int Pinetime::Controllers::MusicService::getProgress() const {
-  return trackProgress;
-}
-
-int Pinetime::Controllers::MusicService::getTrackLength() const {
-  return trackLength;
+uint32_t Pinetime::Controllers::MusicService::StateVersion() const {
+  return state.Version();
 }
 
 void Pinetime::Controllers::MusicService::event(char event) {
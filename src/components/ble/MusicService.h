@@ -17,14 +17,15 @@
 */
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
-#include <string>
 #define min // workaround: nimble's min/max macros conflict with libstdc++
 #define max
 #include <host/ble_gap.h>
 #include <host/ble_uuid.h>
 #undef max
 #undef min
+#include "utility/SeqLock.h"
 
 namespace Pinetime {
   namespace System {
@@ -41,19 +42,28 @@ namespace Pinetime {
 
       void event(char event);
 
-      std::string getArtist() const;
-
-      std::string getTrack() const;
-
-      std::string getAlbum() const;
-
-      int getProgress() const;
-
-      int getTrackLength() const;
-
-      float getPlaybackSpeed() const;
-
-      bool isPlaying() const;
+      static constexpr size_t maxStringLength = 64;
+
+      // Written by the BLE task, read by the display
+      struct State {
+        char artist[maxStringLength + 1];
+        char track[maxStringLength + 1];
+        char album[maxStringLength + 1];
+        bool playing;
+        int trackProgress;
+        int trackLength;
+        int trackNumber;
+        int tracksTotal;
+        float playbackSpeed;
+        bool repeat;
+        bool shuffle;
+      };
+
+      // Copies the current state. Returns false, and leaves state unchanged, if it was being modified.
+      bool GetState(State& state) const;
+
+      // Changes each time the state is modified
+      uint32_t StateVersion() const;
 
       static const char EVENT_MUSIC_OPEN = 0xe0;
       static const char EVENT_MUSIC_PLAY = 0x00;
@@ -71,21 +81,7 @@ namespace Pinetime {
 
       uint16_t eventHandle {};
 
-      std::string artistName {"Waiting for"};
-      std::string albumName {};
-      std::string trackName {"track information.."};
-
-      bool playing {false};
-
-      int trackProgress {0};
-      int trackLength {0};
-      int trackNumber {};
-      int tracksTotal {};
-
-      float playbackSpeed {1.0f};
-
-      bool repeat {false};
-      bool shuffle {false};
+      Utility::SeqLock<State> state {State {"Waiting for", "track information..", "", false, 0, 0, 0, 0, 1.0f, false, false}};
 
       Pinetime::System::SystemTask& m_system;
     };
@@ -17,10 +17,17 @@
 */
 
 #include "components/ble/NavigationService.h"
+#include <algorithm>
 
 #include "systemtask/SystemTask.h"
 
 namespace {
+  void CopyString(char* destination, size_t maxLength, const os_mbuf* om, size_t size) {
+    size = std::min(size, maxLength);
+    os_mbuf_copydata(om, 0, size, destination);
+    destination[size] = '\0';
+  }
+
   // 0001yyxx-78fc-48fe-8e23-433b3a1942d0
   constexpr ble_uuid128_t CharUuid(uint8_t x, uint8_t y) {
     return ble_uuid128_t {.u = {.type = BLE_UUID_TYPE_128},
@@ -60,8 +67,6 @@ Pinetime::Controllers::NavigationService::NavigationService(Pinetime::System::Sy
 
   serviceDefinition[0] = {.type = BLE_GATT_SVC_TYPE_PRIMARY, .uuid = &navUuid.u, .characteristics = characteristicDefinition};
   serviceDefinition[1] = {0};
-
-  m_progress = 0;
 }
 
 void Pinetime::Controllers::NavigationService::Init() {
@@ -77,35 +82,27 @@ int Pinetime::Controllers::NavigationService::OnCommand(uint16_t conn_handle, ui
 
   if (ctxt->op == BLE_GATT_ACCESS_OP_WRITE_CHR) {
     size_t notifSize = OS_MBUF_PKTLEN(ctxt->om);
-    uint8_t data[notifSize + 1];
-    data[notifSize] = '\0';
-    os_mbuf_copydata(ctxt->om, 0, notifSize, data);
-    char* s = (char*) &data[0];
-    if (ble_uuid_cmp(ctxt->chr->uuid, &navFlagCharUuid.u) == 0) {
-      m_flag = s;
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &navNarrativeCharUuid.u) == 0) {
-      m_narrative = s;
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &navManDistCharUuid.u) == 0) {
-      m_manDist = s;
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &navProgressCharUuid.u) == 0) {
-      m_progress = data[0];
-    }
+    state.Write([&](State& current) {
+      if (ble_uuid_cmp(ctxt->chr->uuid, &navFlagCharUuid.u) == 0) {
+        CopyString(current.flag, maxFlagLength, ctxt->om, notifSize);
+      } else if (ble_uuid_cmp(ctxt->chr->uuid, &navNarrativeCharUuid.u) == 0) {
+        CopyString(current.narrative, maxNarrativeLength, ctxt->om, notifSize);
+      } else if (ble_uuid_cmp(ctxt->chr->uuid, &navManDistCharUuid.u) == 0) {
+        CopyString(current.manDist, maxManDistLength, ctxt->om, notifSize);
+      } else if (ble_uuid_cmp(ctxt->chr->uuid, &navProgressCharUuid.u) == 0) {
+        uint8_t progress = 0;
+        os_mbuf_copydata(ctxt->om, 0, 1, &progress);
+        current.progress = progress;
+      }
+    });
   }
   return 0;
 }
 
-std::string Pinetime::Controllers::NavigationService::getFlag() {
-  return m_flag;
-}
-
-std::string Pinetime::Controllers::NavigationService::getNarrative() {
-  return m_narrative;
-}
-
-std::string Pinetime::Controllers::NavigationService::getManDist() {
-  return m_manDist;
+bool Pinetime::Controllers::NavigationService::GetState(State& destination) const {
+  return state.Read(destination);
 }
 
-int Pinetime::Controllers::NavigationService::getProgress() {
-  return m_progress;
+uint32_t Pinetime::Controllers::NavigationService::StateVersion() const {
+  return state.Version();
 }
@@ -17,14 +17,15 @@
 */
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
-#include <string>
 #define min // workaround: nimble's min/max macros conflict with libstdc++
 #define max
 #include <host/ble_gap.h>
 #include <host/ble_uuid.h>
 #undef max
 #undef min
+#include "utility/SeqLock.h"
 
 namespace Pinetime {
   namespace System {
@@ -40,22 +41,29 @@ namespace Pinetime {
 
       int OnCommand(uint16_t conn_handle, uint16_t attr_handle, struct ble_gatt_access_ctxt* ctxt);
 
-      std::string getFlag();
+      static constexpr size_t maxFlagLength = 32;
+      static constexpr size_t maxNarrativeLength = 100;
+      static constexpr size_t maxManDistLength = 16;
 
-      std::string getNarrative();
+      // Written by the BLE task, read by the display
+      struct State {
+        char flag[maxFlagLength + 1];
+        char narrative[maxNarrativeLength + 1];
+        char manDist[maxManDistLength + 1];
+        int progress;
+      };
 
-      std::string getManDist();
+      // Copies the current state. Returns false, and leaves state unchanged, if it was being modified.
+      bool GetState(State& state) const;
 
-      int getProgress();
+      // Changes each time the state is modified
+      uint32_t StateVersion() const;
 
     private:
       struct ble_gatt_chr_def characteristicDefinition[5];
       struct ble_gatt_svc_def serviceDefinition[2];
 
-      std::string m_flag;
-      std::string m_narrative;
-      std::string m_manDist;
-      int m_progress;
+      Utility::SeqLock<State> state;
 
       Pinetime::System::SystemTask& m_system;
     };
@@ -18,6 +18,7 @@
 #include "components/ble/BleController.h"
 #include "components/ble/NotificationManager.h"
 #include "components/datetime/DateTimeController.h"
+#include "logging/Trace.h"
 #include "components/fs/FS.h"
 #include "systemtask/SystemTask.h"
 
@@ -51,8 +52,10 @@ NimbleController::NimbleController(Pinetime::System::SystemTask& systemTask,
     immediateAlertService {systemTask, notificationManager},
     heartRateService {systemTask, heartRateController},
     motionService {systemTask, motionController},
+    debugService {fs, connParameters, systemTask.Monitor()},
     fsService {systemTask, fs},
-    serviceDiscovery({&currentTimeClient, &alertNotificationClient}) {
+    serviceDiscovery({&currentTimeClient, &alertNotificationClient}),
+    connParameters {systemTask} {
 }
 
 void nimble_on_reset(int reason) {
@@ -99,7 +102,9 @@ void NimbleController::Init() {
   immediateAlertService.Init();
   heartRateService.Init();
   motionService.Init();
+  debugService.Init();
   fsService.Init();
+  connParameters.Init();
 
   int rc;
   rc = ble_hs_util_ensure_addr(0);
@@ -181,6 +186,7 @@ void NimbleController::StartAdvertising() {
 }
 
 int NimbleController::OnGAPEvent(ble_gap_event* event) {
+  Pinetime::Logging::Trace::Instant(Pinetime::Logging::Trace::Events::BleGapEvent, event->type);
   switch (event->type) {
     case BLE_GAP_EVENT_ADV_COMPLETE:
       NRF_LOG_INFO("Advertising event : BLE_GAP_EVENT_ADV_COMPLETE");
@@ -207,6 +213,14 @@ int NimbleController::OnGAPEvent(ble_gap_event* event) {
         connectionHandle = event->connect.conn_handle;
         bleController.Connect();
         systemTask.PushMessage(Pinetime::System::Messages::BleConnected);
+        // Larger packets and the 2M PHY speed up the transfers (firmware updates, files). The data length
+        // extension is negotiated by the controller itself.
+        ble_gattc_exchange_mtu(connectionHandle, nullptr, nullptr);
+        ble_gap_set_prefered_le_phy(connectionHandle,
+                                    BLE_GAP_LE_PHY_1M_MASK | BLE_GAP_LE_PHY_2M_MASK,
+                                    BLE_GAP_LE_PHY_1M_MASK | BLE_GAP_LE_PHY_2M_MASK,
+                                    BLE_GAP_LE_PHY_CODED_ANY);
+        connParameters.OnConnect(connectionHandle);
         // Service discovery is deferred via systemtask
       }
       break;
@@ -222,6 +236,8 @@ int NimbleController::OnGAPEvent(ble_gap_event* event) {
 
       currentTimeClient.Reset();
       alertNotificationClient.Reset();
+      fsService.Reset();
+      connParameters.OnDisconnect();
       connectionHandle = BLE_HS_CONN_HANDLE_NONE;
       if(bleController.IsConnected()) {
         bleController.Disconnect();
@@ -234,6 +250,7 @@ int NimbleController::OnGAPEvent(ble_gap_event* event) {
       /* The central has updated the connection parameters. */
       NRF_LOG_INFO("Update event : BLE_GAP_EVENT_CONN_UPDATE");
       NRF_LOG_INFO("update status=%0X ", event->conn_update.status);
+      connParameters.OnParametersUpdated(event->conn_update.status);
       break;
 
     case BLE_GAP_EVENT_CONN_UPDATE_REQ:
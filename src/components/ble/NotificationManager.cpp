@@ -6,73 +6,78 @@ using namespace Pinetime::Controllers;
 
 constexpr uint8_t NotificationManager::MessageSize;
 
-void NotificationManager::Push(NotificationManager::Notification&& notif) {
-  notif.id = GetNextId();
-  notif.valid = true;
-  notifications[writeIndex] = std::move(notif);
-  writeIndex = (writeIndex + 1 < TotalNbNotifications) ? writeIndex + 1 : 0;
-  if (!empty)
-    readIndex = (readIndex + 1 < TotalNbNotifications) ? readIndex + 1 : 0;
-  else
-    empty = false;
+void NotificationManager::Push(Categories category, const char* message, uint8_t size) {
+  size = std::min<uint8_t>(std::max<uint8_t>(size, 1), MessageSize + 1);
+  sequence.BeginWrite();
+
+  uint16_t offset = 0;
+  uint16_t end = 0;
+  if (count > 0) {
+    const Entry& newest = EntryAt(count - 1);
+    end = newest.offset + newest.size;
+    offset = (end + size <= ArenaSize) ? end : 0;
+  }
+
+  // Discard the oldest notifications that are in the way of the new one. When the new message is written at the
+  // beginning of the arena, the messages stored after the newest one are the oldest, they are discarded first.
+  while (count > 0) {
+    const Entry& oldest = EntryAt(0);
+    bool inTheWay = (count == TotalNbNotifications) || (offset == 0 && end > 0 && oldest.offset >= end) ||
+                    (oldest.offset >= offset && oldest.offset < offset + size);
+    if (!inTheWay) {
+      break;
+    }
+    DiscardOldest();
+  }
+
+  std::memcpy(arena.data() + offset, message, size - 1);
+  arena[offset + size - 1] = '\0';
+  entries[(first + count) % TotalNbNotifications] = {nextId++, size, offset, category};
+  count++;
+  sequence.EndWrite();
 
   newNotification = true;
 }
 
-NotificationManager::Notification NotificationManager::GetLastNotification() {
-  NotificationManager::Notification notification = notifications[readIndex];
-  notification.index = 1;
-  return notification;
+NotificationManager::Notification NotificationManager::GetLastNotification() const {
+  return Read(
+    [this]() {
+      return (count == 0) ? Notification {} : MakeView(count - 1);
+    },
+    Notification {});
 }
 
-NotificationManager::Notification::Id NotificationManager::GetNextId() {
-  return nextId++;
+NotificationManager::Notification NotificationManager::GetNext(NotificationManager::Notification::Id id) const {
+  return Read(
+    [this, id]() {
+      uint8_t position;
+      if (!Find(id, position) || position + 1 >= count) {
+        return Notification {};
+      }
+      return MakeView(position + 1);
+    },
+    Notification {});
 }
 
-NotificationManager::Notification NotificationManager::GetNext(NotificationManager::Notification::Id id) {
-  auto currentIterator = std::find_if(notifications.begin(), notifications.end(), [id](const Notification& n) {
-    return n.valid && n.id == id;
-  });
-  if (currentIterator == notifications.end() || currentIterator->id != id)
-    return Notification {};
-
-  auto& lastNotification = notifications[readIndex];
-
-  NotificationManager::Notification result;
-
-  if (currentIterator == (notifications.end() - 1))
-    result = *(notifications.begin());
-  else
-    result = *(currentIterator + 1);
-
-  if (result.id <= id)
-    return {};
-
-  result.index = (lastNotification.id - result.id) + 1;
-  return result;
+NotificationManager::Notification NotificationManager::GetPrevious(NotificationManager::Notification::Id id) const {
+  return Read(
+    [this, id]() {
+      uint8_t position;
+      if (!Find(id, position) || position == 0) {
+        return Notification {};
+      }
+      return MakeView(position - 1);
+    },
+    Notification {});
 }
 
-NotificationManager::Notification NotificationManager::GetPrevious(NotificationManager::Notification::Id id) {
-  auto currentIterator = std::find_if(notifications.begin(), notifications.end(), [id](const Notification& n) {
-    return n.valid && n.id == id;
-  });
-  if (currentIterator == notifications.end() || currentIterator->id != id)
-    return Notification {};
-
-  auto& lastNotification = notifications[readIndex];
-
-  NotificationManager::Notification result;
-
-  if (currentIterator == notifications.begin())
-    result = *(notifications.end() - 1);
-  else
-    result = *(currentIterator - 1);
-
-  if (result.id >= id)
-    return {};
-
-  result.index = (lastNotification.id - result.id) + 1;
-  return result;
+bool NotificationManager::IsStored(const NotificationManager::Notification& notification) const {
+  return Read(
+    [this, &notification]() {
+      uint8_t position;
+      return Find(notification.id, position) && arena.data() + EntryAt(position).offset == notification.message;
+    },
+    false);
 }
 
 bool NotificationManager::AreNewNotificationsAvailable() {
@@ -84,24 +89,60 @@ bool NotificationManager::ClearNewNotificationFlag() {
 }
 
 size_t NotificationManager::NbNotifications() const {
-  return std::count_if(notifications.begin(), notifications.end(), [](const Notification& n) {
-    return n.valid;
-  });
+  return Read(
+    [this]() {
+      return count;
+    },
+    uint8_t {0});
+}
+
+const NotificationManager::Entry& NotificationManager::EntryAt(uint8_t position) const {
+  return entries[(first + position) % TotalNbNotifications];
+}
+
+NotificationManager::Notification NotificationManager::MakeView(uint8_t position) const {
+  const Entry& entry = EntryAt(position);
+  Notification notification;
+  notification.id = entry.id;
+  notification.valid = true;
+  notification.index = count - position;
+  notification.size = entry.size;
+  notification.message = arena.data() + entry.offset;
+  notification.category = entry.category;
+  return notification;
+}
+
+bool NotificationManager::Find(NotificationManager::Notification::Id id, uint8_t& position) const {
+  if (count == 0) {
+    return false;
+  }
+  // Ids are consecutive, the position of a notification is given by its distance to the newest one
+  uint8_t distance = EntryAt(count - 1).id - id;
+  if (distance >= count) {
+    return false;
+  }
+  position = count - 1 - distance;
+  return true;
+}
+
+void NotificationManager::DiscardOldest() {
+  first = (first + 1) % TotalNbNotifications;
+  count--;
 }
 
 const char* NotificationManager::Notification::Message() const {
-  const char* itField = std::find(message.begin(), message.begin() + size - 1, '\0');
-  if (itField != message.begin() + size - 1) {
+  const char* itField = std::find(message, message + size - 1, '\0');
+  if (itField != message + size - 1) {
     const char* ptr = (itField) + 1;
     return ptr;
   }
-  return const_cast<char*>(message.data());
+  return message;
 }
 
 const char* NotificationManager::Notification::Title() const {
-  const char* itField = std::find(message.begin(), message.begin() + size - 1, '\0');
-  if (itField != message.begin() + size - 1) {
-    return message.data();
+  const char* itField = std::find(message, message + size - 1, '\0');
+  if (itField != message + size - 1) {
+    return message;
   }
   return {};
 }
@@ -4,12 +4,13 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include "utility/SeqLock.h"
 
 namespace Pinetime {
   namespace Controllers {
     class NotificationManager {
     public:
-      enum class Categories {
+      enum class Categories : uint8_t {
         Unknown,
         SimpleAlert,
         Email,
@@ -22,26 +23,32 @@ namespace Pinetime {
         HighProriotyAlert,
         InstantMessage
       };
-      static constexpr uint8_t MessageSize {100};
+      static constexpr uint8_t MessageSize {200};
 
+      // View of a notification stored in the manager. The message points into the storage of the manager,
+      // it remains valid until the notification is discarded to make room for newer ones.
+      // Notifications are pushed by the BLE task: after reading the message, check with IsStored() that it was not
+      // discarded in the meantime.
       struct Notification {
         using Id = uint8_t;
-        Id id;
+        Id id = 0;
         bool valid = false;
-        uint8_t index;
-        uint8_t size;
-        std::array<char, MessageSize + 1> message;
+        uint8_t index = 0;
+        uint8_t size = 0;
+        const char* message = nullptr;
         Categories category = Categories::Unknown;
 
         const char* Message() const;
         const char* Title() const;
       };
-      Notification::Id nextId {0};
 
-      void Push(Notification&& notif);
-      Notification GetLastNotification();
-      Notification GetNext(Notification::Id id);
-      Notification GetPrevious(Notification::Id id);
+      // message is "title\0body" (or only the body), size includes the string terminator.
+      // Messages longer than MessageSize are truncated.
+      void Push(Categories category, const char* message, uint8_t size);
+      Notification GetLastNotification() const;
+      Notification GetNext(Notification::Id id) const;
+      Notification GetPrevious(Notification::Id id) const;
+      bool IsStored(const Notification& notification) const;
       bool ClearNewNotificationFlag();
       bool AreNewNotificationsAvailable();
 
@@ -51,13 +58,50 @@ namespace Pinetime {
       size_t NbNotifications() const;
 
     private:
-      Notification::Id GetNextId();
-      static constexpr uint8_t TotalNbNotifications = 5;
-      std::array<Notification, TotalNbNotifications> notifications;
-      uint8_t readIndex = 0;
-      uint8_t writeIndex = 0;
-      bool empty = true;
+      // The messages are packed one after the other in a byte arena, used as a ring buffer.
+      // A message never wraps around the end of the arena: it is written at the beginning instead.
+      // The oldest notifications are discarded when there's not enough room in the arena or in the index.
+      static constexpr uint16_t ArenaSize = 448;
+      static constexpr uint8_t TotalNbNotifications = 16;
+      static_assert(MessageSize + 1 <= ArenaSize, "A message must fit in the arena");
+
+      struct Entry {
+        Notification::Id id;
+        uint8_t size;
+        uint16_t offset;
+        Categories category;
+      };
+
+      // The last byte is never written, a message read while it's overwritten can't run past the arena
+      std::array<char, ArenaSize + 1> arena {};
+      // Ring of the stored notifications, from the oldest (first) to the newest
+      std::array<Entry, TotalNbNotifications> entries;
+      uint8_t first = 0;
+      uint8_t count = 0;
+      Notification::Id nextId {0};
       std::atomic<bool> newNotification {false};
+      // Push() is called from the BLE task, the other methods from the display task
+      Utility::SequenceCounter sequence;
+
+      // Returns reader(), or defaultResult if every attempt overlapped a Push()
+      template <class Result, class Reader> Result Read(Reader&& reader, Result defaultResult) const {
+        for (uint8_t attempt = 0; attempt < Utility::SequenceCounter::maxReadAttempts; attempt++) {
+          uint32_t version;
+          if (!sequence.BeginRead(version)) {
+            continue;
+          }
+          Result result = reader();
+          if (sequence.Validate(version)) {
+            return result;
+          }
+        }
+        return defaultResult;
+      }
+
+      const Entry& EntryAt(uint8_t position) const;
+      Notification MakeView(uint8_t position) const;
+      bool Find(Notification::Id id, uint8_t& position) const;
+      void DiscardOldest();
     };
   }
 }
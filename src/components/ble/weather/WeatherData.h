@@ -17,6 +17,9 @@
 */
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 /**
  * Different weather events, weather data structures used by {@link WeatherService.h}
  *
@@ -30,7 +33,8 @@
  * so keep in the bounds of the data types given.
  *
  * Write all struct members (CamelCase keys) into a single finite-sized map, and write it to the characteristic.
- * Mind the MTU.
+ * Several events can be sent in a single (long) write as a finite-sized array of such maps,
+ * the whole payload must not exceed 512 bytes.
  *
  * How to debug?
  *
@@ -49,6 +53,10 @@ namespace Pinetime {
   namespace Controllers {
     class WeatherData {
     public:
+      /** Longer strings are truncated */
+      static constexpr size_t maxLocationLength = 32;
+      static constexpr size_t maxPolluterLength = 16;
+
       /**
        * Visibility obscuration types
        */
@@ -289,8 +297,8 @@ namespace Pinetime {
        */
       class Location : public TimelineHeader {
       public:
-        /** Location name */
-        std::string location;
+        /** Location name, null-terminated */
+        char location[maxLocationLength + 1];
         /** Altitude relative to sea level in meters */
         int16_t altitude;
         /** Latitude, EPSG:3857 (Google Maps, Openstreetmaps datum) */
@@ -351,7 +359,7 @@ namespace Pinetime {
          * For chemical compounds use the molecular formula e.g. "NO2", "CO2", "O3"
          * For pollen use the genus, e.g. "Betula" for birch or "Alternaria" for that mold's spores
          */
-        std::string polluter;
+        char polluter[maxPolluterLength + 1];
         /**
          * Amount of the pollution in SI units,
          * otherwise it's going to be difficult to create UI, alerts
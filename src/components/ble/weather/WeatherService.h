@@ -18,9 +18,7 @@
 #pragma once
 
 #include <cstdint>
-#include <string>
-#include <vector>
-#include <memory>
+#include <type_traits>
 
 #define min // workaround: nimble's min/max macros conflict with libstdc++
 #define max
@@ -30,6 +28,7 @@
 #undef min
 
 #include "WeatherData.h"
+#include "WeatherTimeline.h"
 #include "libs/QCBOR/inc/qcbor/qcbor.h"
 #include "components/datetime/DateTimeController.h"
 
@@ -51,16 +50,18 @@ namespace Pinetime {
 
       /*
        * Helper functions for quick access to currently valid data
+       *
+       * They return an event with a timestamp of 0 if there's no valid data
        */
-      std::unique_ptr<WeatherData::Location>& GetCurrentLocation();
-      std::unique_ptr<WeatherData::Clouds>& GetCurrentClouds();
-      std::unique_ptr<WeatherData::Obscuration>& GetCurrentObscuration();
-      std::unique_ptr<WeatherData::Precipitation>& GetCurrentPrecipitation();
-      std::unique_ptr<WeatherData::Wind>& GetCurrentWind();
-      std::unique_ptr<WeatherData::Temperature>& GetCurrentTemperature();
-      std::unique_ptr<WeatherData::Humidity>& GetCurrentHumidity();
-      std::unique_ptr<WeatherData::Pressure>& GetCurrentPressure();
-      std::unique_ptr<WeatherData::AirQuality>& GetCurrentQuality();
+      const WeatherData::Location& GetCurrentLocation() const;
+      const WeatherData::Clouds& GetCurrentClouds() const;
+      const WeatherData::Obscuration& GetCurrentObscuration() const;
+      const WeatherData::Precipitation& GetCurrentPrecipitation() const;
+      const WeatherData::Wind& GetCurrentWind() const;
+      const WeatherData::Temperature& GetCurrentTemperature() const;
+      const WeatherData::Humidity& GetCurrentHumidity() const;
+      const WeatherData::Pressure& GetCurrentPressure() const;
+      const WeatherData::AirQuality& GetCurrentQuality() const;
 
       /**
        * Searches for the current day's maximum temperature
@@ -77,10 +78,15 @@ namespace Pinetime {
        * Management functions
        */
       /**
-       * Adds an event to the timeline
-       * @return
+       * Adds an event to the timeline of its type
+       * @return false if the timeline is full of newer events
        */
-      bool AddEventToTimeline(std::unique_ptr<WeatherData::TimelineHeader> event);
+      template <class Event> bool AddEventToTimeline(const Event& event) {
+        if (std::is_same<Event, WeatherData::Temperature>::value) {
+          todayTemperatures.valid = false;
+        }
+        return TimelineOf(event).Insert(event, GetCurrentUnixTimestamp());
+      }
       /**
        * Gets the current timeline length
        */
@@ -134,20 +140,73 @@ namespace Pinetime {
       Pinetime::System::SystemTask& system;
       Pinetime::Controllers::DateTime& dateTimeController;
 
-      std::vector<std::unique_ptr<WeatherData::TimelineHeader>> timeline;
-      std::unique_ptr<WeatherData::TimelineHeader> nullTimelineheader = std::make_unique<WeatherData::TimelineHeader>();
-      std::unique_ptr<WeatherData::TimelineHeader>* nullHeader;
+      /*
+       * One timeline per event type, their capacity bounds the memory used by the service
+       */
+      WeatherTimeline<WeatherData::Obscuration, 4> obscurations;
+      WeatherTimeline<WeatherData::Precipitation, 16> precipitations;
+      WeatherTimeline<WeatherData::Wind, 8> winds;
+      WeatherTimeline<WeatherData::Temperature, 16> temperatures;
+      WeatherTimeline<WeatherData::AirQuality, 4> airQualities;
+      WeatherTimeline<WeatherData::Special, 4> specials;
+      WeatherTimeline<WeatherData::Pressure, 8> pressures;
+      WeatherTimeline<WeatherData::Location, 1> locations;
+      WeatherTimeline<WeatherData::Clouds, 8> clouds;
+      WeatherTimeline<WeatherData::Humidity, 8> humidities;
+
+      auto& TimelineOf(const WeatherData::Obscuration&) {
+        return obscurations;
+      }
+      auto& TimelineOf(const WeatherData::Precipitation&) {
+        return precipitations;
+      }
+      auto& TimelineOf(const WeatherData::Wind&) {
+        return winds;
+      }
+      auto& TimelineOf(const WeatherData::Temperature&) {
+        return temperatures;
+      }
+      auto& TimelineOf(const WeatherData::AirQuality&) {
+        return airQualities;
+      }
+      auto& TimelineOf(const WeatherData::Special&) {
+        return specials;
+      }
+      auto& TimelineOf(const WeatherData::Pressure&) {
+        return pressures;
+      }
+      auto& TimelineOf(const WeatherData::Location&) {
+        return locations;
+      }
+      auto& TimelineOf(const WeatherData::Clouds&) {
+        return clouds;
+      }
+      auto& TimelineOf(const WeatherData::Humidity&) {
+        return humidities;
+      }
 
       /**
-       * Cleans up the timeline of expired events
+       * The minimum and maximum temperatures of the day only change when the temperature timeline changes,
+       * an event expires or the day changes
        */
-      void TidyTimeline();
+      struct TodayTemperatures {
+        bool valid = false;
+        uint64_t dayEnd;
+        uint64_t nextExpiration;
+        int16_t min;
+        int16_t max;
+      };
+      mutable TodayTemperatures todayTemperatures;
+      const TodayTemperatures& GetTodayTemperatures() const;
 
       /**
-       * Compares two timeline events
+       * Returns the current event of the timeline, or an empty event (timestamp = 0) if there's none
        */
-      static bool CompareTimelineEvents(const std::unique_ptr<WeatherData::TimelineHeader>& first,
-                                        const std::unique_ptr<WeatherData::TimelineHeader>& second);
+      template <class Event, uint8_t Capacity> const Event& GetCurrent(const WeatherTimeline<Event, Capacity>& timeline) const {
+        static const Event noEvent {};
+        const Event* event = timeline.Current(GetCurrentUnixTimestamp());
+        return (event != nullptr) ? *event : noEvent;
+      }
 
       /**
        * Returns current UNIX timestamp
@@ -155,13 +214,26 @@ namespace Pinetime {
       uint64_t GetCurrentUnixTimestamp() const;
 
       /**
-       * Checks if the event hasn't gone past and expired
-       *
-       * @param header timeline event to check
-       * @param currentTimestamp what's the time right now
-       * @return if the event is valid
+       * Copies a CBOR text string into a fixed size buffer, truncating it if needed
+       */
+      static void CopyString(char* destination, size_t size, UsefulBufC source);
+
+      /**
+       * Largest write accepted on the characteristic (maximum length of an attribute value)
+       */
+      static constexpr uint16_t maxWriteLength = 512;
+      static constexpr uint8_t cborMajorTypeArray = 4;
+      uint8_t writeBuffer[maxWriteLength];
+
+      /**
+       * Returns the CBOR payload of a write, copied into writeBuffer only if it's split over several mbufs
+       */
+      UsefulBufC GetPayload(os_mbuf* om);
+      /**
+       * Decodes a single event (CBOR map) and adds it to the timeline
+       * @return 0 on success, an ATT error code otherwise
        */
-      static bool IsEventStillValid(const std::unique_ptr<WeatherData::TimelineHeader>& uniquePtr, const uint64_t timestamp);
+      int DecodeEvent(QCBORDecodeContext* decodeContext);
 
       /**
        * This is a helper function that closes a QCBOR map and decoding context cleanly
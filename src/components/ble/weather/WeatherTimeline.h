@@ -0,0 +1,121 @@
+/*  Copyright (C) 2021 Avamander
+
+    This file is part of InfiniTime.
+
+    InfiniTime is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    InfiniTime is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Controllers {
+    /**
+     * Fixed capacity timeline of the events of a single type
+     *
+     * The events are stored by value, sorted by timestamp (newest first),
+     * so that the current event can be found with a binary search.
+     */
+    template <class Event, uint8_t Capacity> class WeatherTimeline {
+    public:
+      /**
+       * Inserts an event, or replaces the event that has the same timestamp
+       *
+       * When the timeline is full, the expired events are removed, then the oldest one.
+       * @return false if the timeline is full of events that are newer than this one
+       */
+      bool Insert(const Event& event, uint64_t currentTimestamp) {
+        uint8_t position = LowerBound(event.timestamp);
+        if (position < size && events[position].timestamp == event.timestamp) {
+          events[position] = event;
+          return true;
+        }
+
+        if (size == Capacity) {
+          RemoveExpired(currentTimestamp);
+          position = LowerBound(event.timestamp);
+        }
+        if (size == Capacity) {
+          if (position == Capacity) {
+            return false;
+          }
+          size--;
+        }
+
+        std::move_backward(events + position, events + size, events + size + 1);
+        events[position] = event;
+        size++;
+        return true;
+      }
+
+      /**
+       * Returns the latest event that has started and has not expired yet, nullptr if there's none
+       */
+      const Event* Current(uint64_t currentTimestamp) const {
+        uint8_t position = LowerBound(currentTimestamp);
+        if (position < size && IsValid(events[position], currentTimestamp)) {
+          return &events[position];
+        }
+        return nullptr;
+      }
+
+      bool HasValidEvent(uint64_t currentTimestamp) const {
+        return std::any_of(events, events + size, [currentTimestamp](const Event& event) {
+          return IsValid(event, currentTimestamp);
+        });
+      }
+
+      void RemoveExpired(uint64_t currentTimestamp) {
+        size = std::remove_if(events,
+                              events + size,
+                              [currentTimestamp](const Event& event) {
+                                return !IsValid(event, currentTimestamp);
+                              }) -
+               events;
+      }
+
+      uint8_t Size() const {
+        return size;
+      }
+
+      const Event* begin() const {
+        return events;
+      }
+
+      const Event* end() const {
+        return events + size;
+      }
+
+      static bool IsValid(const Event& event, uint64_t currentTimestamp) {
+        return event.timestamp + event.expires >= currentTimestamp;
+      }
+
+    private:
+      Event events[Capacity];
+      uint8_t size = 0;
+
+      // Index of the first event that is not newer than timestamp
+      uint8_t LowerBound(uint64_t timestamp) const {
+        return std::lower_bound(events,
+                                events + size,
+                                timestamp,
+                                [](const Event& event, uint64_t t) {
+                                  return event.timestamp > t;
+                                }) -
+               events;
+      }
+    };
+  }
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Tools {
+    /* Table driven CRC computations. The number of tables (NbSlices) is chosen at compile time :
+     *  - 1 : one 256 entries table, 1 byte per iteration
+     *  - 4 or 8 : slice-by-N, N bytes per iteration, N tables
+     * More tables are faster but use more flash memory (NbSlices * 256 * sizeof(crc)).
+     *
+     * The CRC can be computed incrementally: call Update() for each chunk of data, in order, and then Value().
+     */
+
+    // CRC16-CCITT (polynomial 0x1021, initial value 0xFFFF, not reflected), as used by the Nordic DFU protocol
+    template <uint8_t NbSlices> class Crc16Engine {
+      static_assert(NbSlices == 1 || NbSlices == 4 || NbSlices == 8, "NbSlices must be 1, 4 or 8");
+
+    public:
+      void Reset() {
+        crc = 0xffff;
+      }
+
+      void Update(const uint8_t* data, size_t size) {
+        uint16_t c = crc;
+        if (NbSlices > 1) {
+          for (; size >= NbSlices; size -= NbSlices, data += NbSlices) {
+            uint16_t value = table.values[NbSlices - 1][(c >> 8) ^ data[0]] ^ table.values[NbSlices - 2][(c & 0xff) ^ data[1]];
+            for (uint8_t i = 2; i < NbSlices; i++) {
+              value ^= table.values[NbSlices - 1 - i][data[i]];
+            }
+            c = value;
+          }
+        }
+        for (size_t i = 0; i < size; i++) {
+          c = (c << 8) ^ table.values[0][(c >> 8) ^ data[i]];
+        }
+        crc = c;
+      }
+
+      uint16_t Value() const {
+        return crc;
+      }
+
+      static uint16_t Compute(const uint8_t* data, size_t size) {
+        Crc16Engine engine;
+        engine.Update(data, size);
+        return engine.Value();
+      }
+
+    private:
+      struct Table {
+        uint16_t values[NbSlices][256];
+      };
+
+      static constexpr Table GenerateTable() {
+        Table t {};
+        for (uint16_t b = 0; b < 256; b++) {
+          uint16_t c = b << 8;
+          for (uint8_t bit = 0; bit < 8; bit++) {
+            c = (c & 0x8000) ? ((c << 1) ^ 0x1021) : (c << 1);
+          }
+          t.values[0][b] = c;
+        }
+        // values[k][b] : CRC of the byte b followed by k null bytes
+        for (uint8_t k = 1; k < NbSlices; k++) {
+          for (uint16_t b = 0; b < 256; b++) {
+            uint16_t previous = t.values[k - 1][b];
+            t.values[k][b] = static_cast<uint16_t>(previous << 8) ^ t.values[0][previous >> 8];
+          }
+        }
+        return t;
+      }
+
+      static constexpr Table table = GenerateTable();
+      uint16_t crc = 0xffff;
+    };
+
+    template <uint8_t NbSlices> constexpr typename Crc16Engine<NbSlices>::Table Crc16Engine<NbSlices>::table;
+
+    // CRC32 (polynomial 0x04C11DB7 reflected, as used by zlib, PNG, Ethernet,...)
+    template <uint8_t NbSlices> class Crc32Engine {
+      static_assert(NbSlices == 1 || NbSlices == 4 || NbSlices == 8, "NbSlices must be 1, 4 or 8");
+
+    public:
+      void Reset() {
+        crc = 0xffffffff;
+      }
+
+      void Update(const uint8_t* data, size_t size) {
+        uint32_t c = crc;
+        if (NbSlices > 1) {
+          for (; size >= NbSlices; size -= NbSlices, data += NbSlices) {
+            uint32_t word = c ^ (data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24));
+            uint32_t value = 0;
+            for (uint8_t i = 0; i < 4; i++) {
+              value ^= table.values[NbSlices - 1 - i][(word >> (8 * i)) & 0xff];
+            }
+            for (uint8_t i = 4; i < NbSlices; i++) {
+              value ^= table.values[NbSlices - 1 - i][data[i]];
+            }
+            c = value;
+          }
+        }
+        for (size_t i = 0; i < size; i++) {
+          c = (c >> 8) ^ table.values[0][(c ^ data[i]) & 0xff];
+        }
+        crc = c;
+      }
+
+      uint32_t Value() const {
+        return crc ^ 0xffffffff;
+      }
+
+      static uint32_t Compute(const uint8_t* data, size_t size) {
+        Crc32Engine engine;
+        engine.Update(data, size);
+        return engine.Value();
+      }
+
+    private:
+      struct Table {
+        uint32_t values[NbSlices][256];
+      };
+
+      static constexpr Table GenerateTable() {
+        Table t {};
+        for (uint16_t b = 0; b < 256; b++) {
+          uint32_t c = b;
+          for (uint8_t bit = 0; bit < 8; bit++) {
+            c = (c & 1) ? ((c >> 1) ^ 0xedb88320) : (c >> 1);
+          }
+          t.values[0][b] = c;
+        }
+        // values[k][b] : CRC of the byte b followed by k null bytes
+        for (uint8_t k = 1; k < NbSlices; k++) {
+          for (uint16_t b = 0; b < 256; b++) {
+            uint32_t previous = t.values[k - 1][b];
+            t.values[k][b] = (previous >> 8) ^ t.values[0][previous & 0xff];
+          }
+        }
+        return t;
+      }
+
+      static constexpr Table table = GenerateTable();
+      uint32_t crc = 0xffffffff;
+    };
+
+    template <uint8_t NbSlices> constexpr typename Crc32Engine<NbSlices>::Table Crc32Engine<NbSlices>::table;
+
+    // The DFU image is checked while it is received, the file transfers are limited by the external memory
+    using Crc16 = Crc16Engine<4>;
+    using Crc32 = Crc32Engine<1>;
+  }
+}
@@ -1,6 +1,8 @@
 #include "components/datetime/DateTimeController.h"
 #include <date/date.h>
 #include <libraries/log/nrf_log.h>
+#include <FreeRTOS.h>
+#include <task.h>
 #include <systemtask/SystemTask.h>
 
 using namespace Pinetime::Controllers;
@@ -15,8 +17,11 @@ DateTime::DateTime(Controllers::Settings& settingsController) : settingsControll
 }
 
 void DateTime::SetCurrentTime(std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> t) {
+  taskENTER_CRITICAL();
   this->currentDateTime = t;
-  UpdateTime(previousSystickCounter); // Update internal state without updating the time
+  uint8_t notifications = AdvanceTime(previousSystickCounter); // Update internal state without updating the time
+  taskEXIT_CRITICAL();
+  Notify(notifications);
 }
 
 void DateTime::SetTime(
@@ -30,20 +35,33 @@ void DateTime::SetTime(
     /* .tm_year = */ year - 1900,
   };
   tm.tm_isdst = -1; // Use DST value from local time zone
-  currentDateTime = std::chrono::system_clock::from_time_t(std::mktime(&tm));
+  auto newDateTime = std::chrono::system_clock::from_time_t(std::mktime(&tm));
 
   NRF_LOG_INFO("%d %d %d ", day, month, year);
   NRF_LOG_INFO("%d %d %d ", hour, minute, second);
-  previousSystickCounter = systickCounter;
 
-  UpdateTime(systickCounter);
+  taskENTER_CRITICAL();
+  currentDateTime = newDateTime;
+  previousSystickCounter = systickCounter;
+  uint8_t notifications = AdvanceTime(systickCounter);
+  taskEXIT_CRITICAL();
   NRF_LOG_INFO("* %d %d %d ", this->hour, this->minute, this->second);
   NRF_LOG_INFO("* %d %d %d ", this->day, this->month, this->year);
 
+  Notify(notifications);
   systemTask->PushMessage(System::Messages::OnNewTime);
 }
 
 void DateTime::UpdateTime(uint32_t systickCounter) {
+  // The time is updated by several tasks : a task preempted in the middle of the update by another one would
+  // add the same seconds twice. The messages are sent once the critical section is left, as they can block.
+  taskENTER_CRITICAL();
+  uint8_t notifications = AdvanceTime(systickCounter);
+  taskEXIT_CRITICAL();
+  Notify(notifications);
+}
+
+uint8_t DateTime::AdvanceTime(uint32_t systickCounter) {
   // Handle systick counter overflow
   uint32_t systickDelta = 0;
   if (systickCounter < previousSystickCounter) {
@@ -80,20 +98,17 @@ void DateTime::UpdateTime(uint32_t systickCounter) {
   minute = time.minutes().count();
   second = time.seconds().count();
 
+  uint8_t notifications = 0;
   if (minute == 0 && !isHourAlreadyNotified) {
     isHourAlreadyNotified = true;
-    if (systemTask != nullptr) {
-      systemTask->PushMessage(System::Messages::OnNewHour);
-    }
+    notifications |= NewHour;
   } else if (minute != 0) {
     isHourAlreadyNotified = false;
   }
 
   if ((minute == 0 || minute == 30) && !isHalfHourAlreadyNotified) {
     isHalfHourAlreadyNotified = true;
-    if (systemTask != nullptr) {
-      systemTask->PushMessage(System::Messages::OnNewHalfHour);
-    }
+    notifications |= NewHalfHour;
   } else if (minute != 0 && minute != 30) {
     isHalfHourAlreadyNotified = false;
   }
@@ -101,11 +116,26 @@ void DateTime::UpdateTime(uint32_t systickCounter) {
   // Notify new day to SystemTask
   if (hour == 0 and not isMidnightAlreadyNotified) {
     isMidnightAlreadyNotified = true;
-    if (systemTask != nullptr)
-      systemTask->PushMessage(System::Messages::OnNewDay);
+    notifications |= NewDay;
   } else if (hour != 0) {
     isMidnightAlreadyNotified = false;
   }
+  return notifications;
+}
+
+void DateTime::Notify(uint8_t notifications) {
+  if (systemTask == nullptr) {
+    return;
+  }
+  if ((notifications & NewHour) != 0) {
+    systemTask->PushMessage(System::Messages::OnNewHour);
+  }
+  if ((notifications & NewHalfHour) != 0) {
+    systemTask->PushMessage(System::Messages::OnNewHalfHour);
+  }
+  if ((notifications & NewDay) != 0) {
+    systemTask->PushMessage(System::Messages::OnNewDay);
+  }
 }
 
 const char* DateTime::MonthShortToString() {
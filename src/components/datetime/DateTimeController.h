@@ -38,6 +38,7 @@ namespace Pinetime {
                    uint8_t minute,
                    uint8_t second,
                    uint32_t systickCounter);
+      // Called by SystemTask when it wakes up and by DisplayApp before each refresh
       void UpdateTime(uint32_t systickCounter);
       uint16_t Year() const {
         return year;
@@ -77,6 +78,11 @@ namespace Pinetime {
       std::string FormattedTime();
 
     private:
+      enum Notifications : uint8_t { NewHour = 0x01, NewHalfHour = 0x02, NewDay = 0x04 };
+
+      uint8_t AdvanceTime(uint32_t systickCounter);
+      void Notify(uint8_t notifications);
+
       uint16_t year = 0;
       Months month = Months::Unknown;
       uint8_t day = 0;
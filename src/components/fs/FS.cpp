@@ -2,11 +2,15 @@
 #include <cstring>
 #include <littlefs/lfs.h>
 #include <lvgl/lvgl.h>
+#include "logging/Trace.h"
+#include "utility/LockGuard.h"
 
 using namespace Pinetime::Controllers;
+using Pinetime::Utility::LockGuard;
 
 FS::FS(Pinetime::Drivers::SpiNorFlash& driver)
   : flashDriver {driver},
+    flashCache {driver},
     lfsConfig {
       .context = this,
       .read = SectorRead,
@@ -29,6 +33,9 @@ FS::FS(Pinetime::Drivers::SpiNorFlash& driver)
 }
 
 void FS::Init() {
+  mutex = xSemaphoreCreateMutex();
+  ASSERT(mutex != nullptr);
+  LockGuard lock {mutex};
 
   // try mount
   int err = lfs_mount(&lfs, &lfsConfig);
@@ -55,53 +62,77 @@ void FS::VerifyResource() {
 }
 
 int FS::FileOpen(lfs_file_t* file_p, const char* fileName, const int flags) {
+  LockGuard lock {mutex};
   return lfs_file_open(&lfs, file_p, fileName, flags);
 }
 
 int FS::FileClose(lfs_file_t* file_p) {
+  LockGuard lock {mutex};
   return lfs_file_close(&lfs, file_p);
 }
 
 int FS::FileRead(lfs_file_t* file_p, uint8_t* buff, uint32_t size) {
+  LockGuard lock {mutex};
   return lfs_file_read(&lfs, file_p, buff, size);
 }
 
 int FS::FileWrite(lfs_file_t* file_p, const uint8_t* buff, uint32_t size) {
+  LockGuard lock {mutex};
   return lfs_file_write(&lfs, file_p, buff, size);
 }
 
 int FS::FileSeek(lfs_file_t* file_p, uint32_t pos) {
+  LockGuard lock {mutex};
   return lfs_file_seek(&lfs, file_p, pos, LFS_SEEK_SET);
 }
 
+int FS::FileTell(lfs_file_t* file_p) {
+  LockGuard lock {mutex};
+  return lfs_file_tell(&lfs, file_p);
+}
+
+int FS::FileSize(lfs_file_t* file_p) {
+  LockGuard lock {mutex};
+  return lfs_file_size(&lfs, file_p);
+}
+
 int FS::FileDelete(const char* fileName) {
+  LockGuard lock {mutex};
   return lfs_remove(&lfs, fileName);
 }
 
 int FS::DirOpen(const char* path, lfs_dir_t* lfs_dir) {
+  LockGuard lock {mutex};
   return lfs_dir_open(&lfs, lfs_dir, path);
 }
 
 int FS::DirClose(lfs_dir_t* lfs_dir) {
+  LockGuard lock {mutex};
   return lfs_dir_close(&lfs, lfs_dir);
 }
 
 int FS::DirRead(lfs_dir_t* dir, lfs_info* info) {
+  LockGuard lock {mutex};
   return lfs_dir_read(&lfs, dir, info);
 }
 int FS::DirRewind(lfs_dir_t* dir) {
+  LockGuard lock {mutex};
   return lfs_dir_rewind(&lfs, dir);
 }
 int FS::DirCreate(const char* path) {
+  LockGuard lock {mutex};
   return lfs_mkdir(&lfs, path);
 }
 int FS::Rename(const char* oldPath, const char* newPath){
+  LockGuard lock {mutex};
   return lfs_rename(&lfs,oldPath,newPath);
 }
 int FS::Stat(const char* path, lfs_info* info) {
+  LockGuard lock {mutex};
   return lfs_stat(&lfs, path, info);
 }
 lfs_ssize_t FS::GetFSSize() {
+  LockGuard lock {mutex};
   return lfs_fs_size(&lfs);
 }
 
@@ -111,27 +142,31 @@ lfs_ssize_t FS::GetFSSize() {
 
 */
 int FS::SectorSync(const struct lfs_config* c) {
-  return 0;
+  Pinetime::Logging::Trace::Scope trace {Pinetime::Logging::Trace::Events::FsSync};
+  Pinetime::Controllers::FS& lfs = *(static_cast<Pinetime::Controllers::FS*>(c->context));
+  return lfs.flashCache.Flush() ? 0 : -1;
 }
 
 int FS::SectorErase(const struct lfs_config* c, lfs_block_t block) {
+  Pinetime::Logging::Trace::Scope trace {Pinetime::Logging::Trace::Events::FsErase, static_cast<uint16_t>(block)};
   Pinetime::Controllers::FS& lfs = *(static_cast<Pinetime::Controllers::FS*>(c->context));
   const size_t address = startAddress + (block * blockSize);
-  lfs.flashDriver.SectorErase(address);
-  return lfs.flashDriver.EraseFailed() ? -1 : 0;
+  return lfs.flashCache.Erase(address, blockSize) ? 0 : -1;
 }
 
 int FS::SectorProg(const struct lfs_config* c, lfs_block_t block, lfs_off_t off, const void* buffer, lfs_size_t size) {
+  Pinetime::Logging::Trace::Scope trace {Pinetime::Logging::Trace::Events::FsProg, static_cast<uint16_t>(size)};
   Pinetime::Controllers::FS& lfs = *(static_cast<Pinetime::Controllers::FS*>(c->context));
   const size_t address = startAddress + (block * blockSize) + off;
-  lfs.flashDriver.Write(address, (uint8_t*) buffer, size);
-  return lfs.flashDriver.ProgramFailed() ? -1 : 0;
+  // A failed program makes littlefs relocate the block
+  return lfs.flashCache.Write(address, static_cast<const uint8_t*>(buffer), size) ? 0 : LFS_ERR_CORRUPT;
 }
 
 int FS::SectorRead(const struct lfs_config* c, lfs_block_t block, lfs_off_t off, void* buffer, lfs_size_t size) {
+  Pinetime::Logging::Trace::Scope trace {Pinetime::Logging::Trace::Events::FsRead, static_cast<uint16_t>(size)};
   Pinetime::Controllers::FS& lfs = *(static_cast<Pinetime::Controllers::FS*>(c->context));
   const size_t address = startAddress + (block * blockSize) + off;
-  lfs.flashDriver.Read(address, static_cast<uint8_t*>(buffer), size);
+  lfs.flashCache.Read(address, static_cast<uint8_t*>(buffer), size);
   return 0;
 }
 
@@ -167,15 +202,41 @@ namespace {
   lv_fs_res_t lvglRead(lv_fs_drv_t* drv, void* file_p, void* buf, uint32_t btr, uint32_t* br) {
     FS* filesys = static_cast<FS*>(drv->user_data);
     lfs_file_t* file = static_cast<lfs_file_t*>(file_p);
-    filesys->FileRead(file, static_cast<uint8_t*>(buf), btr);
-    *br = btr;
+    int res = filesys->FileRead(file, static_cast<uint8_t*>(buf), btr);
+    if (res < 0) {
+      *br = 0;
+      return LV_FS_RES_FS_ERR;
+    }
+    *br = res;
     return LV_FS_RES_OK;
   }
 
   lv_fs_res_t lvglSeek(lv_fs_drv_t* drv, void* file_p, uint32_t pos) {
     FS* filesys = static_cast<FS*>(drv->user_data);
     lfs_file_t* file = static_cast<lfs_file_t*>(file_p);
-    filesys->FileSeek(file, pos);
+    int res = filesys->FileSeek(file, pos);
+    return (res < 0) ? LV_FS_RES_FS_ERR : LV_FS_RES_OK;
+  }
+
+  lv_fs_res_t lvglTell(lv_fs_drv_t* drv, void* file_p, uint32_t* pos_p) {
+    FS* filesys = static_cast<FS*>(drv->user_data);
+    lfs_file_t* file = static_cast<lfs_file_t*>(file_p);
+    int res = filesys->FileTell(file);
+    if (res < 0) {
+      return LV_FS_RES_FS_ERR;
+    }
+    *pos_p = res;
+    return LV_FS_RES_OK;
+  }
+
+  lv_fs_res_t lvglSize(lv_fs_drv_t* drv, void* file_p, uint32_t* size_p) {
+    FS* filesys = static_cast<FS*>(drv->user_data);
+    lfs_file_t* file = static_cast<lfs_file_t*>(file_p);
+    int res = filesys->FileSize(file);
+    if (res < 0) {
+      return LV_FS_RES_FS_ERR;
+    }
+    *size_p = res;
     return LV_FS_RES_OK;
   }
 }
@@ -191,6 +252,8 @@ void FS::LVGLFileSystemInit() {
   fs_drv.close_cb = lvglClose;
   fs_drv.read_cb = lvglRead;
   fs_drv.seek_cb = lvglSeek;
+  fs_drv.tell_cb = lvglTell;
+  fs_drv.size_cb = lvglSize;
 
   fs_drv.user_data = this;
 
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <cstdint>
+#include <FreeRTOS.h>
+#include <semphr.h>
 #include "drivers/SpiNorFlash.h"
+#include "components/fs/FlashCache.h"
 #include <littlefs/lfs.h>
 
 namespace Pinetime {
@@ -18,6 +21,8 @@ namespace Pinetime {
       int FileRead(lfs_file_t* file_p, uint8_t* buff, uint32_t size);
       int FileWrite(lfs_file_t* file_p, const uint8_t* buff, uint32_t size);
       int FileSeek(lfs_file_t* file_p, uint32_t pos);
+      int FileTell(lfs_file_t* file_p);
+      int FileSize(lfs_file_t* file_p);
 
       int FileDelete(const char* fileName);
 
@@ -39,8 +44,13 @@ namespace Pinetime {
         return blockSize;
       }
 
+      const FlashCache::Statistics& GetCacheStatistics() const {
+        return flashCache.GetStatistics();
+      }
+
     private:
       Pinetime::Drivers::SpiNorFlash& flashDriver;
+      FlashCache flashCache;
 
       /*
        * External Flash MAP (4 MBytes)
@@ -73,6 +83,10 @@ namespace Pinetime {
 
       lfs_t lfs;
 
+      // The filesystem is used by SystemTask (settings), DisplayApp (LVGL files) and the BLE host task (FS service) :
+      // littlefs and the flash cache are only accessed with this mutex taken.
+      SemaphoreHandle_t mutex = nullptr;
+
       static int SectorSync(const struct lfs_config* c);
       static int SectorErase(const struct lfs_config* c, lfs_block_t block);
       static int SectorProg(const struct lfs_config* c, lfs_block_t block, lfs_off_t off, const void* buffer, lfs_size_t size);
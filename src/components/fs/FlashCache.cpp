@@ -0,0 +1,168 @@
+#include "components/fs/FlashCache.h"
+#include <algorithm>
+#include <cstring>
+#include "drivers/SpiNorFlash.h"
+
+using namespace Pinetime::Controllers;
+
+FlashCache::FlashCache(Pinetime::Drivers::SpiNorFlash& flashDriver) : flashDriver {flashDriver} {
+}
+
+void FlashCache::Read(uint32_t address, uint8_t* buffer, size_t size) {
+  // Data still in the write buffer must reach the memory before they can be read back
+  if (writeSize > 0 && address < writeAddress + writeSize && address + size > writeAddress) {
+    FlushWriteBuffer();
+  }
+
+  // Big aligned reads (images, fonts,...) would only evict useful lines
+  if ((address % lineSize) == 0 && size >= 2 * lineSize) {
+    size_t directSize = size - (size % lineSize);
+    flashDriver.Read(address, buffer, directSize);
+    statistics.flashReads++;
+    address += directSize;
+    buffer += directSize;
+    size -= directSize;
+  }
+
+  while (size > 0) {
+    uint32_t lineAddress = address - (address % lineSize);
+    size_t offset = address - lineAddress;
+    size_t chunkSize = std::min(size, lineSize - offset);
+    const uint8_t* line = GetLine(lineAddress);
+    std::memcpy(buffer, line + offset, chunkSize);
+    address += chunkSize;
+    buffer += chunkSize;
+    size -= chunkSize;
+  }
+}
+
+bool FlashCache::Write(uint32_t address, const uint8_t* buffer, size_t size) {
+  Invalidate(address, size);
+
+  while (size > 0) {
+    if (writeSize > 0 && address != writeAddress + writeSize) {
+      FlushWriteBuffer();
+    }
+    if (writeSize == 0) {
+      writeAddress = address;
+    }
+
+    // The memory cannot program across a page boundary
+    size_t chunkSize = std::min(size, lineSize - (address % lineSize));
+    std::memcpy(writeBuffer + writeSize, buffer, chunkSize);
+    writeSize += chunkSize;
+    address += chunkSize;
+    buffer += chunkSize;
+    size -= chunkSize;
+
+    if ((address % lineSize) == 0) {
+      FlushWriteBuffer();
+    }
+  }
+
+  // littlefs relocates the block it is programming when the program fails
+  CheckPendingProgram();
+  return ReportProgramStatus();
+}
+
+bool FlashCache::Erase(uint32_t address, size_t size) {
+  FlushWriteBuffer();
+  CheckPendingProgram();
+  Invalidate(address, size);
+  flashDriver.Erase(address, size);
+  return !flashDriver.EraseFailed();
+}
+
+bool FlashCache::Flush() {
+  FlushWriteBuffer();
+  CheckPendingProgram();
+  return ReportProgramStatus();
+}
+
+const uint8_t* FlashCache::GetLine(uint32_t lineAddress) {
+  for (uint8_t i = 0; i < nbLines; i++) {
+    if (lines[i].address == lineAddress) {
+      lines[i].lastUse = ++useCounter;
+      statistics.hits++;
+      return data + (i * lineSize);
+    }
+  }
+
+  statistics.misses++;
+  return data + (Fill(lineAddress) * lineSize);
+}
+
+uint8_t FlashCache::Fill(uint32_t lineAddress) {
+  bool sequential = (lastMissAddress != invalidAddress) && (lineAddress == lastMissAddress + lineSize);
+  uint8_t nbFilled = sequential ? 2 : 1;
+  uint8_t index = LeastRecentlyUsed(nbFilled);
+
+  // The line read ahead might already be cached in another slot
+  Invalidate(lineAddress, nbFilled * lineSize);
+
+  flashDriver.Read(lineAddress, data + (index * lineSize), nbFilled * lineSize);
+  statistics.flashReads++;
+
+  useCounter++;
+  for (uint8_t i = 0; i < nbFilled; i++) {
+    lines[index + i].address = lineAddress + (i * lineSize);
+    lines[index + i].lastUse = useCounter;
+  }
+  lastMissAddress = lineAddress + ((nbFilled - 1) * lineSize);
+  return index;
+}
+
+uint8_t FlashCache::LeastRecentlyUsed(uint8_t nbConsecutiveLines) const {
+  uint8_t index = 0;
+  uint32_t oldest = 0xffffffff;
+  for (uint8_t i = 0; i < nbLines; i += nbConsecutiveLines) {
+    uint32_t lastUse = 0;
+    for (uint8_t j = 0; j < nbConsecutiveLines; j++) {
+      if (lines[i + j].address != invalidAddress) {
+        lastUse = std::max(lastUse, lines[i + j].lastUse);
+      }
+    }
+    if (lastUse < oldest) {
+      oldest = lastUse;
+      index = i;
+    }
+  }
+  return index;
+}
+
+void FlashCache::Invalidate(uint32_t address, size_t size) {
+  for (auto& line : lines) {
+    if (line.address != invalidAddress && address < line.address + lineSize && address + size > line.address) {
+      line.address = invalidAddress;
+    }
+  }
+}
+
+void FlashCache::FlushWriteBuffer() {
+  if (writeSize == 0) {
+    return;
+  }
+
+  // The previous program is checked only now so that it runs while littlefs prepares the next data
+  CheckPendingProgram();
+  flashDriver.Write(writeAddress, writeBuffer, writeSize);
+  statistics.flashWrites++;
+  programPending = true;
+  // The other bytes of the lines might have been cached while these ones were still in the buffer
+  Invalidate(writeAddress, writeSize);
+  writeSize = 0;
+  writeAddress = invalidAddress;
+}
+
+void FlashCache::CheckPendingProgram() {
+  if (programPending) {
+    programFailed |= flashDriver.ProgramFailed();
+    programPending = false;
+  }
+}
+
+bool FlashCache::ReportProgramStatus() {
+  bool success = !programFailed;
+  programFailed = false;
+  return success;
+}
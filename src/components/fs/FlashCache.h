@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Drivers {
+    class SpiNorFlash;
+  }
+  namespace Controllers {
+    /* Small cache between littlefs and the external SPI flash memory.
+     *
+     * Reads are served from lines of one page (LRU replacement). When consecutive lines are missed,
+     * the next line is read ahead in the same SPI transaction. Large aligned reads bypass the cache.
+     * Contiguous writes are merged in a buffer and programmed when they reach the end of the page, when
+     * a non contiguous write is requested or when Flush() is called. Program errors are reported by the
+     * Write() or Flush() call that checks the program.
+     */
+    class FlashCache {
+    public:
+      struct Statistics {
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        uint32_t flashReads = 0;
+        uint32_t flashWrites = 0;
+      };
+
+      explicit FlashCache(Pinetime::Drivers::SpiNorFlash& flashDriver);
+
+      void Read(uint32_t address, uint8_t* buffer, size_t size);
+      bool Write(uint32_t address, const uint8_t* buffer, size_t size);
+      bool Erase(uint32_t address, size_t size);
+      bool Flush();
+
+      const Statistics& GetStatistics() const {
+        return statistics;
+      }
+
+    private:
+      static constexpr size_t lineSize = 256;
+      static constexpr uint8_t nbLines = 4;
+      static constexpr uint32_t invalidAddress = 0xffffffff;
+
+      struct Line {
+        uint32_t address = invalidAddress;
+        uint32_t lastUse = 0;
+      };
+
+      Pinetime::Drivers::SpiNorFlash& flashDriver;
+
+      Line lines[nbLines];
+      uint8_t data[nbLines * lineSize];
+      uint32_t useCounter = 0;
+      uint32_t lastMissAddress = invalidAddress;
+
+      uint8_t writeBuffer[lineSize];
+      uint32_t writeAddress = invalidAddress;
+      size_t writeSize = 0;
+      bool programPending = false;
+      bool programFailed = false;
+
+      Statistics statistics;
+
+      const uint8_t* GetLine(uint32_t lineAddress);
+      uint8_t Fill(uint32_t lineAddress);
+      uint8_t LeastRecentlyUsed(uint8_t nbConsecutiveLines) const;
+      void Invalidate(uint32_t address, size_t size);
+      void FlushWriteBuffer();
+      void CheckPendingProgram();
+      bool ReportProgramStatus();
+    };
+  }
+}
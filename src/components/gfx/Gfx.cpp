@@ -1,5 +1,7 @@
 #include "components/gfx/Gfx.h"
 #include "drivers/St7789.h"
+#include "components/rle/PaletteRleDecoder.h"
+#include <algorithm>
 using namespace Pinetime::Components;
 
 Gfx::Gfx(Pinetime::Drivers::St7789& lcd) : lcd {lcd} {
@@ -17,7 +19,7 @@ void Gfx::ClearScreen() {
   state.action = Action::FillRectangle;
   state.taskToNotify = xTaskGetCurrentTaskHandle();
 
-  lcd.DrawBuffer(0, 0, width, height, reinterpret_cast<const uint8_t*>(buffer), width * 2);
+  SendBuffer(0, 0, width, height, buffer, width * 2);
   WaitTransferFinished();
 }
 
@@ -31,22 +33,26 @@ void Gfx::FillRectangle(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint16_t col
   state.color = color;
   state.taskToNotify = xTaskGetCurrentTaskHandle();
 
-  lcd.DrawBuffer(x, y, w, h, reinterpret_cast<const uint8_t*>(buffer), width * 2);
+  SendBuffer(x, y, w, h, buffer, width * 2);
 
   WaitTransferFinished();
 }
 
-void Gfx::FillRectangle(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t* b) {
-  state.remainingIterations = h;
-  state.currentIteration = 0;
-  state.busy = true;
-  state.action = Action::FillRectangle;
-  state.color = 0x00;
-  state.taskToNotify = xTaskGetCurrentTaskHandle();
-
-  lcd.DrawBuffer(x, y, w, h, reinterpret_cast<const uint8_t*>(b), width * 2);
+void Gfx::FillRectangle(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t* b, size_t size) {
+  Pinetime::Tools::PaletteRleDecoder rleDecoder(b, size);
+  if (!rleDecoder.IsValid()) {
+    return;
+  }
 
-  WaitTransferFinished();
+  // The image is decoded and sent one line at a time
+  for (uint8_t i = 0; i < h; i++) {
+    size_t lineSize = rleDecoder.DecodeNext(reinterpret_cast<uint8_t*>(buffer), w * 2);
+    if (lineSize == 0) {
+      break;
+    }
+    SendBuffer(x, y + i, w, 1, buffer, lineSize);
+    WaitTransferFinished();
+  }
 }
 
 void Gfx::DrawString(uint8_t x, uint8_t y, uint16_t color, const char* text, const FONT_INFO* p_font, bool wrap) {
@@ -55,69 +61,168 @@ void Gfx::DrawString(uint8_t x, uint8_t y, uint16_t color, const char* text, con
     return;
   }
 
-  uint8_t current_x = x;
-  uint8_t current_y = y;
-
-  for (size_t i = 0; text[i] != '\0'; i++) {
-    if (text[i] == '\n') {
-      current_x = x;
-      current_y += p_font->height + p_font->height / 10;
-    } else {
-      DrawChar(p_font, (uint8_t) text[i], &current_x, current_y, color);
-    }
-
-    uint8_t char_idx = text[i] - p_font->startChar;
-    uint16_t char_width = text[i] == ' ' ? (p_font->height / 2) : p_font->charInfo[char_idx].widthBits;
+  // The cache is only cleared between 2 strings so that the glyphs of a line are never evicted while it is drawn
+  if (nbGlyphs == nbCachedGlyphs || glyphRunsSize > (glyphCacheSize * 3) / 4) {
+    nbGlyphs = 0;
+    glyphRunsSize = 0;
+  }
 
-    if (current_x > (width - char_width)) {
-      if (wrap) {
-        current_x = x;
-        current_y += p_font->height + p_font->height / 10;
-      } else {
+  uint8_t current_y = y;
+  size_t lineStart = 0;
+  uint16_t lineWidth = 0;
+  for (size_t i = 0;; i++) {
+    bool endOfLine = (text[i] == '\0' || text[i] == '\n');
+    uint8_t charWidth = endOfLine ? 0 : CharWidth(p_font, text[i]);
+    bool lineFull = !endOfLine && (lineWidth + charWidth > width - x);
+    if (endOfLine || lineFull) {
+      DrawLine(x, current_y, color, text + lineStart, i - lineStart, p_font);
+      if (text[i] == '\0' || (lineFull && (!wrap || lineWidth == 0))) {
         break;
       }
-
-      if (y > (height - p_font->height)) {
+      current_y += p_font->height + p_font->height / 10;
+      if (current_y > (height - p_font->height)) {
         break;
       }
+      lineStart = endOfLine ? i + 1 : i;
+      lineWidth = endOfLine ? 0 : charWidth;
+    } else {
+      lineWidth += charWidth;
     }
   }
+  WaitTransferFinished();
 }
 
 void Gfx::DrawChar(const FONT_INFO* font, uint8_t c, uint8_t* x, uint8_t y, uint16_t color) {
-  uint8_t char_idx = c - font->startChar;
-  uint16_t bytes_in_line = CEIL_DIV(font->charInfo[char_idx].widthBits, 8);
-  uint16_t bg = 0x0000;
+  uint8_t charWidth = CharWidth(font, c);
+  if (charWidth == 0 || *x + charWidth > width || y > (height - font->height)) {
+    return;
+  }
 
+  char text = static_cast<char>(c);
+  DrawLine(*x, y, color, &text, 1, font);
+  WaitTransferFinished();
+
+  *x += charWidth;
+}
+
+uint8_t Gfx::CharWidth(const FONT_INFO* font, uint8_t c) const {
   if (c == ' ') {
-    *x += font->height / 2;
-    return;
+    return font->height / 2;
+  }
+  if (c < font->startChar || c > font->endChar) {
+    return 0;
   }
+  return font->charInfo[c - font->startChar].widthBits + font->spacePixels;
+}
 
-  // Build first line
-  for (uint16_t j = 0; j < bytes_in_line; j++) {
-    for (uint8_t k = 0; k < 8; k++) {
-      if ((1 << (7 - k)) & font->data[font->charInfo[char_idx].offset + j]) {
-        buffer[(j * 8) + k] = color;
-      } else {
-        buffer[(j * 8) + k] = bg;
+const uint8_t* Gfx::GetGlyph(const FONT_INFO* font, uint8_t c) {
+  for (uint8_t i = 0; i < nbGlyphs; i++) {
+    if (cachedGlyphs[i].font == font && cachedGlyphs[i].character == c) {
+      return glyphRuns + cachedGlyphs[i].offset;
+    }
+  }
+  if (nbGlyphs == nbCachedGlyphs) {
+    return nullptr;
+  }
+
+  const FONT_CHAR_INFO& info = font->charInfo[c - font->startChar];
+  const uint8_t* bitmap = font->data + info.offset;
+  uint16_t bytesPerRow = CEIL_DIV(info.widthBits, 8);
+  uint16_t size = glyphRunsSize;
+  for (uint8_t row = 0; row < font->height; row++) {
+    bool foreground = false;
+    uint8_t run = 0;
+    for (uint8_t px = 0; px < info.widthBits; px++) {
+      bool set = (bitmap[(row * bytesPerRow) + (px / 8)] & (0x80 >> (px % 8))) != 0;
+      if (set != foreground) {
+        if (size == glyphCacheSize) {
+          return nullptr;
+        }
+        glyphRuns[size++] = run;
+        run = 0;
+        foreground = set;
       }
+      run++;
     }
+    if (size == glyphCacheSize) {
+      return nullptr;
+    }
+    glyphRuns[size++] = run;
   }
 
-  state.remainingIterations = font->height + 0;
-  state.currentIteration = 0;
-  state.busy = true;
-  state.action = Action::DrawChar;
-  state.font = const_cast<FONT_INFO*>(font);
-  state.character = c;
-  state.color = color;
-  state.taskToNotify = xTaskGetCurrentTaskHandle();
+  cachedGlyphs[nbGlyphs++] = {font, c, glyphRunsSize};
+  const uint8_t* runs = glyphRuns + glyphRunsSize;
+  glyphRunsSize = size;
+  return runs;
+}
 
-  lcd.DrawBuffer(*x, y, bytes_in_line * 8, font->height, reinterpret_cast<const uint8_t*>(&buffer), bytes_in_line * 8 * 2);
-  WaitTransferFinished();
+namespace {
+  struct GlyphCursor {
+    const uint8_t* runs;   // Next runs in the glyph cache, or nullptr if the glyph did not fit in the cache
+    const uint8_t* bitmap; // Used when the glyph is not cached
+    uint8_t width;
+    uint8_t advance;
+  };
+}
+
+void Gfx::DrawLine(uint8_t x, uint8_t y, uint16_t color, const char* text, size_t length, const FONT_INFO* font) {
+  static constexpr uint16_t bg = 0x0000;
+  GlyphCursor glyphs[maxCharsPerLine];
+  uint8_t nbChars = 0;
+  uint16_t lineWidth = 0;
+
+  for (size_t i = 0; i < length && nbChars < maxCharsPerLine; i++) {
+    auto c = static_cast<uint8_t>(text[i]);
+    uint8_t advance = CharWidth(font, c);
+    if (advance == 0) {
+      continue;
+    }
+    GlyphCursor& glyph = glyphs[nbChars++];
+    if (c == ' ') {
+      glyph = {nullptr, nullptr, 0, advance};
+    } else {
+      const FONT_CHAR_INFO& info = font->charInfo[c - font->startChar];
+      glyph = {GetGlyph(font, c), font->data + info.offset, info.widthBits, advance};
+    }
+    lineWidth += advance;
+  }
+  if (lineWidth == 0) {
+    return;
+  }
+
+  for (uint8_t row = 0; row < font->height; row += bandLines) {
+    uint8_t nbRows = std::min<uint8_t>(bandLines, font->height - row);
+    uint16_t* band = buffer + (nextBand * bandLines * width);
+    // The other band may still be sent, but the previous transfer from this one must be finished
+    WaitTransferFinished(1);
+
+    for (uint8_t r = 0; r < nbRows; r++) {
+      uint16_t* pixel = band + (r * lineWidth);
+      for (uint8_t i = 0; i < nbChars; i++) {
+        GlyphCursor& glyph = glyphs[i];
+        if (glyph.runs != nullptr) {
+          uint8_t drawn = 0;
+          bool foreground = false;
+          while (drawn < glyph.width) {
+            uint8_t run = *glyph.runs++;
+            std::fill_n(pixel + drawn, run, foreground ? color : bg);
+            drawn += run;
+            foreground = !foreground;
+          }
+        } else if (glyph.width > 0) {
+          const uint8_t* bits = glyph.bitmap + ((row + r) * CEIL_DIV(glyph.width, 8));
+          for (uint8_t px = 0; px < glyph.width; px++) {
+            pixel[px] = (bits[px / 8] & (0x80 >> (px % 8))) ? color : bg;
+          }
+        }
+        std::fill(pixel + glyph.width, pixel + glyph.advance, bg);
+        pixel += glyph.advance;
+      }
+    }
 
-  *x += font->charInfo[char_idx].widthBits + font->spacePixels;
+    SendBuffer(x, y + row, lineWidth, nbRows, band, lineWidth * nbRows * 2);
+    nextBand ^= 1;
+  }
 }
 
 void Gfx::pixel_draw(uint8_t x, uint8_t y, uint16_t color) {
@@ -151,23 +256,6 @@ bool Gfx::GetNextBuffer(uint8_t** data, size_t& size) {
   if (state.action == Action::FillRectangle) {
     *data = reinterpret_cast<uint8_t*>(buffer);
     size = width * 2;
-  } else if (state.action == Action::DrawChar) {
-    uint16_t bg = 0x0000;
-    uint8_t char_idx = state.character - state.font->startChar;
-    uint16_t bytes_in_line = CEIL_DIV(state.font->charInfo[char_idx].widthBits, 8);
-
-    for (uint16_t j = 0; j < bytes_in_line; j++) {
-      for (uint8_t k = 0; k < 8; k++) {
-        if ((1 << (7 - k)) & state.font->data[state.font->charInfo[char_idx].offset + ((state.currentIteration + 1) * bytes_in_line) + j]) {
-          buffer[(j * 8) + k] = state.color;
-        } else {
-          buffer[(j * 8) + k] = bg;
-        }
-      }
-    }
-
-    *data = reinterpret_cast<uint8_t*>(buffer);
-    size = bytes_in_line * 8 * 2;
   }
 
   state.currentIteration++;
@@ -183,8 +271,17 @@ void Gfx::NotifyEndOfTransfer(TaskHandle_t task) {
   }
 }
 
-void Gfx::WaitTransferFinished() const {
-  ulTaskNotifyTake(pdTRUE, 500);
+void Gfx::SendBuffer(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint16_t* data, size_t size) {
+  lcd.DrawBuffer(x, y, w, h, reinterpret_cast<const uint8_t*>(data), size);
+  pendingTransfers++;
+}
+
+void Gfx::WaitTransferFinished(uint8_t maxPendingTransfers) {
+  // One notification is taken per transfer: taking them all at once would return before the end of the last one
+  while (pendingTransfers > maxPendingTransfers) {
+    ulTaskNotifyTake(pdFALSE, 500);
+    pendingTransfers--;
+  }
 }
 
 void Gfx::SetScrollArea(uint16_t topFixedLines, uint16_t scrollLines, uint16_t bottomFixedLines) {
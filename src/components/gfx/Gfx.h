@@ -19,7 +19,8 @@ namespace Pinetime {
       void DrawString(uint8_t x, uint8_t y, uint16_t color, const char* text, const FONT_INFO* p_font, bool wrap);
       void DrawChar(const FONT_INFO* font, uint8_t c, uint8_t* x, uint8_t y, uint16_t color);
       void FillRectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint16_t color);
-      void FillRectangle(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t* b);
+      // Draws an image encoded with tools/palette_rle_encode.py
+      void FillRectangle(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t* b, size_t size);
       void SetScrollArea(uint16_t topFixedLines, uint16_t scrollLines, uint16_t bottomFixedLines);
       void SetScrollStartLine(uint16_t line);
 
@@ -32,7 +33,21 @@ namespace Pinetime {
       static constexpr uint8_t width = 240;
       static constexpr uint8_t height = 240;
 
-      enum class Action { None, FillRectangle, DrawChar };
+      // Text is rasterized in bands of bandLines lines: the next band is rasterized while the previous one is sent.
+      // Gfx is only used by the recovery firmware and the recovery loader, the buffer (3.75KB) does not cost RAM to the main firmware.
+      static constexpr uint8_t bandLines = 4;
+      static constexpr uint8_t maxCharsPerLine = 40;
+      static constexpr uint8_t nbCachedGlyphs = 32;
+      static constexpr uint16_t glyphCacheSize = 1536;
+
+      // Glyphs are cached as runs of pixels, alternately background and foreground, starting with the background
+      struct CachedGlyph {
+        const FONT_INFO* font = nullptr;
+        uint8_t character = 0;
+        uint16_t offset = 0;
+      };
+
+      enum class Action { None, FillRectangle };
       struct State {
         State() : busy {false}, action {Action::None}, remainingIterations {0}, currentIteration {0} {
         }
@@ -40,19 +55,29 @@ namespace Pinetime {
         volatile Action action;
         volatile uint16_t remainingIterations;
         volatile uint16_t currentIteration;
-        volatile FONT_INFO* font;
         volatile uint16_t color;
-        volatile uint8_t character;
         volatile TaskHandle_t taskToNotify = nullptr;
       };
 
       volatile State state;
 
-      uint16_t buffer[width]; // 1 line buffer
+      uint16_t buffer[2 * bandLines * width]; // 2 bands of text, the first line is also used to fill rectangles
+      uint8_t nextBand = 0;
+      // Each transfer started by SendBuffer() notifies the task once it is finished
+      uint8_t pendingTransfers = 0;
       Drivers::St7789& lcd;
 
+      CachedGlyph cachedGlyphs[nbCachedGlyphs];
+      uint8_t nbGlyphs = 0;
+      uint8_t glyphRuns[glyphCacheSize];
+      uint16_t glyphRunsSize = 0;
+
+      uint8_t CharWidth(const FONT_INFO* font, uint8_t c) const;
+      const uint8_t* GetGlyph(const FONT_INFO* font, uint8_t c);
+      void DrawLine(uint8_t x, uint8_t y, uint16_t color, const char* text, size_t length, const FONT_INFO* font);
       void SetBackgroundColor(uint16_t color);
-      void WaitTransferFinished() const;
+      void SendBuffer(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint16_t* data, size_t size);
+      void WaitTransferFinished(uint8_t maxPendingTransfers = 0);
       void NotifyEndOfTransfer(TaskHandle_t task);
     };
   }
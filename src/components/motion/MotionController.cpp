@@ -1,19 +1,25 @@
 #include "components/motion/MotionController.h"
-#include "os/os_cputime.h"
+#include <cstdlib>
 using namespace Pinetime::Controllers;
 
-void MotionController::Update(int16_t x, int16_t y, int16_t z, uint32_t nbSteps) {
+void MotionController::Update(const Sample* samples, uint8_t nbSamples, uint32_t nbSteps) {
+  this->samples = samples;
+  this->nbSamples = nbSamples;
+
   if (this->nbSteps != nbSteps && service != nullptr) {
     service->OnNewStepCountValue(nbSteps);
   }
 
-  if (service != nullptr && (this->x != x || this->y != y || this->z != z)) {
-    service->OnNewMotionValues(x, y, z);
-  }
+  if (nbSamples > 0) {
+    const Sample& last = samples[nbSamples - 1];
+    if (service != nullptr && (this->x != last.x || this->y != last.y || this->z != last.z)) {
+      service->OnNewMotionValues(last.x, last.y, last.z);
+    }
 
-  this->x = x;
-  this->y = y;
-  this->z = z;
+    this->x = last.x;
+    this->y = last.y;
+    this->z = last.z;
+  }
   int32_t deltaSteps = nbSteps - this->nbSteps;
   this->nbSteps = nbSteps;
   if (deltaSteps > 0) {
@@ -22,9 +28,17 @@ void MotionController::Update(int16_t x, int16_t y, int16_t z, uint32_t nbSteps)
 }
 
 bool MotionController::Should_RaiseWake(bool isSleeping) {
-  if ((x + 335) <= 670 && z < 0) {
+  bool wake = false;
+  for (uint8_t i = 0; i < nbSamples; i++) {
+    wake |= RaiseWake(samples[i], isSleeping);
+  }
+  return wake;
+}
+
+bool MotionController::RaiseWake(const Sample& sample, bool isSleeping) {
+  if ((sample.x + 335) <= 670 && sample.z < 0) {
     if (not isSleeping) {
-      if (y <= 0) {
+      if (sample.y <= 0) {
         return false;
       } else {
         lastYForWakeUp = 0;
@@ -32,12 +46,12 @@ bool MotionController::Should_RaiseWake(bool isSleeping) {
       }
     }
 
-    if (y >= 0) {
+    if (sample.y >= 0) {
       lastYForWakeUp = 0;
       return false;
     }
-    if (y + 230 < lastYForWakeUp) {
-      lastYForWakeUp = y;
+    if (sample.y + 230 < lastYForWakeUp) {
+      lastYForWakeUp = sample.y;
       return true;
     }
   }
@@ -46,22 +60,29 @@ bool MotionController::Should_RaiseWake(bool isSleeping) {
 
 bool MotionController::Should_ShakeWake(uint16_t thresh) {
   bool wake = false;
-  auto diff = xTaskGetTickCount() - lastShakeTime;
-  lastShakeTime = xTaskGetTickCount();
-  /* Currently Polling at 10hz, If this ever goes faster scalar and EMA might need adjusting */
-  int32_t speed = std::abs(z + (y / 2) + (x / 4) - lastYForShake - lastZForShake) / diff * 100;
-  //(.2 * speed) + ((1 - .2) * accumulatedspeed);
-  // implemented without floats as .25Alpha
-  accumulatedspeed = (speed / 5) + ((accumulatedspeed / 5) * 4);
+  for (uint8_t i = 0; i < nbSamples; i++) {
+    wake |= ShakeWake(samples[i], thresh);
+  }
+  return wake;
+}
+
+bool MotionController::ShakeWake(const Sample& sample, uint16_t thresh) {
+  bool wake = false;
+  // Speed per 100ms, the unit of the threshold, computed from the difference between 2 consecutive samples
+  int32_t speed =
+    std::abs(sample.z + (sample.y / 2) + (sample.x / 4) - lastYForShake - lastZForShake) * Pinetime::Drivers::Bma421::sampleRate / 10;
+  // implemented without floats
+  accumulatedspeed = (speed + accumulatedspeed * (shakeSmoothing - 1)) / shakeSmoothing;
 
   if (accumulatedspeed > thresh) {
     wake = true;
   }
-  lastXForShake = x / 4;
-  lastYForShake = y / 2;
-  lastZForShake = z;
+  lastXForShake = sample.x / 4;
+  lastYForShake = sample.y / 2;
+  lastZForShake = sample.z;
   return wake;
 }
+
 int32_t MotionController::currentShakeSpeed() {
   return accumulatedspeed;
 }
@@ -14,7 +14,11 @@ namespace Pinetime {
         BMA425,
       };
 
-      void Update(int16_t x, int16_t y, int16_t z, uint32_t nbSteps);
+      using Sample = Pinetime::Drivers::Bma421::Sample;
+
+      /// Takes a batch of samples (oldest first) read at Bma421::sampleRate. Should_RaiseWake() and Should_ShakeWake()
+      /// run over every sample of the last batch, so the samples must stay valid until the next call.
+      void Update(const Sample* samples, uint8_t nbSamples, uint32_t nbSteps);
 
       int16_t X() const {
         return x;
@@ -52,11 +56,16 @@ namespace Pinetime {
       void SetService(Pinetime::Controllers::MotionService* service);
 
     private:
-      uint32_t nbSteps;
+      bool RaiseWake(const Sample& sample, bool isSleeping);
+      bool ShakeWake(const Sample& sample, uint16_t thresh);
+
+      const Sample* samples = nullptr;
+      uint8_t nbSamples = 0;
+      uint32_t nbSteps = 0;
       uint32_t currentTripSteps = 0;
-      int16_t x;
-      int16_t y;
-      int16_t z;
+      int16_t x = 0;
+      int16_t y = 0;
+      int16_t z = 0;
       int16_t lastYForWakeUp = 0;
       bool isSensorOk = false;
       DeviceTypes deviceType = DeviceTypes::Unknown;
@@ -66,7 +75,8 @@ namespace Pinetime {
       int16_t lastYForShake = 0;
       int16_t lastZForShake = 0;
       int32_t accumulatedspeed = 0;
-      uint32_t lastShakeTime = 0;
+      // Weight of the speed history in the moving average, equivalent to the .2 alpha once used at 10Hz
+      static constexpr int32_t shakeSmoothing = 45;
     };
   }
 }
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "components/rle/PaletteRleDecoder.h"
+#include <algorithm>
+
+using namespace Pinetime::Tools;
+
+PaletteRleDecoder::PaletteRleDecoder(const uint8_t* buffer, size_t size) : buffer {buffer}, size {size} {
+  if (size < 2) {
+    return;
+  }
+  bitsPerIndex = buffer[0];
+  nbColors = buffer[1] + 1;
+  palette = buffer + 2;
+  encodedBufferIndex = 2 + (nbColors * 2);
+  valid = (bitsPerIndex == 2 || bitsPerIndex == 4 || bitsPerIndex == 8) && encodedBufferIndex <= size;
+}
+
+void PaletteRleDecoder::ReplaceColor(uint16_t original, uint16_t replacement) {
+  originalColor = original;
+  replacementColor = replacement;
+  colorReplaced = true;
+}
+
+size_t PaletteRleDecoder::DecodeNext(uint8_t* output, size_t maxBytes) {
+  size_t nbBytes = 0;
+  while (valid && nbBytes + 2 <= maxBytes) {
+    if (remaining == 0 && !NextRun()) {
+      break;
+    }
+
+    size_t nbPixels = std::min<size_t>(remaining, (maxBytes - nbBytes) / 2);
+    uint8_t msb = color >> 8;
+    uint8_t lsb = color & 0xff;
+    for (size_t i = 0; i < nbPixels; i++) {
+      output[nbBytes++] = msb;
+      output[nbBytes++] = lsb;
+    }
+    remaining -= nbPixels;
+  }
+  return nbBytes;
+}
+
+bool PaletteRleDecoder::NextRun() {
+  uint8_t index;
+  if (bitsPerIndex == 8) {
+    if (encodedBufferIndex + 2 > size) {
+      return false;
+    }
+    remaining = buffer[encodedBufferIndex] + 1;
+    index = buffer[encodedBufferIndex + 1];
+    encodedBufferIndex += 2;
+  } else {
+    if (encodedBufferIndex >= size) {
+      return false;
+    }
+    uint8_t run = buffer[encodedBufferIndex++];
+    remaining = (run >> bitsPerIndex) + 1;
+    index = run & ((1 << bitsPerIndex) - 1);
+  }
+
+  if (index >= nbColors) {
+    valid = false;
+    return false;
+  }
+  color = (palette[index * 2] << 8) | palette[(index * 2) + 1];
+  if (colorReplaced && color == originalColor) {
+    color = replacementColor;
+  }
+  return true;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace Pinetime {
+  namespace Tools {
+    /* Palette RLE decoder. Provide the encoded buffer to the constructor and then call DecodeNext() by
+     * specifying the output (decoded) buffer and the maximum number of bytes this buffer can handle.
+     * The pixels are written in RGB565, MSB first (the format of the display).
+     *
+     * Encoded format (generated by tools/palette_rle_encode.py) :
+     *  - bits per index (2, 4 or 8)
+     *  - number of colors - 1
+     *  - palette : RGB565 colors, MSB first
+     *  - runs : with 2 and 4 bits indices, 1 byte per run : ((length - 1) << bitsPerIndex) | index
+     *           with 8 bits indices, 2 bytes per run : (length - 1), index
+     */
+    class PaletteRleDecoder {
+    public:
+      PaletteRleDecoder(const uint8_t* buffer, size_t size);
+
+      bool IsValid() const {
+        return valid;
+      }
+      // Draws the given color instead of one of the colors of the palette
+      void ReplaceColor(uint16_t original, uint16_t replacement);
+      // Returns the number of bytes written in output
+      size_t DecodeNext(uint8_t* output, size_t maxBytes);
+
+    private:
+      const uint8_t* buffer;
+      size_t size;
+      bool valid = false;
+
+      uint8_t bitsPerIndex = 0;
+      uint16_t nbColors = 0;
+      const uint8_t* palette = nullptr;
+      size_t encodedBufferIndex = 0;
+
+      uint16_t originalColor = 0;
+      uint16_t replacementColor = 0;
+      bool colorReplaced = false;
+
+      uint16_t color = 0;
+      uint16_t remaining = 0;
+
+      bool NextRun();
+    };
+  }
+}
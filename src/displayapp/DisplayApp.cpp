@@ -1,4 +1,5 @@
 #include "displayapp/DisplayApp.h"
+#include <hal/nrf_rtc.h>
 #include <libraries/log/nrf_log.h>
 #include "displayapp/screens/HeartRate.h"
 #include "displayapp/screens/Motion.h"
@@ -139,9 +140,6 @@ void DisplayApp::Process(void* instance) {
   NRF_LOG_INFO("displayapp task started!");
   app->InitHw();
 
-  // Send a dummy notification to unlock the lvgl display driver for the first iteration
-  xTaskNotifyGive(xTaskGetCurrentTaskHandle());
-
   while (true) {
     app->Refresh();
   }
@@ -162,6 +160,8 @@ void DisplayApp::Refresh() {
       if (!currentScreen->IsRunning()) {
         LoadApp(returnToApp, returnDirection);
       }
+      // The system task only updates the time when it wakes up
+      dateTimeController.UpdateTime(nrf_rtc_counter_get(portNRF_RTC_REG));
       queueTimeout = lv_task_handler();
       break;
     default:
@@ -444,7 +444,7 @@ void DisplayApp::LoadApp(Apps app, DisplayApp::FullRefreshDirections direction)
       break;
     case Apps::SysInfo:
       currentScreen = std::make_unique<Screens::SystemInfo>(
-        this, dateTimeController, batteryController, brightnessController, bleController, watchdog, motionController, touchPanel);
+        this, dateTimeController, batteryController, brightnessController, bleController, watchdog, motionController, touchPanel, lvgl);
       ReturnApp(Apps::Settings, FullRefreshDirections::Down, TouchEvents::SwipeDown);
       break;
     case Apps::FlashLight:
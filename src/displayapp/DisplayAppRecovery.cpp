@@ -2,7 +2,7 @@
 #include <FreeRTOS.h>
 #include <task.h>
 #include <libraries/log/nrf_log.h>
-#include "components/rle/RleDecoder.h"
+#include "components/rle/PaletteRleDecoder.h"
 #include "touchhandler/TouchHandler.h"
 #include "displayapp/icons/infinitime/infinitime-nb.c"
 #include "components/ble/BleController.h"
@@ -92,10 +92,12 @@ void DisplayApp::Refresh() {
 }
 
 void DisplayApp::DisplayLogo(uint16_t color) {
-  Pinetime::Tools::RleDecoder rleDecoder(infinitime_nb, sizeof(infinitime_nb), color, colorBlack);
+  Pinetime::Tools::PaletteRleDecoder rleDecoder(infinitime_nb, sizeof(infinitime_nb));
+  rleDecoder.ReplaceColor(colorWhite, color);
   for (int i = 0; i < displayWidth; i++) {
-    rleDecoder.DecodeNext(displayBuffer, displayWidth * bytesPerPixel);
+    // Wait for the previous line to be sent before overwriting the buffer
     ulTaskNotifyTake(pdTRUE, 500);
+    rleDecoder.DecodeNext(displayBuffer, displayWidth * bytesPerPixel);
     lcd.DrawBuffer(0, i, displayWidth, 1, reinterpret_cast<const uint8_t*>(displayBuffer), displayWidth * bytesPerPixel);
   }
 }
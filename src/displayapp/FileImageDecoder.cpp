@@ -0,0 +1,278 @@
+#include "displayapp/FileImageDecoder.h"
+#include <algorithm>
+#include <iterator>
+
+using namespace Pinetime::Components;
+
+namespace {
+  lv_res_t decoder_info(lv_img_decoder_t* decoder, const void* src, lv_img_header_t* header) {
+    auto* imageDecoder = static_cast<FileImageDecoder*>(decoder->user_data);
+    return imageDecoder->GetInfo(src, header);
+  }
+
+  lv_res_t decoder_open(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc) {
+    auto* imageDecoder = static_cast<FileImageDecoder*>(decoder->user_data);
+    return imageDecoder->Open(dsc);
+  }
+
+  lv_res_t decoder_read_line(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t* buf) {
+    auto* imageDecoder = static_cast<FileImageDecoder*>(decoder->user_data);
+    return imageDecoder->ReadLine(dsc, x, y, len, buf);
+  }
+
+  void decoder_close(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc) {
+    auto* imageDecoder = static_cast<FileImageDecoder*>(decoder->user_data);
+    imageDecoder->Close(dsc);
+  }
+}
+
+void FileImageDecoder::Register() {
+  lv_img_decoder_t* decoder = lv_img_decoder_create();
+  decoder->user_data = this;
+  lv_img_decoder_set_info_cb(decoder, decoder_info);
+  lv_img_decoder_set_open_cb(decoder, decoder_open);
+  lv_img_decoder_set_read_line_cb(decoder, decoder_read_line);
+  lv_img_decoder_set_close_cb(decoder, decoder_close);
+}
+
+bool FileImageDecoder::ReadHeader(lv_fs_file_t* file, lv_img_header_t* header) {
+  uint32_t br = 0;
+  lv_fs_res_t res = lv_fs_read(file, header, sizeof(lv_img_header_t), &br);
+  return res == LV_FS_RES_OK && br == sizeof(lv_img_header_t) && header->cf == LV_IMG_CF_USER_ENCODED_0;
+}
+
+lv_res_t FileImageDecoder::GetInfo(const void* src, lv_img_header_t* header) {
+  if (lv_img_src_get_type(src) != LV_IMG_SRC_FILE) {
+    return LV_RES_INV;
+  }
+
+  lv_fs_file_t file;
+  if (lv_fs_open(&file, static_cast<const char*>(src), LV_FS_MODE_RD) != LV_FS_RES_OK) {
+    return LV_RES_INV;
+  }
+  bool valid = ReadHeader(&file, header);
+  lv_fs_close(&file);
+  if (!valid) {
+    return LV_RES_INV;
+  }
+
+  // The decoded lines are in the display format
+  header->cf = LV_IMG_CF_TRUE_COLOR;
+  return LV_RES_OK;
+}
+
+lv_res_t FileImageDecoder::Open(lv_img_decoder_dsc_t* dsc) {
+  if (dsc->src_type != LV_IMG_SRC_FILE || dsc->header.w == 0 || dsc->header.h == 0) {
+    return LV_RES_INV;
+  }
+
+  auto image = std::find_if(std::begin(images), std::end(images), [](const Image& i) {
+    return !i.used;
+  });
+  if (image == std::end(images)) {
+    return LV_RES_INV;
+  }
+
+  *image = Image {};
+  image->used = true;
+  image->path = static_cast<const char*>(dsc->src);
+  image->width = dsc->header.w;
+  image->height = dsc->header.h;
+  uint32_t rowsPerCheckpoint = (image->height + maxCheckpoints - 1) / maxCheckpoints;
+  image->checkpointInterval = std::max<uint32_t>(rowsPerCheckpoint, 1) * image->width;
+
+  // Also loads the palette and sets dataOffset
+  if (AcquireFile(*image) == nullptr) {
+    image->used = false;
+    return LV_RES_INV;
+  }
+  image->fileOffset = image->dataOffset;
+
+  dsc->img_data = nullptr;
+  dsc->user_data = &(*image);
+  return LV_RES_OK;
+}
+
+lv_res_t FileImageDecoder::ReadLine(lv_img_decoder_dsc_t* dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t* buf) {
+  auto* image = static_cast<Image*>(dsc->user_data);
+  if (image == nullptr || x < 0 || y < 0 || x + len > image->width || y >= image->height) {
+    return LV_RES_INV;
+  }
+
+  OpenFile* openFile = AcquireFile(*image);
+  if (openFile == nullptr || !MoveTo(*image, (y * image->width) + x)) {
+    return LV_RES_INV;
+  }
+
+  auto* output = reinterpret_cast<lv_color_t*>(buf);
+  lv_coord_t count = 0;
+  while (count < len) {
+    if (image->remaining == 0 && !ReadRun(*image)) {
+      return LV_RES_INV;
+    }
+    uint16_t nbPixels = std::min<uint16_t>(image->remaining, len - count);
+    std::fill_n(output + count, nbPixels, openFile->palette[image->colorIndex]);
+    count += nbPixels;
+    image->remaining -= nbPixels;
+    image->position += nbPixels;
+  }
+  return LV_RES_OK;
+}
+
+void FileImageDecoder::Close(lv_img_decoder_dsc_t* dsc) {
+  auto* image = static_cast<Image*>(dsc->user_data);
+  if (image == nullptr) {
+    return;
+  }
+  if (image->file != nullptr) {
+    ReleaseFile(*image->file);
+  }
+  image->used = false;
+  dsc->user_data = nullptr;
+}
+
+FileImageDecoder::OpenFile* FileImageDecoder::AcquireFile(Image& image) {
+  useCounter++;
+  if (image.file != nullptr) {
+    image.file->lastUse = useCounter;
+    return image.file;
+  }
+
+  // Take the file that was not used for the longest time
+  auto openFile = std::min_element(std::begin(openFiles), std::end(openFiles), [](const OpenFile& a, const OpenFile& b) {
+    return a.lastUse < b.lastUse;
+  });
+  if (openFile->image != nullptr) {
+    ReleaseFile(*openFile);
+  }
+
+  if (lv_fs_open(&openFile->file, image.path, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+    return nullptr;
+  }
+
+  // Bits per index and number of colors - 1, then the palette
+  lv_img_header_t header;
+  uint8_t rleHeader[2];
+  uint32_t br = 0;
+  bool valid = ReadHeader(&openFile->file, &header) &&
+               lv_fs_read(&openFile->file, rleHeader, sizeof(rleHeader), &br) == LV_FS_RES_OK && br == sizeof(rleHeader);
+  if (valid) {
+    openFile->bitsPerIndex = rleHeader[0];
+    openFile->nbColors = rleHeader[1] + 1;
+    // The palette is stored MSB first, which is the layout of lv_color_t with LV_COLOR_16_SWAP
+    uint32_t paletteSize = openFile->nbColors * sizeof(lv_color_t);
+    valid = (openFile->bitsPerIndex == 2 || openFile->bitsPerIndex == 4 || openFile->bitsPerIndex == 8) &&
+            lv_fs_read(&openFile->file, openFile->palette, paletteSize, &br) == LV_FS_RES_OK && br == paletteSize;
+  }
+  if (!valid) {
+    lv_fs_close(&openFile->file);
+    return nullptr;
+  }
+
+  openFile->image = &image;
+  openFile->lastUse = useCounter;
+  openFile->bufferIndex = 0;
+  openFile->bufferSize = 0;
+  image.file = &(*openFile);
+  image.dataOffset = sizeof(lv_img_header_t) + 2 + (openFile->nbColors * sizeof(lv_color_t));
+
+  // The file might have been taken by another image: continue where the decoding stopped
+  if (image.fileOffset != 0 && !SeekFile(image, image.fileOffset)) {
+    ReleaseFile(*openFile);
+    return nullptr;
+  }
+  return image.file;
+}
+
+void FileImageDecoder::ReleaseFile(OpenFile& openFile) {
+  lv_fs_close(&openFile.file);
+  openFile.image->file = nullptr;
+  openFile.image = nullptr;
+  openFile.lastUse = 0;
+}
+
+bool FileImageDecoder::SeekFile(Image& image, uint32_t offset) {
+  image.file->bufferIndex = 0;
+  image.file->bufferSize = 0;
+  image.fileOffset = offset;
+  return lv_fs_seek(&image.file->file, offset) == LV_FS_RES_OK;
+}
+
+bool FileImageDecoder::ReadByte(Image& image, uint8_t& value) {
+  OpenFile& openFile = *image.file;
+  if (openFile.bufferIndex >= openFile.bufferSize) {
+    uint32_t br = 0;
+    if (lv_fs_read(&openFile.file, openFile.buffer, readBufferSize, &br) != LV_FS_RES_OK || br == 0) {
+      return false;
+    }
+    openFile.bufferIndex = 0;
+    openFile.bufferSize = br;
+  }
+  value = openFile.buffer[openFile.bufferIndex++];
+  image.fileOffset++;
+  return true;
+}
+
+bool FileImageDecoder::ReadRun(Image& image) {
+  // With 8 bits indices, a run is (length - 1, index). Otherwise, it is packed in 1 byte : ((length - 1) << bits) | index
+  uint32_t runOffset = image.fileOffset;
+  uint8_t bitsPerIndex = image.file->bitsPerIndex;
+  uint8_t run;
+  uint8_t colorIndex;
+  if (!ReadByte(image, run)) {
+    return false;
+  }
+  if (bitsPerIndex == 8) {
+    if (!ReadByte(image, colorIndex)) {
+      return false;
+    }
+    image.remaining = run + 1;
+  } else {
+    colorIndex = run & ((1U << bitsPerIndex) - 1);
+    image.remaining = (run >> bitsPerIndex) + 1;
+  }
+  if (colorIndex >= image.file->nbColors) {
+    return false;
+  }
+  image.colorIndex = colorIndex;
+  RecordCheckpoint(image, runOffset, image.remaining);
+  return true;
+}
+
+void FileImageDecoder::RecordCheckpoint(Image& image, uint32_t runOffset, uint16_t runLength) {
+  // Only the last checkpoint covered by the run is recorded
+  uint32_t index = (image.position + runLength - 1) / image.checkpointInterval;
+  uint32_t pixel = index * image.checkpointInterval;
+  if (index == 0 || index >= maxCheckpoints || pixel < image.position || (image.validCheckpoints & (1U << index)) != 0) {
+    return;
+  }
+  image.checkpoints[index] = {runOffset, image.position};
+  image.validCheckpoints |= (1U << index);
+}
+
+bool FileImageDecoder::MoveTo(Image& image, uint32_t pixel) {
+  // Find the closest checkpoint before the pixel. The beginning of the data is checkpoint 0.
+  uint32_t index = std::min<uint32_t>(pixel / image.checkpointInterval, maxCheckpoints - 1);
+  while (index > 0 && (image.validCheckpoints & (1U << index)) == 0) {
+    index--;
+  }
+  Checkpoint checkpoint = (index == 0) ? Checkpoint {image.dataOffset, 0} : image.checkpoints[index];
+
+  if (pixel < image.position || checkpoint.pixel > image.position) {
+    if (!SeekFile(image, checkpoint.fileOffset)) {
+      return false;
+    }
+    image.position = checkpoint.pixel;
+    image.remaining = 0;
+  }
+
+  while (image.position < pixel) {
+    if (image.remaining == 0 && !ReadRun(image)) {
+      return false;
+    }
+    uint32_t skipped = std::min<uint32_t>(image.remaining, pixel - image.position);
+    image.remaining -= skipped;
+    image.position += skipped;
+  }
+  return true;
+}
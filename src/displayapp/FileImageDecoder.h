@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <lvgl/lvgl.h>
+
+namespace Pinetime {
+  namespace Components {
+    /* LVGL decoder for the compressed images stored in the filesystem ('F:' drive).
+     *
+     * File format :
+     *  - lv_img_header_t, with cf = LV_IMG_CF_USER_ENCODED_0
+     *  - the image encoded in the palette RLE format of PaletteRleDecoder (see components/rle/PaletteRleDecoder.h),
+     *    the pixels from left to right and from top to bottom.
+     * Use tools/palette_rle_encode.py --file to convert an image. Uncompressed LVGL images are handled by the
+     * built-in decoder.
+     *
+     * The images are decoded line by line, nothing is allocated in the LVGL heap. The decoding state of
+     * maxImages images is kept in a static pool, and at most maxOpenFiles files are opened at the same time.
+     * LVGL keeps the images of its cache open : the pool must be able to hold all of them.
+     * A few checkpoints (offset of the run starting a group of rows) are recorded while decoding so that
+     * going back to a previous line does not restart from the beginning of the file.
+     */
+    class FileImageDecoder {
+    public:
+      void Register();
+
+      lv_res_t GetInfo(const void* src, lv_img_header_t* header);
+      lv_res_t Open(lv_img_decoder_dsc_t* dsc);
+      lv_res_t ReadLine(lv_img_decoder_dsc_t* dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t* buf);
+      void Close(lv_img_decoder_dsc_t* dsc);
+
+    private:
+      static constexpr uint8_t maxImages = 6;
+      static_assert(maxImages >= LV_IMG_CACHE_DEF_SIZE, "The images of the LVGL cache would not be drawn");
+      static constexpr uint8_t maxOpenFiles = 2;
+      static constexpr uint8_t maxCheckpoints = 8;
+      static constexpr uint8_t readBufferSize = 64;
+      static constexpr uint16_t maxColors = 256;
+
+      struct Checkpoint {
+        uint32_t fileOffset;
+        uint32_t pixel;
+      };
+
+      struct OpenFile;
+
+      struct Image {
+        bool used = false;
+        const char* path = nullptr;
+        uint16_t width = 0;
+        uint16_t height = 0;
+        uint32_t dataOffset = 0;
+        uint32_t checkpointInterval = 0; // Pixels between 2 checkpoints
+        Checkpoint checkpoints[maxCheckpoints];
+        uint8_t validCheckpoints = 0; // Bit mask
+
+        // Decoding state
+        uint32_t fileOffset = 0; // Offset of the next run
+        uint32_t position = 0;   // Index of the next pixel
+        uint16_t remaining = 0;  // Pixels left in the current run
+        uint8_t colorIndex = 0;
+
+        OpenFile* file = nullptr;
+      };
+
+      struct OpenFile {
+        Image* image = nullptr;
+        lv_fs_file_t file;
+        uint32_t lastUse = 0;
+        uint8_t bitsPerIndex = 0;
+        uint16_t nbColors = 0;
+        lv_color_t palette[maxColors];
+        uint8_t buffer[readBufferSize];
+        uint8_t bufferIndex = 0;
+        uint8_t bufferSize = 0;
+      };
+
+      bool ReadHeader(lv_fs_file_t* file, lv_img_header_t* header);
+      OpenFile* AcquireFile(Image& image);
+      void ReleaseFile(OpenFile& openFile);
+      bool SeekFile(Image& image, uint32_t offset);
+      bool ReadByte(Image& image, uint8_t& value);
+      bool ReadRun(Image& image);
+      void RecordCheckpoint(Image& image, uint32_t runOffset, uint16_t runLength);
+      bool MoveTo(Image& image, uint32_t pixel);
+
+      Image images[maxImages];
+      OpenFile openFiles[maxOpenFiles];
+      uint32_t useCounter = 0;
+    };
+  }
+}
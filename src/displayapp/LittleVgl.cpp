@@ -3,9 +3,12 @@
 
 #include <FreeRTOS.h>
 #include <task.h>
+#include <hal/nrf_timer.h>
+#include <algorithm>
 //#include <projdefs.h>
 #include "drivers/Cst816s.h"
 #include "drivers/St7789.h"
+#include "logging/Trace.h"
 
 using namespace Pinetime::Components;
 
@@ -16,6 +19,29 @@ static void disp_flush(lv_disp_drv_t* disp_drv, const lv_area_t* area, lv_color_
   lvgl->FlushDisplay(area, color_p);
 }
 
+static void disp_wait(lv_disp_drv_t* disp_drv) {
+  auto* lvgl = static_cast<LittleVgl*>(disp_drv->user_data);
+  lvgl->WaitFlushDone();
+}
+
+static void disp_refresh(lv_task_t* task) {
+  auto* disp = static_cast<lv_disp_t*>(task->user_data);
+  auto* lvgl = static_cast<LittleVgl*>(disp->driver.user_data);
+  lvgl->RefreshDisplay(task);
+}
+
+// TIMER1 measures the frame times. It only runs while LVGL refreshes the display.
+static void frame_timer_init() {
+  nrf_timer_mode_set(NRF_TIMER1, NRF_TIMER_MODE_TIMER);
+  nrf_timer_bit_width_set(NRF_TIMER1, NRF_TIMER_BIT_WIDTH_32);
+  nrf_timer_frequency_set(NRF_TIMER1, NRF_TIMER_FREQ_1MHz);
+}
+
+static uint32_t frame_timer_now() {
+  nrf_timer_task_trigger(NRF_TIMER1, NRF_TIMER_TASK_CAPTURE0);
+  return nrf_timer_cc_read(NRF_TIMER1, NRF_TIMER_CC_CHANNEL0);
+}
+
 bool touchpad_read(lv_indev_drv_t* indev_drv, lv_indev_data_t* data) {
   auto* lvgl = static_cast<LittleVgl*>(indev_drv->user_data);
   return lvgl->GetTouchPadInfo(data);
@@ -31,10 +57,11 @@ void LittleVgl::Init() {
   InitTheme();
   InitDisplay();
   InitTouchpad();
+  imageDecoder.Register();
 }
 
 void LittleVgl::InitDisplay() {
-  lv_disp_buf_init(&disp_buf_2, buf2_1, buf2_2, LV_HOR_RES_MAX * 4); /*Initialize the display buffer*/
+  lv_disp_buf_init(&disp_buf_2, buf2_1, buf2_2, bufferSize); /*Initialize the display buffer*/
   lv_disp_drv_init(&disp_drv);                                       /*Basic initialization*/
 
   /*Set up the functions to access to your display*/
@@ -45,12 +72,40 @@ void LittleVgl::InitDisplay() {
 
   /*Used to copy the buffer's content to the display*/
   disp_drv.flush_cb = disp_flush;
+  /*Called while LVGL waits for the previous buffer to be flushed*/
+  disp_drv.wait_cb = disp_wait;
   /*Set a display buffer*/
   disp_drv.buffer = &disp_buf_2;
   disp_drv.user_data = this;
 
   /*Finally register the driver*/
-  lv_disp_drv_register(&disp_drv);
+  lv_disp_t* disp = lv_disp_drv_register(&disp_drv);
+
+  /*Wrap the refresh task to wait for the last transfer of each frame and measure the frame times*/
+  lv_task_set_cb(disp->refr_task, disp_refresh);
+  frame_timer_init();
+}
+
+void LittleVgl::RefreshDisplay(lv_task_t* task) {
+  nrf_timer_task_trigger(NRF_TIMER1, NRF_TIMER_TASK_CLEAR);
+  nrf_timer_task_trigger(NRF_TIMER1, NRF_TIMER_TASK_START);
+  frameTransferTime = 0;
+  frameWaitTime = 0;
+
+  if (scrollDirection == FullRefreshDirections::None) {
+    MergeInvalidatedAreas(static_cast<lv_disp_t*>(task->user_data));
+  }
+  _lv_disp_refr_task(task);
+
+  if (transferPending) {
+    // LVGL is done with this frame, release the last buffer now rather than when the next frame starts
+    WaitTransferDone();
+    lv_disp_flush_ready(&disp_drv);
+    uint32_t frameTime = frame_timer_now();
+    lastFrameTimes.renderUs = frameTime - frameWaitTime;
+    lastFrameTimes.transferUs = frameTransferTime;
+  }
+  nrf_timer_task_trigger(NRF_TIMER1, NRF_TIMER_TASK_STOP);
 }
 
 void LittleVgl::InitTouchpad() {
@@ -80,12 +135,52 @@ void LittleVgl::SetFullRefresh(FullRefreshDirections direction) {
   }
 }
 
+// LVGL only joins invalidated areas that overlap and when it reduces the number of pixels to redraw.
+// Every flush also costs address window commands and a transfer setup, so small areas close to each
+// other (seconds, battery and BLE icons,...) are cheaper to send as a single area.
+void LittleVgl::MergeInvalidatedAreas(lv_disp_t* disp) {
+  for (uint16_t i = 0; i < disp->inv_p; i++) {
+    if (disp->inv_area_joined[i] != 0) {
+      continue;
+    }
+
+    bool merged;
+    do {
+      merged = false;
+      for (uint16_t j = 0; j < disp->inv_p; j++) {
+        if (i == j || disp->inv_area_joined[j] != 0) {
+          continue;
+        }
+
+        lv_area_t joined;
+        _lv_area_join(&joined, &disp->inv_areas[i], &disp->inv_areas[j]);
+        if (FlushCost(joined) <= FlushCost(disp->inv_areas[i]) + FlushCost(disp->inv_areas[j])) {
+          lv_area_copy(&disp->inv_areas[i], &joined);
+          disp->inv_area_joined[j] = 1;
+          merged = true;
+        }
+      }
+    } while (merged);
+  }
+}
+
+uint32_t LittleVgl::FlushCost(const lv_area_t& area) {
+  uint32_t width = lv_area_get_width(&area);
+  uint32_t height = lv_area_get_height(&area);
+
+  // LVGL renders and flushes the area by stripes of the size of the draw buffer
+  uint32_t linesPerFlush = std::max(bufferSize / width, static_cast<uint32_t>(1));
+  uint32_t nbFlushes = (height + linesPerFlush - 1) / linesPerFlush;
+  return (nbFlushes * flushOverheadBytes) + (width * height * sizeof(lv_color_t));
+}
+
 void LittleVgl::FlushDisplay(const lv_area_t* area, lv_color_t* color_p) {
+  Pinetime::Logging::Trace::Scope trace {Pinetime::Logging::Trace::Events::DisplayFlush,
+                                         static_cast<uint16_t>((area->y2 - area->y1) + 1)};
   uint16_t y1, y2, width, height = 0;
 
-  ulTaskNotifyTake(pdTRUE, 200);
-  // NOtification is still needed (even if there is a mutex on SPI) because of the DataCommand pin
-  // which cannot be set/clear during a transfert.
+  // LVGL calls this function only once the previous buffer has been flushed (see WaitFlushDone()),
+  // so the transfer is done and the DataCommand pin can be set/clear.
 
   if ((scrollDirection == LittleVgl::FullRefreshDirections::Down) && (area->y2 == visibleNbLines - 1)) {
     writeOffset = ((writeOffset + totalNbLines) - visibleNbLines) % totalNbLines;
@@ -149,23 +244,51 @@ void LittleVgl::FlushDisplay(const lv_area_t* area, lv_color_t* color_p) {
     height = totalNbLines - y1;
 
     if (height > 0) {
-      lcd.DrawBuffer(area->x1, y1, width, height, reinterpret_cast<const uint8_t*>(color_p), width * height * 2);
-      ulTaskNotifyTake(pdTRUE, 100);
+      DrawBuffer(area->x1, y1, width, height, color_p);
+      WaitTransferDone();
     }
 
     uint16_t pixOffset = width * height;
     height = y2 + 1;
-    lcd.DrawBuffer(area->x1, 0, width, height, reinterpret_cast<const uint8_t*>(color_p + pixOffset), width * height * 2);
+    DrawBuffer(area->x1, 0, width, height, color_p + pixOffset);
 
   } else {
-    lcd.DrawBuffer(area->x1, y1, width, height, reinterpret_cast<const uint8_t*>(color_p), width * height * 2);
+    DrawBuffer(area->x1, y1, width, height, color_p);
   }
 
+  // The transfer is still running : lv_disp_flush_ready() will be called from WaitFlushDone() once it's done.
+  // Meanwhile, LVGL renders the next part of the screen in the other buffer.
+}
+
+void LittleVgl::WaitFlushDone() {
+  WaitTransferDone();
+
   // IMPORTANT!!!
   // Inform the graphics library that you are ready with the flushing
   lv_disp_flush_ready(&disp_drv);
 }
 
+void LittleVgl::DrawBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const lv_color_t* data) {
+  transferStart = frame_timer_now();
+  transferPending = true;
+  lcd.DrawBuffer(x, y, width, height, reinterpret_cast<const uint8_t*>(data), width * height * 2);
+}
+
+void LittleVgl::WaitTransferDone() {
+  if (!transferPending) {
+    return;
+  }
+
+  // The SPI driver notifies this task at the end of the transfer
+  uint32_t waitStart = frame_timer_now();
+  ulTaskNotifyTake(pdTRUE, 200);
+  uint32_t transferEnd = frame_timer_now();
+
+  frameWaitTime += transferEnd - waitStart;
+  frameTransferTime += transferEnd - transferStart;
+  transferPending = false;
+}
+
 void LittleVgl::SetNewTouchPoint(uint16_t x, uint16_t y, bool contact) {
   tap_x = x;
   tap_y = y;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <lvgl/lvgl.h>
+#include "displayapp/FileImageDecoder.h"
 
 namespace Pinetime {
   namespace Drivers {
@@ -12,6 +13,10 @@ namespace Pinetime {
     class LittleVgl {
     public:
       enum class FullRefreshDirections { None, Up, Down, Left, Right, LeftAnim, RightAnim };
+      struct FrameTimes {
+        uint32_t renderUs = 0;   // Time spent refreshing the last frame, excluding the time spent waiting for the SPI
+        uint32_t transferUs = 0; // Time spent sending the last frame to the display
+      };
       LittleVgl(Pinetime::Drivers::St7789& lcd, Pinetime::Drivers::Cst816S& touchPanel);
 
       LittleVgl(const LittleVgl&) = delete;
@@ -21,26 +26,42 @@ namespace Pinetime {
 
       void Init();
 
+      void RefreshDisplay(lv_task_t* task);
       void FlushDisplay(const lv_area_t* area, lv_color_t* color_p);
+      void WaitFlushDone();
       bool GetTouchPadInfo(lv_indev_data_t* ptr);
       void SetFullRefresh(FullRefreshDirections direction);
       void SetNewTouchPoint(uint16_t x, uint16_t y, bool contact);
 
+      FrameTimes GetLastFrameTimes() const {
+        return lastFrameTimes;
+      }
+
     private:
       void InitDisplay();
       void InitTouchpad();
       void InitTheme();
+      void MergeInvalidatedAreas(lv_disp_t* disp);
+      static uint32_t FlushCost(const lv_area_t& area);
+      void DrawBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const lv_color_t* data);
+      void WaitTransferDone();
 
       Pinetime::Drivers::St7789& lcd;
       Pinetime::Drivers::Cst816S& touchPanel;
 
+      static constexpr uint32_t bufferSize = LV_HOR_RES_MAX * 4;
+      // Estimated cost of a flush (address window commands, transfer setup and completion) in bytes of pixel data
+      static constexpr uint32_t flushOverheadBytes = 128;
+
       lv_disp_buf_t disp_buf_2;
-      lv_color_t buf2_1[LV_HOR_RES_MAX * 4];
-      lv_color_t buf2_2[LV_HOR_RES_MAX * 4];
+      lv_color_t buf2_1[bufferSize];
+      lv_color_t buf2_2[bufferSize];
 
       lv_disp_drv_t disp_drv;
       lv_point_t previousClick;
 
+      FileImageDecoder imageDecoder;
+
       bool firstTouch = true;
       static constexpr uint8_t nbWriteLines = 4;
       static constexpr uint16_t totalNbLines = 320;
@@ -52,6 +73,12 @@ namespace Pinetime {
       uint16_t writeOffset = 0;
       uint16_t scrollOffset = 0;
 
+      bool transferPending = false;
+      uint32_t transferStart = 0;
+      uint32_t frameTransferTime = 0;
+      uint32_t frameWaitTime = 0;
+      FrameTimes lastFrameTimes;
+
       uint16_t tap_x = 0;
       uint16_t tap_y = 0;
       bool tapped = false;
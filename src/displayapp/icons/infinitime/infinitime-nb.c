@@ -1,127 +1,167 @@
 
 #include <unistd.h>
 
-// 1-bit RLE, generated from ./infinitime-nb.png, 1445 bytes
+// 2-bit palette RLE, generated from infinitime-nb.png, 1927 bytes
 static const uint8_t infinitime_nb[] = {
-    0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0,
-    0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0,
-    0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0x66, 0x2, 0xed, 0x4, 0xec, 0x5,
-    0xea, 0x7, 0xe8, 0x9, 0xe6, 0xa, 0xe5, 0xc, 0xe3, 0xe, 0xe1, 0x10,
-    0xdf, 0x12, 0xde, 0x12, 0xdd, 0x14, 0xdb, 0x16, 0xd9, 0x18, 0xd7, 0x1a,
-    0xd5, 0x1b, 0xd4, 0x1d, 0xd3, 0xd, 0x3, 0xe, 0xd1, 0xd, 0x5, 0xe,
-    0xcf, 0xe, 0x5, 0xf, 0xcd, 0xf, 0x5, 0xf, 0xcc, 0x10, 0x5, 0x10,
-    0xca, 0x11, 0x5, 0x11, 0xc8, 0x12, 0x5, 0x12, 0xc6, 0x13, 0x5, 0x13,
-    0xc5, 0x13, 0x5, 0x13, 0xc4, 0x14, 0x5, 0x14, 0xc2, 0x15, 0x5, 0x15,
-    0xc0, 0x17, 0x3, 0x17, 0xbe, 0x33, 0xbc, 0x34, 0xbb, 0x36, 0xba, 0x37,
-    0xb8, 0x39, 0xb6, 0x3b, 0xb4, 0x3c, 0xb3, 0x3e, 0xb1, 0x40, 0xaf, 0x9,
-    0x2, 0x2e, 0x1, 0x8, 0xad, 0x9, 0x4, 0x2c, 0x3, 0x8, 0xac, 0x8,
-    0x6, 0x2a, 0x5, 0x7, 0xab, 0x9, 0x6, 0x29, 0x6, 0x8, 0xa9, 0xb,
-    0x5, 0x29, 0x5, 0xa, 0xa7, 0xd, 0x3, 0x2b, 0x3, 0xc, 0xa5, 0x4c,
-    0xa3, 0x4d, 0xa2, 0x4f, 0xa0, 0x51, 0x9f, 0x52, 0x9d, 0x54, 0x9b, 0x55,
-    0x9a, 0x57, 0x98, 0x59, 0x96, 0x5b, 0x94, 0x5d, 0x93, 0x5d, 0x92, 0x5f,
-    0x90, 0x61, 0x8e, 0x63, 0x8c, 0x65, 0x8a, 0x66, 0x89, 0x68, 0x87, 0x8,
-    0x2, 0x59, 0x2, 0x5, 0x86, 0x7, 0x4, 0x57, 0x4, 0x5, 0x84, 0x8,
-    0x5, 0x55, 0x6, 0x5, 0x82, 0x9, 0x6, 0x54, 0x6, 0x5, 0x81, 0xa,
-    0x5, 0x55, 0x5, 0x7, 0x7f, 0xc, 0x4, 0x56, 0x3, 0x9, 0x7d, 0x74,
-    0x7b, 0x76, 0x79, 0x77, 0x79, 0x78, 0x77, 0x7a, 0x75, 0x7c, 0x73, 0x7e,
-    0x71, 0x7f, 0x70, 0x81, 0x6e, 0x83, 0x6c, 0x85, 0x6b, 0x86, 0x69, 0x87,
-    0x68, 0x89, 0x66, 0x8b, 0x64, 0x8d, 0x62, 0x8f, 0x60, 0x90, 0x60, 0x91,
-    0x5e, 0x93, 0x5c, 0x95, 0x5a, 0xe, 0x7, 0x71, 0x7, 0xa, 0x58, 0xd,
-    0xb, 0x6d, 0xb, 0x8, 0x57, 0xe, 0xc, 0x6c, 0xc, 0x8, 0x55, 0xf,
-    0xc, 0x6c, 0xb, 0xa, 0x53, 0x11, 0xa, 0x6d, 0xb, 0xb, 0x52, 0x9f,
-    0x50, 0xa0, 0x4f, 0xa2, 0x4d, 0xa4, 0x4b, 0xa6, 0x49, 0xa8, 0x48, 0xa8,
-    0xff, 0x0, 0xe3, 0x44, 0xad, 0x43, 0xae, 0x41, 0xb0, 0x40, 0xb1, 0x3e,
-    0xb2, 0x3e, 0xb3, 0x3c, 0xb5, 0x3a, 0xb7, 0x39, 0xb8, 0x37, 0xb9, 0x36,
-    0xbb, 0x35, 0xe, 0x1, 0x66, 0x1, 0x3c, 0x1, 0x9, 0x33, 0xe, 0x3,
-    0x15, 0x5, 0xe, 0x4, 0x16, 0x15, 0xd, 0x3, 0x11, 0x5, 0xe, 0x4,
-    0x12, 0x3, 0x9, 0x31, 0xf, 0x4, 0x14, 0x6, 0xd, 0x4, 0x16, 0x15,
-    0xd, 0x4, 0x10, 0x5, 0xe, 0x4, 0x12, 0x4, 0x9, 0x30, 0xf, 0x4,
-    0x14, 0x6, 0xd, 0x4, 0x16, 0x15, 0xd, 0x4, 0x10, 0x6, 0xd, 0x4,
-    0x12, 0x4, 0x9, 0x2f, 0x10, 0x4, 0x14, 0x7, 0xc, 0x4, 0x16, 0x15,
-    0xd, 0x4, 0x10, 0x6, 0xd, 0x4, 0x12, 0x4, 0xa, 0x2d, 0x11, 0x4,
-    0x14, 0x7, 0xc, 0x4, 0x16, 0x4, 0x1e, 0x4, 0x10, 0x7, 0xc, 0x4,
-    0x12, 0x4, 0xb, 0x2c, 0x11, 0x4, 0x14, 0x8, 0xb, 0x4, 0x16, 0x4,
-    0x1e, 0x4, 0x10, 0x7, 0xc, 0x4, 0x12, 0x4, 0xc, 0x2a, 0x12, 0x4,
-    0x14, 0x8, 0xb, 0x4, 0x16, 0x4, 0x1e, 0x4, 0x10, 0x8, 0xb, 0x4,
-    0x12, 0x4, 0xd, 0x28, 0x13, 0x4, 0x14, 0x4, 0x1, 0x4, 0xa, 0x4,
-    0x16, 0x4, 0x1e, 0x4, 0x10, 0x4, 0x1, 0x3, 0xb, 0x4, 0x12, 0x4,
-    0xd, 0x28, 0x13, 0x4, 0x14, 0x4, 0x1, 0x4, 0xa, 0x4, 0x16, 0x4,
-    0x1e, 0x4, 0x10, 0x4, 0x1, 0x4, 0xa, 0x4, 0x12, 0x4, 0xe, 0x26,
-    0x14, 0x4, 0x14, 0x4, 0x2, 0x4, 0x9, 0x4, 0x16, 0x4, 0x1e, 0x4,
-    0x10, 0x4, 0x2, 0x3, 0xa, 0x4, 0x12, 0x4, 0xf, 0x24, 0x15, 0x4,
-    0x14, 0x4, 0x2, 0x4, 0x9, 0x4, 0x16, 0x4, 0x1e, 0x4, 0x10, 0x4,
-    0x2, 0x4, 0x9, 0x4, 0x12, 0x4, 0x10, 0x23, 0x15, 0x4, 0x14, 0x4,
-    0x3, 0x4, 0x8, 0x4, 0x16, 0x4, 0x1e, 0x4, 0x10, 0x4, 0x2, 0x4,
-    0x9, 0x4, 0x12, 0x4, 0x11, 0x21, 0x16, 0x4, 0x14, 0x4, 0x3, 0x4,
-    0x8, 0x4, 0x16, 0x4, 0x1e, 0x4, 0x10, 0x4, 0x3, 0x4, 0x8, 0x4,
-    0x12, 0x4, 0x11, 0x20, 0x17, 0x4, 0x14, 0x4, 0x4, 0x3, 0x8, 0x4,
-    0x16, 0x4, 0x1e, 0x4, 0x10, 0x4, 0x3, 0x4, 0x8, 0x4, 0x12, 0x4,
-    0x12, 0x1f, 0x17, 0x4, 0x14, 0x4, 0x4, 0x4, 0x7, 0x4, 0x16, 0x4,
-    0x1e, 0x4, 0x10, 0x4, 0x4, 0x3, 0x8, 0x4, 0x12, 0x4, 0x13, 0x1d,
-    0x18, 0x4, 0x14, 0x4, 0x5, 0x3, 0x7, 0x4, 0x16, 0x13, 0xf, 0x4,
-    0x10, 0x4, 0x4, 0x4, 0x7, 0x4, 0x12, 0x4, 0x14, 0x1b, 0x1a, 0x3,
-    0x14, 0x4, 0x5, 0x4, 0x6, 0x4, 0x16, 0x13, 0x10, 0x3, 0x10, 0x4,
-    0x5, 0x3, 0x7, 0x4, 0x13, 0x3, 0x15, 0x1a, 0x1b, 0x1, 0x15, 0x4,
-    0x6, 0x3, 0x6, 0x4, 0x16, 0x13, 0x11, 0x1, 0x11, 0x4, 0x5, 0x4,
-    0x6, 0x4, 0x14, 0x1, 0x16, 0x19, 0x32, 0x4, 0x6, 0x4, 0x5, 0x4,
-    0x16, 0x13, 0x23, 0x4, 0x6, 0x3, 0x6, 0x4, 0x2c, 0x17, 0x33, 0x4,
-    0x7, 0x3, 0x5, 0x4, 0x16, 0x4, 0x32, 0x4, 0x6, 0x4, 0x5, 0x4,
-    0x2d, 0x16, 0x1d, 0x1, 0x15, 0x4, 0x7, 0x4, 0x4, 0x4, 0x16, 0x4,
-    0x20, 0x1, 0x11, 0x4, 0x7, 0x3, 0x5, 0x4, 0x14, 0x1, 0x19, 0x14,
-    0x1d, 0x3, 0x14, 0x4, 0x7, 0x4, 0x4, 0x4, 0x16, 0x4, 0x1f, 0x3,
-    0x10, 0x4, 0x7, 0x4, 0x4, 0x4, 0x13, 0x3, 0x19, 0x12, 0x1d, 0x4,
-    0x14, 0x4, 0x8, 0x4, 0x3, 0x4, 0x16, 0x4, 0x1e, 0x4, 0x10, 0x4,
-    0x8, 0x3, 0x4, 0x4, 0x12, 0x4, 0x19, 0x12, 0x1d, 0x4, 0x14, 0x4,
-    0x8, 0x4, 0x3, 0x4, 0x16, 0x4, 0x1e, 0x4, 0x10, 0x4, 0x8, 0x4,
-    0x3, 0x4, 0x12, 0x4, 0x1a, 0x10, 0x1e, 0x4, 0x14, 0x4, 0x9, 0x3,
-    0x3, 0x4, 0x16, 0x4, 0x1e, 0x4, 0x10, 0x4, 0x8, 0x4, 0x3, 0x4,
-    0x12, 0x4, 0x1b, 0xe, 0x1f, 0x4, 0x14, 0x4, 0x9, 0x4, 0x2, 0x4,
-    0x16, 0x4, 0x1e, 0x4, 0x10, 0x4, 0x9, 0x4, 0x2, 0x4, 0x12, 0x4,
-    0x1c, 0xd, 0x1f, 0x4, 0x14, 0x4, 0xa, 0x3, 0x2, 0x4, 0x16, 0x4,
-    0x1e, 0x4, 0x10, 0x4, 0x9, 0x4, 0x2, 0x4, 0x12, 0x4, 0x1d, 0xb,
-    0x20, 0x4, 0x14, 0x4, 0xa, 0x4, 0x1, 0x4, 0x16, 0x4, 0x1e, 0x4,
-    0x10, 0x4, 0xa, 0x3, 0x2, 0x4, 0x12, 0x4, 0x1d, 0xb, 0x20, 0x4,
-    0x14, 0x4, 0xb, 0x3, 0x1, 0x4, 0x16, 0x4, 0x1e, 0x4, 0x10, 0x4,
-    0xa, 0x4, 0x1, 0x4, 0x12, 0x4, 0x1e, 0x9, 0x21, 0x4, 0x14, 0x4,
-    0xb, 0x8, 0x16, 0x4, 0x1e, 0x4, 0x10, 0x4, 0xb, 0x3, 0x1, 0x4,
-    0x12, 0x4, 0x1f, 0x7, 0x22, 0x4, 0x14, 0x4, 0xc, 0x7, 0x16, 0x4,
-    0x1e, 0x4, 0x10, 0x4, 0xb, 0x8, 0x12, 0x4, 0x20, 0x6, 0x22, 0x4,
-    0x14, 0x4, 0xc, 0x7, 0x16, 0x4, 0x1e, 0x4, 0x10, 0x4, 0xc, 0x7,
-    0x12, 0x4, 0x21, 0x4, 0x23, 0x4, 0x14, 0x4, 0xd, 0x6, 0x16, 0x4,
-    0x1e, 0x4, 0x10, 0x4, 0xc, 0x7, 0x12, 0x4, 0x21, 0x3, 0x24, 0x4,
-    0x14, 0x4, 0xd, 0x6, 0x16, 0x4, 0x1e, 0x4, 0x10, 0x4, 0xd, 0x6,
-    0x12, 0x4, 0x22, 0x2, 0x24, 0x4, 0x14, 0x4, 0xd, 0x6, 0x16, 0x4,
-    0x1e, 0x4, 0x10, 0x4, 0xd, 0x6, 0x12, 0x4, 0x48, 0x3, 0x15, 0x4,
-    0xe, 0x5, 0x16, 0x4, 0x1e, 0x3, 0x11, 0x4, 0xd, 0x6, 0x12, 0x3,
-    0x4a, 0x1, 0x66, 0x1, 0x3c, 0x1, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0,
-    0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0x10, 0x11,
-    0xf, 0x9, 0xf, 0x4, 0x9, 0x4, 0xd, 0xf, 0x8b, 0x11, 0xf, 0x9,
-    0xf, 0x5, 0x7, 0x5, 0xd, 0xf, 0x8b, 0x11, 0xf, 0x9, 0xf, 0x5,
-    0x7, 0x5, 0xd, 0xf, 0x92, 0x3, 0x19, 0x3, 0x12, 0x6, 0x5, 0x6,
-    0xd, 0x3, 0x9e, 0x3, 0x19, 0x3, 0x12, 0x6, 0x5, 0x6, 0xd, 0x3,
-    0x9e, 0x3, 0x19, 0x3, 0x12, 0x6, 0x5, 0x6, 0xd, 0x3, 0x9e, 0x3,
-    0x19, 0x3, 0x12, 0x3, 0x1, 0x3, 0x3, 0x3, 0x1, 0x3, 0xd, 0x3,
-    0x9e, 0x3, 0x19, 0x3, 0x12, 0x3, 0x2, 0x2, 0x3, 0x2, 0x2, 0x3,
-    0xd, 0x3, 0x9e, 0x3, 0x19, 0x3, 0x12, 0x3, 0x2, 0x3, 0x1, 0x3,
-    0x2, 0x3, 0xd, 0x3, 0x9e, 0x3, 0x19, 0x3, 0x12, 0x3, 0x2, 0x3,
-    0x1, 0x3, 0x2, 0x3, 0xd, 0x3, 0x9e, 0x3, 0x19, 0x3, 0x12, 0x3,
-    0x3, 0x5, 0x3, 0x3, 0xd, 0xd, 0x94, 0x3, 0x19, 0x3, 0x12, 0x3,
-    0x3, 0x5, 0x3, 0x3, 0xd, 0xd, 0x94, 0x3, 0x19, 0x3, 0x12, 0x3,
-    0x4, 0x3, 0x4, 0x3, 0xd, 0xd, 0x94, 0x3, 0x19, 0x3, 0x12, 0x3,
-    0x4, 0x3, 0x4, 0x3, 0xd, 0x3, 0x9e, 0x3, 0x19, 0x3, 0x12, 0x3,
-    0x5, 0x1, 0x5, 0x3, 0xd, 0x3, 0x9e, 0x3, 0x19, 0x3, 0x12, 0x3,
-    0x5, 0x1, 0x5, 0x3, 0xd, 0x3, 0x9e, 0x3, 0x19, 0x3, 0x12, 0x3,
-    0xb, 0x3, 0xd, 0x3, 0x9e, 0x3, 0x19, 0x3, 0x12, 0x3, 0xb, 0x3,
-    0xd, 0x3, 0x9e, 0x3, 0x19, 0x3, 0x12, 0x3, 0xb, 0x3, 0xd, 0x3,
-    0x9e, 0x3, 0x19, 0x3, 0x12, 0x3, 0xb, 0x3, 0xd, 0x3, 0x9e, 0x3,
-    0x19, 0x3, 0x12, 0x3, 0xb, 0x3, 0xd, 0x3, 0x9e, 0x3, 0x19, 0x3,
-    0x12, 0x3, 0xb, 0x3, 0xd, 0xf, 0x92, 0x3, 0x16, 0x9, 0xf, 0x3,
-    0xb, 0x3, 0xd, 0xf, 0x92, 0x3, 0x16, 0x9, 0xf, 0x3, 0xb, 0x3,
-    0xd, 0xf, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0,
-    0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0,
-    0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0,
-    0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0,
-    0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0,
-    0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0, 0xff, 0x0,
-    0xff, 0x0, 0xff, 0x0, 0xec,
+  0x2, 0x2, 0x0, 0x0, 0xaa, 0xa0, 0xff, 0xff, 0xfc, 0xfc, 0xfc, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0x58, 0x5, 0xfc,
+  0xfc, 0xfc, 0xb0, 0xd, 0xfc, 0xfc, 0xfc, 0xac, 0x11, 0xfc, 0xfc, 0xfc,
+  0xa4, 0x19, 0xfc, 0xfc, 0xfc, 0x9c, 0x21, 0xfc, 0xfc, 0xfc, 0x94, 0x25,
+  0xfc, 0xfc, 0xfc, 0x90, 0x2d, 0xfc, 0xfc, 0xfc, 0x88, 0x35, 0xfc, 0xfc,
+  0xfc, 0x80, 0x3d, 0xfc, 0xfc, 0xfc, 0x78, 0x45, 0xfc, 0xfc, 0xfc, 0x74,
+  0x45, 0xfc, 0xfc, 0xfc, 0x70, 0x4d, 0xfc, 0xfc, 0xfc, 0x68, 0x55, 0xfc,
+  0xfc, 0xfc, 0x60, 0x5d, 0xfc, 0xfc, 0xfc, 0x58, 0x65, 0xfc, 0xfc, 0xfc,
+  0x50, 0x69, 0xfc, 0xfc, 0xfc, 0x4c, 0x71, 0xfc, 0xfc, 0xfc, 0x48, 0x31,
+  0xa, 0x35, 0xfc, 0xfc, 0xfc, 0x40, 0x31, 0x12, 0x35, 0xfc, 0xfc, 0xfc,
+  0x38, 0x35, 0x12, 0x39, 0xfc, 0xfc, 0xfc, 0x30, 0x39, 0x12, 0x39, 0xfc,
+  0xfc, 0xfc, 0x2c, 0x3d, 0x12, 0x3d, 0xfc, 0xfc, 0xfc, 0x24, 0x41, 0x12,
+  0x41, 0xfc, 0xfc, 0xfc, 0x1c, 0x45, 0x12, 0x45, 0xfc, 0xfc, 0xfc, 0x14,
+  0x49, 0x12, 0x49, 0xfc, 0xfc, 0xfc, 0x10, 0x49, 0x12, 0x49, 0xfc, 0xfc,
+  0xfc, 0xc, 0x4d, 0x12, 0x4d, 0xfc, 0xfc, 0xfc, 0x4, 0x51, 0x12, 0x51,
+  0xfc, 0xfc, 0xfc, 0x59, 0xa, 0x59, 0xfc, 0xfc, 0xf4, 0xc9, 0xfc, 0xfc,
+  0xec, 0xcd, 0xfc, 0xfc, 0xe8, 0xd5, 0xfc, 0xfc, 0xe4, 0xd9, 0xfc, 0xfc,
+  0xdc, 0xe1, 0xfc, 0xfc, 0xd4, 0xe9, 0xfc, 0xfc, 0xcc, 0xed, 0xfc, 0xfc,
+  0xc8, 0xf5, 0xfc, 0xfc, 0xc0, 0xfd, 0xfc, 0xfc, 0xb8, 0x21, 0x6, 0xb5,
+  0x2, 0x1d, 0xfc, 0xfc, 0xb0, 0x21, 0xe, 0xad, 0xa, 0x1d, 0xfc, 0xfc,
+  0xac, 0x1d, 0x16, 0xa5, 0x12, 0x19, 0xfc, 0xfc, 0xa8, 0x21, 0x16, 0xa1,
+  0x16, 0x1d, 0xfc, 0xfc, 0xa0, 0x29, 0x12, 0xa1, 0x12, 0x25, 0xfc, 0xfc,
+  0x98, 0x31, 0xa, 0xa9, 0xa, 0x2d, 0xfc, 0xfc, 0x90, 0xfd, 0x2d, 0xfc,
+  0xfc, 0x88, 0xfd, 0x31, 0xfc, 0xfc, 0x84, 0xfd, 0x39, 0xfc, 0xfc, 0x7c,
+  0xfd, 0x41, 0xfc, 0xfc, 0x78, 0xfd, 0x45, 0xfc, 0xfc, 0x70, 0xfd, 0x4d,
+  0xfc, 0xfc, 0x68, 0xfd, 0x51, 0xfc, 0xfc, 0x64, 0xfd, 0x59, 0xfc, 0xfc,
+  0x5c, 0xfd, 0x61, 0xfc, 0xfc, 0x54, 0xfd, 0x69, 0xfc, 0xfc, 0x4c, 0xfd,
+  0x71, 0xfc, 0xfc, 0x48, 0xfd, 0x71, 0xfc, 0xfc, 0x44, 0xfd, 0x79, 0xfc,
+  0xfc, 0x3c, 0xfd, 0x81, 0xfc, 0xfc, 0x34, 0xfd, 0x89, 0xfc, 0xfc, 0x2c,
+  0xfd, 0x91, 0xfc, 0xfc, 0x24, 0xfd, 0x95, 0xfc, 0xfc, 0x20, 0xfd, 0x9d,
+  0xfc, 0xfc, 0x18, 0x1d, 0x6, 0xfd, 0x61, 0x6, 0x11, 0xfc, 0xfc, 0x14,
+  0x19, 0xe, 0xfd, 0x59, 0xe, 0x11, 0xfc, 0xfc, 0xc, 0x1d, 0x12, 0xfd,
+  0x51, 0x16, 0x11, 0xfc, 0xfc, 0x4, 0x21, 0x16, 0xfd, 0x4d, 0x16, 0x11,
+  0xfc, 0xfc, 0x0, 0x25, 0x12, 0xfd, 0x51, 0x12, 0x19, 0xfc, 0xf8, 0x2d,
+  0xe, 0xfd, 0x55, 0xa, 0x21, 0xfc, 0xf0, 0xfd, 0xcd, 0xfc, 0xe8, 0xfd,
+  0xd5, 0xfc, 0xe0, 0xfd, 0xd9, 0xfc, 0xe0, 0xfd, 0xdd, 0xfc, 0xd8, 0xfd,
+  0xe5, 0xfc, 0xd0, 0xfd, 0xed, 0xfc, 0xc8, 0xfd, 0xf5, 0xfc, 0xc0, 0xfd,
+  0xf9, 0xfc, 0xbc, 0xfd, 0xfd, 0x1, 0xfc, 0xb4, 0xfd, 0xfd, 0x9, 0xfc,
+  0xac, 0xfd, 0xfd, 0x11, 0xfc, 0xa8, 0xfd, 0xfd, 0x15, 0xfc, 0xa0, 0xfd,
+  0xfd, 0x19, 0xfc, 0x9c, 0xfd, 0xfd, 0x21, 0xfc, 0x94, 0xfd, 0xfd, 0x29,
+  0xfc, 0x8c, 0xfd, 0xfd, 0x31, 0xfc, 0x84, 0xfd, 0xfd, 0x39, 0xfc, 0x7c,
+  0xfd, 0xfd, 0x3d, 0xfc, 0x7c, 0xfd, 0xfd, 0x41, 0xfc, 0x74, 0xfd, 0xfd,
+  0x49, 0xfc, 0x6c, 0xfd, 0xfd, 0x51, 0xfc, 0x64, 0x35, 0x1a, 0xfd, 0xc1,
+  0x1a, 0x25, 0xfc, 0x5c, 0x31, 0x2a, 0xfd, 0xb1, 0x2a, 0x1d, 0xfc, 0x58,
+  0x35, 0x2e, 0xfd, 0xad, 0x2e, 0x1d, 0xfc, 0x50, 0x39, 0x2e, 0xfd, 0xad,
+  0x2a, 0x25, 0xfc, 0x48, 0x41, 0x26, 0xfd, 0xb1, 0x2a, 0x29, 0xfc, 0x44,
+  0xfd, 0xfd, 0x79, 0xfc, 0x3c, 0xfd, 0xfd, 0x7d, 0xfc, 0x38, 0xfd, 0xfd,
+  0x85, 0xfc, 0x30, 0xfd, 0xfd, 0x8d, 0xfc, 0x28, 0xfd, 0xfd, 0x95, 0xfc,
+  0x20, 0xfd, 0xfd, 0x9d, 0xfc, 0x1c, 0xfd, 0xfd, 0x9d, 0xfc, 0xfc, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0x84, 0xfd, 0xd, 0xfc, 0xfc, 0xb0, 0xfd, 0x9,
+  0xfc, 0xfc, 0xb4, 0xfd, 0x1, 0xfc, 0xfc, 0xbc, 0xfd, 0xfc, 0xfc, 0xc0,
+  0xf5, 0xfc, 0xfc, 0xc4, 0xf5, 0xfc, 0xfc, 0xc8, 0xed, 0xfc, 0xfc, 0xd0,
+  0xe5, 0xfc, 0xfc, 0xd8, 0xe1, 0xfc, 0xfc, 0xdc, 0xd9, 0xfc, 0xfc, 0xe0,
+  0xd5, 0xfc, 0xfc, 0xe8, 0xd1, 0x34, 0x2, 0xfc, 0x94, 0x2, 0xec, 0x2,
+  0x20, 0xc9, 0x34, 0xa, 0x50, 0x12, 0x34, 0xe, 0x54, 0x52, 0x30, 0xa,
+  0x40, 0x12, 0x34, 0xe, 0x44, 0xa, 0x20, 0xc1, 0x38, 0xe, 0x4c, 0x16,
+  0x30, 0xe, 0x54, 0x52, 0x30, 0xe, 0x3c, 0x12, 0x34, 0xe, 0x44, 0xe,
+  0x20, 0xbd, 0x38, 0xe, 0x4c, 0x16, 0x30, 0xe, 0x54, 0x52, 0x30, 0xe,
+  0x3c, 0x16, 0x30, 0xe, 0x44, 0xe, 0x20, 0xb9, 0x3c, 0xe, 0x4c, 0x1a,
+  0x2c, 0xe, 0x54, 0x52, 0x30, 0xe, 0x3c, 0x16, 0x30, 0xe, 0x44, 0xe,
+  0x24, 0xb1, 0x40, 0xe, 0x4c, 0x1a, 0x2c, 0xe, 0x54, 0xe, 0x74, 0xe,
+  0x3c, 0x1a, 0x2c, 0xe, 0x44, 0xe, 0x28, 0xad, 0x40, 0xe, 0x4c, 0x1e,
+  0x28, 0xe, 0x54, 0xe, 0x74, 0xe, 0x3c, 0x1a, 0x2c, 0xe, 0x44, 0xe,
+  0x2c, 0xa5, 0x44, 0xe, 0x4c, 0x1e, 0x28, 0xe, 0x54, 0xe, 0x74, 0xe,
+  0x3c, 0x1e, 0x28, 0xe, 0x44, 0xe, 0x30, 0x9d, 0x48, 0xe, 0x4c, 0xe,
+  0x0, 0xe, 0x24, 0xe, 0x54, 0xe, 0x74, 0xe, 0x3c, 0xe, 0x0, 0xa,
+  0x28, 0xe, 0x44, 0xe, 0x30, 0x9d, 0x48, 0xe, 0x4c, 0xe, 0x0, 0xe,
+  0x24, 0xe, 0x54, 0xe, 0x74, 0xe, 0x3c, 0xe, 0x0, 0xe, 0x24, 0xe,
+  0x44, 0xe, 0x34, 0x95, 0x4c, 0xe, 0x4c, 0xe, 0x4, 0xe, 0x20, 0xe,
+  0x54, 0xe, 0x74, 0xe, 0x3c, 0xe, 0x4, 0xa, 0x24, 0xe, 0x44, 0xe,
+  0x38, 0x8d, 0x50, 0xe, 0x4c, 0xe, 0x4, 0xe, 0x20, 0xe, 0x54, 0xe,
+  0x74, 0xe, 0x3c, 0xe, 0x4, 0xe, 0x20, 0xe, 0x44, 0xe, 0x3c, 0x89,
+  0x50, 0xe, 0x4c, 0xe, 0x8, 0xe, 0x1c, 0xe, 0x54, 0xe, 0x74, 0xe,
+  0x3c, 0xe, 0x4, 0xe, 0x20, 0xe, 0x44, 0xe, 0x40, 0x81, 0x54, 0xe,
+  0x4c, 0xe, 0x8, 0xe, 0x1c, 0xe, 0x54, 0xe, 0x74, 0xe, 0x3c, 0xe,
+  0x8, 0xe, 0x1c, 0xe, 0x44, 0xe, 0x40, 0x7d, 0x58, 0xe, 0x4c, 0xe,
+  0xc, 0xa, 0x1c, 0xe, 0x54, 0xe, 0x74, 0xe, 0x3c, 0xe, 0x8, 0xe,
+  0x1c, 0xe, 0x44, 0xe, 0x44, 0x79, 0x58, 0xe, 0x4c, 0xe, 0xc, 0xe,
+  0x18, 0xe, 0x54, 0xe, 0x74, 0xe, 0x3c, 0xe, 0xc, 0xa, 0x1c, 0xe,
+  0x44, 0xe, 0x48, 0x71, 0x5c, 0xe, 0x4c, 0xe, 0x10, 0xa, 0x18, 0xe,
+  0x54, 0x4a, 0x38, 0xe, 0x3c, 0xe, 0xc, 0xe, 0x18, 0xe, 0x44, 0xe,
+  0x4c, 0x69, 0x64, 0xa, 0x4c, 0xe, 0x10, 0xe, 0x14, 0xe, 0x54, 0x4a,
+  0x3c, 0xa, 0x3c, 0xe, 0x10, 0xa, 0x18, 0xe, 0x48, 0xa, 0x50, 0x65,
+  0x68, 0x2, 0x50, 0xe, 0x14, 0xa, 0x14, 0xe, 0x54, 0x4a, 0x40, 0x2,
+  0x40, 0xe, 0x10, 0xe, 0x14, 0xe, 0x4c, 0x2, 0x54, 0x61, 0xc4, 0xe,
+  0x14, 0xe, 0x10, 0xe, 0x54, 0x4a, 0x88, 0xe, 0x14, 0xa, 0x14, 0xe,
+  0xac, 0x59, 0xc8, 0xe, 0x18, 0xa, 0x10, 0xe, 0x54, 0xe, 0xc4, 0xe,
+  0x14, 0xe, 0x10, 0xe, 0xb0, 0x55, 0x70, 0x2, 0x50, 0xe, 0x18, 0xe,
+  0xc, 0xe, 0x54, 0xe, 0x7c, 0x2, 0x40, 0xe, 0x18, 0xa, 0x10, 0xe,
+  0x4c, 0x2, 0x60, 0x4d, 0x70, 0xa, 0x4c, 0xe, 0x18, 0xe, 0xc, 0xe,
+  0x54, 0xe, 0x78, 0xa, 0x3c, 0xe, 0x18, 0xe, 0xc, 0xe, 0x48, 0xa,
+  0x60, 0x45, 0x70, 0xe, 0x4c, 0xe, 0x1c, 0xe, 0x8, 0xe, 0x54, 0xe,
+  0x74, 0xe, 0x3c, 0xe, 0x1c, 0xa, 0xc, 0xe, 0x44, 0xe, 0x60, 0x45,
+  0x70, 0xe, 0x4c, 0xe, 0x1c, 0xe, 0x8, 0xe, 0x54, 0xe, 0x74, 0xe,
+  0x3c, 0xe, 0x1c, 0xe, 0x8, 0xe, 0x44, 0xe, 0x64, 0x3d, 0x74, 0xe,
+  0x4c, 0xe, 0x20, 0xa, 0x8, 0xe, 0x54, 0xe, 0x74, 0xe, 0x3c, 0xe,
+  0x1c, 0xe, 0x8, 0xe, 0x44, 0xe, 0x68, 0x35, 0x78, 0xe, 0x4c, 0xe,
+  0x20, 0xe, 0x4, 0xe, 0x54, 0xe, 0x74, 0xe, 0x3c, 0xe, 0x20, 0xe,
+  0x4, 0xe, 0x44, 0xe, 0x6c, 0x31, 0x78, 0xe, 0x4c, 0xe, 0x24, 0xa,
+  0x4, 0xe, 0x54, 0xe, 0x74, 0xe, 0x3c, 0xe, 0x20, 0xe, 0x4, 0xe,
+  0x44, 0xe, 0x70, 0x29, 0x7c, 0xe, 0x4c, 0xe, 0x24, 0xe, 0x0, 0xe,
+  0x54, 0xe, 0x74, 0xe, 0x3c, 0xe, 0x24, 0xa, 0x4, 0xe, 0x44, 0xe,
+  0x70, 0x29, 0x7c, 0xe, 0x4c, 0xe, 0x28, 0xa, 0x0, 0xe, 0x54, 0xe,
+  0x74, 0xe, 0x3c, 0xe, 0x24, 0xe, 0x0, 0xe, 0x44, 0xe, 0x74, 0x21,
+  0x80, 0xe, 0x4c, 0xe, 0x28, 0x1e, 0x54, 0xe, 0x74, 0xe, 0x3c, 0xe,
+  0x28, 0xa, 0x0, 0xe, 0x44, 0xe, 0x78, 0x19, 0x84, 0xe, 0x4c, 0xe,
+  0x2c, 0x1a, 0x54, 0xe, 0x74, 0xe, 0x3c, 0xe, 0x28, 0x1e, 0x44, 0xe,
+  0x7c, 0x15, 0x84, 0xe, 0x4c, 0xe, 0x2c, 0x1a, 0x54, 0xe, 0x74, 0xe,
+  0x3c, 0xe, 0x2c, 0x1a, 0x44, 0xe, 0x80, 0xd, 0x88, 0xe, 0x4c, 0xe,
+  0x30, 0x16, 0x54, 0xe, 0x74, 0xe, 0x3c, 0xe, 0x2c, 0x1a, 0x44, 0xe,
+  0x80, 0x9, 0x8c, 0xe, 0x4c, 0xe, 0x30, 0x16, 0x54, 0xe, 0x74, 0xe,
+  0x3c, 0xe, 0x30, 0x16, 0x44, 0xe, 0x84, 0x5, 0x8c, 0xe, 0x4c, 0xe,
+  0x30, 0x16, 0x54, 0xe, 0x74, 0xe, 0x3c, 0xe, 0x30, 0x16, 0x44, 0xe,
+  0xfc, 0x1c, 0xa, 0x50, 0xe, 0x34, 0x12, 0x54, 0xe, 0x74, 0xa, 0x40,
+  0xe, 0x30, 0x16, 0x44, 0xa, 0xfc, 0x24, 0x2, 0xfc, 0x94, 0x2, 0xec,
+  0x2, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0x1c, 0x42, 0x38,
+  0x22, 0x38, 0xe, 0x20, 0xe, 0x30, 0x3a, 0xfc, 0xfc, 0x28, 0x42, 0x38,
+  0x22, 0x38, 0x12, 0x18, 0x12, 0x30, 0x3a, 0xfc, 0xfc, 0x28, 0x42, 0x38,
+  0x22, 0x38, 0x12, 0x18, 0x12, 0x30, 0x3a, 0xfc, 0xfc, 0x44, 0xa, 0x60,
+  0xa, 0x44, 0x16, 0x10, 0x16, 0x30, 0xa, 0xfc, 0xfc, 0x74, 0xa, 0x60,
+  0xa, 0x44, 0x16, 0x10, 0x16, 0x30, 0xa, 0xfc, 0xfc, 0x74, 0xa, 0x60,
+  0xa, 0x44, 0x16, 0x10, 0x16, 0x30, 0xa, 0xfc, 0xfc, 0x74, 0xa, 0x60,
+  0xa, 0x44, 0xa, 0x0, 0xa, 0x8, 0xa, 0x0, 0xa, 0x30, 0xa, 0xfc,
+  0xfc, 0x74, 0xa, 0x60, 0xa, 0x44, 0xa, 0x4, 0x6, 0x8, 0x6, 0x4,
+  0xa, 0x30, 0xa, 0xfc, 0xfc, 0x74, 0xa, 0x60, 0xa, 0x44, 0xa, 0x4,
+  0xa, 0x0, 0xa, 0x4, 0xa, 0x30, 0xa, 0xfc, 0xfc, 0x74, 0xa, 0x60,
+  0xa, 0x44, 0xa, 0x4, 0xa, 0x0, 0xa, 0x4, 0xa, 0x30, 0xa, 0xfc,
+  0xfc, 0x74, 0xa, 0x60, 0xa, 0x44, 0xa, 0x8, 0x12, 0x8, 0xa, 0x30,
+  0x32, 0xfc, 0xfc, 0x4c, 0xa, 0x60, 0xa, 0x44, 0xa, 0x8, 0x12, 0x8,
+  0xa, 0x30, 0x32, 0xfc, 0xfc, 0x4c, 0xa, 0x60, 0xa, 0x44, 0xa, 0xc,
+  0xa, 0xc, 0xa, 0x30, 0x32, 0xfc, 0xfc, 0x4c, 0xa, 0x60, 0xa, 0x44,
+  0xa, 0xc, 0xa, 0xc, 0xa, 0x30, 0xa, 0xfc, 0xfc, 0x74, 0xa, 0x60,
+  0xa, 0x44, 0xa, 0x10, 0x2, 0x10, 0xa, 0x30, 0xa, 0xfc, 0xfc, 0x74,
+  0xa, 0x60, 0xa, 0x44, 0xa, 0x10, 0x2, 0x10, 0xa, 0x30, 0xa, 0xfc,
+  0xfc, 0x74, 0xa, 0x60, 0xa, 0x44, 0xa, 0x28, 0xa, 0x30, 0xa, 0xfc,
+  0xfc, 0x74, 0xa, 0x60, 0xa, 0x44, 0xa, 0x28, 0xa, 0x30, 0xa, 0xfc,
+  0xfc, 0x74, 0xa, 0x60, 0xa, 0x44, 0xa, 0x28, 0xa, 0x30, 0xa, 0xfc,
+  0xfc, 0x74, 0xa, 0x60, 0xa, 0x44, 0xa, 0x28, 0xa, 0x30, 0xa, 0xfc,
+  0xfc, 0x74, 0xa, 0x60, 0xa, 0x44, 0xa, 0x28, 0xa, 0x30, 0xa, 0xfc,
+  0xfc, 0x74, 0xa, 0x60, 0xa, 0x44, 0xa, 0x28, 0xa, 0x30, 0x3a, 0xfc,
+  0xfc, 0x44, 0xa, 0x54, 0x22, 0x38, 0xa, 0x28, 0xa, 0x30, 0x3a, 0xfc,
+  0xfc, 0x44, 0xa, 0x54, 0x22, 0x38, 0xa, 0x28, 0xa, 0x30, 0x3a, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc,
+  0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0x18,
 };
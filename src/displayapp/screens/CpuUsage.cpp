@@ -0,0 +1,64 @@
+#include "displayapp/screens/CpuUsage.h"
+#include <cstdio>
+#include "displayapp/DisplayApp.h"
+
+using namespace Pinetime::Applications::Screens;
+
+namespace {
+  void FormatUsage(char* buffer, size_t size, uint16_t usage) {
+    snprintf(buffer, size, "%d.%d%%", usage / 10, usage % 10);
+  }
+}
+
+CpuUsage::CpuUsage(uint8_t screenID, uint8_t numScreens, Pinetime::Applications::DisplayApp* app)
+  : Screen(app), table {CreateTable()}, page {screenID, numScreens, app, table} {
+  taskRefresh = lv_task_create(RefreshTaskCallback, 1000, LV_TASK_PRIO_MID, this);
+  Refresh();
+}
+
+CpuUsage::~CpuUsage() {
+  lv_task_del(taskRefresh);
+}
+
+lv_obj_t* CpuUsage::CreateTable() {
+  lv_obj_t* table = lv_table_create(lv_scr_act(), nullptr);
+  lv_table_set_col_cnt(table, 2);
+  lv_obj_set_style_local_pad_all(table, LV_TABLE_PART_CELL1, LV_STATE_DEFAULT, 0);
+  lv_obj_set_style_local_border_color(table, LV_TABLE_PART_CELL1, LV_STATE_DEFAULT, LV_COLOR_GRAY);
+  lv_table_set_col_width(table, 0, 110);
+  lv_table_set_col_width(table, 1, 110);
+  return table;
+}
+
+void CpuUsage::Refresh() {
+  // The firmware is not built with USE_RUNTIME_STATS
+  if (!Pinetime::System::RunTimeStats::enabled) {
+    lv_table_set_row_cnt(table, 1);
+    lv_table_set_cell_value(table, 0, 0, "CPU usage");
+    lv_table_set_cell_value(table, 0, 1, "Disabled");
+    return;
+  }
+
+  runTimeStats.Update();
+
+  auto nb = runTimeStats.NbTasks();
+  auto* tasks = runTimeStats.Tasks();
+  lv_table_set_row_cnt(table, nb + 2);
+
+  char buffer[12];
+  for (uint8_t i = 0; i < nb; i++) {
+    lv_table_set_cell_value(table, i, 0, tasks[i].name);
+    FormatUsage(buffer, sizeof(buffer), tasks[i].usage);
+    lv_table_set_cell_value(table, i, 1, buffer);
+  }
+
+  lv_table_set_cell_value(table, nb, 0, "ISR");
+  FormatUsage(buffer, sizeof(buffer), runTimeStats.IsrUsage());
+  lv_table_set_cell_value(table, nb, 1, buffer);
+
+  uint32_t windowMs = runTimeStats.WindowMs();
+  uint32_t switchesPerSecond = (windowMs == 0) ? 0 : (runTimeStats.ContextSwitches() * 1000) / windowMs;
+  lv_table_set_cell_value(table, nb + 1, 0, "Ctx/s");
+  snprintf(buffer, sizeof(buffer), "%lu", switchesPerSecond);
+  lv_table_set_cell_value(table, nb + 1, 1, buffer);
+}
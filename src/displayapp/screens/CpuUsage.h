@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <lvgl/lvgl.h>
+#include "displayapp/screens/Screen.h"
+#include "displayapp/screens/Label.h"
+#include "systemtask/RunTimeStats.h"
+
+namespace Pinetime {
+  namespace Applications {
+    namespace Screens {
+
+      // Page of SystemInfo showing the CPU usage of each task, refreshed every second
+      class CpuUsage : public Screen {
+      public:
+        CpuUsage(uint8_t screenID, uint8_t numScreens, DisplayApp* app);
+        ~CpuUsage() override;
+
+        void Refresh() override;
+
+      private:
+        static lv_obj_t* CreateTable();
+
+        lv_obj_t* table;
+        Label page; // page indicator, cleans the screen when destroyed
+        lv_task_t* taskRefresh;
+        Pinetime::System::RunTimeStats runTimeStats;
+      };
+    }
+  }
+}
@@ -150,39 +150,44 @@ Music::~Music() {
 }
 
 void Music::Refresh() {
-  if (artist != musicService.getArtist()) {
-    artist = musicService.getArtist();
+  uint32_t version = musicService.StateVersion();
+  if (version != musicStateVersion && musicService.GetState(musicState)) {
+    musicStateVersion = version;
+  }
+
+  if (artist != musicState.artist) {
+    artist = musicState.artist;
     currentLength = 0;
     lv_label_set_text(txtArtist, artist.data());
   }
 
-  if (track != musicService.getTrack()) {
-    track = musicService.getTrack();
+  if (track != musicState.track) {
+    track = musicState.track;
     currentLength = 0;
     lv_label_set_text(txtTrack, track.data());
   }
 
-  if (album != musicService.getAlbum()) {
-    album = musicService.getAlbum();
+  if (album != musicState.album) {
+    album = musicState.album;
     currentLength = 0;
   }
 
-  if (playing != musicService.isPlaying()) {
-    playing = musicService.isPlaying();
+  if (playing != musicState.playing) {
+    playing = musicState.playing;
   }
 
   // Because we increment this ourselves,
   // we can't compare with the old data directly
   // have to update it when there's actually new data
   // just to avoid unnecessary draws that make UI choppy
-  if (lastLength != musicService.getProgress()) {
-    currentLength = musicService.getProgress();
+  if (lastLength != musicState.trackProgress) {
+    currentLength = musicState.trackProgress;
     lastLength = currentLength;
     UpdateLength();
   }
 
-  if (totalLength != musicService.getTrackLength()) {
-    totalLength = musicService.getTrackLength();
+  if (totalLength != musicState.trackLength) {
+    totalLength = musicState.trackLength;
     UpdateLength();
   }
 
@@ -199,7 +204,7 @@ void Music::Refresh() {
 
       if (currentLength < totalLength) {
         currentLength +=
-          static_cast<int>((static_cast<float>(xTaskGetTickCount() - lastIncrement) / 1024.0f) * musicService.getPlaybackSpeed());
+          static_cast<int>((static_cast<float>(xTaskGetTickCount() - lastIncrement) / 1024.0f) * musicState.playbackSpeed);
       } else {
         // Let's assume the getTrack finished, paused when the timer ends
         //  and there's no new getTrack being sent to us
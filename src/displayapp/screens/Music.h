@@ -21,12 +21,9 @@
 #include <lvgl/src/lv_core/lv_obj.h>
 #include <string>
 #include "displayapp/screens/Screen.h"
+#include "components/ble/MusicService.h"
 
 namespace Pinetime {
-  namespace Controllers {
-    class MusicService;
-  }
-
   namespace Applications {
     namespace Screens {
       class Music : public Screen {
@@ -63,6 +60,10 @@ namespace Pinetime {
         bool frameB;
 
         Pinetime::Controllers::MusicService& musicService;
+        // Copy of the state of the music service, updated when its version changes
+        // (the version is odd only while the state is modified, so the initial value forces the first update)
+        Pinetime::Controllers::MusicService::State musicState {};
+        uint32_t musicStateVersion = 1;
 
         std::string artist;
         std::string album;
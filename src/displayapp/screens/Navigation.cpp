@@ -171,23 +171,28 @@ Navigation::~Navigation() {
 }
 
 void Navigation::Refresh() {
-  if (flag != navService.getFlag()) {
-    flag = navService.getFlag();
+  uint32_t version = navService.StateVersion();
+  if (version != navStateVersion && navService.GetState(navState)) {
+    navStateVersion = version;
+  }
+
+  if (flag != navState.flag) {
+    flag = navState.flag;
     lv_label_set_text(imgFlag, iconForName(flag));
   }
 
-  if (narrative != navService.getNarrative()) {
-    narrative = navService.getNarrative();
+  if (narrative != navState.narrative) {
+    narrative = navState.narrative;
     lv_label_set_text(txtNarrative, narrative.data());
   }
 
-  if (manDist != navService.getManDist()) {
-    manDist = navService.getManDist();
+  if (manDist != navState.manDist) {
+    manDist = navState.manDist;
     lv_label_set_text(txtManDist, manDist.data());
   }
 
-  if (progress != navService.getProgress()) {
-    progress = navService.getProgress();
+  if (progress != navState.progress) {
+    progress = navState.progress;
     lv_bar_set_value(barProgress, progress, LV_ANIM_OFF);
     if (progress > 90) {
       lv_obj_set_style_local_bg_color(barProgress, LV_BAR_PART_INDIC, LV_STATE_DEFAULT, LV_COLOR_RED);
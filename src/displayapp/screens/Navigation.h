@@ -21,13 +21,10 @@
 #include <lvgl/src/lv_core/lv_obj.h>
 #include <string>
 #include "displayapp/screens/Screen.h"
+#include "components/ble/NavigationService.h"
 #include <array>
 
 namespace Pinetime {
-  namespace Controllers {
-    class NavigationService;
-  }
-
   namespace Applications {
     namespace Screens {
       class Navigation : public Screen {
@@ -44,6 +41,10 @@ namespace Pinetime {
         lv_obj_t* barProgress;
 
         Pinetime::Controllers::NavigationService& navService;
+        // Copy of the state of the navigation service, updated when its version changes
+        // (the version is odd only while the state is modified, so the initial value forces the first update)
+        Pinetime::Controllers::NavigationService::State navState {};
+        uint32_t navStateVersion = 1;
 
         std::string flag;
         std::string narrative;
@@ -23,15 +23,7 @@ Notifications::Notifications(DisplayApp* app,
   notificationManager.ClearNewNotificationFlag();
   auto notification = notificationManager.GetLastNotification();
   if (notification.valid) {
-    currentId = notification.id;
-    currentItem = std::make_unique<NotificationItem>(notification.Title(),
-                                                     notification.Message(),
-                                                     notification.index,
-                                                     notification.category,
-                                                     notificationManager.NbNotifications(),
-                                                     mode,
-                                                     alertNotificationService,
-                                                     motorController);
+    ShowNotification(notification);
     validDisplay = true;
   } else {
     currentItem = std::make_unique<NotificationItem>("Notification",
@@ -88,6 +80,27 @@ void Notifications::Refresh() {
   running = currentItem->IsRunning() && running;
 }
 
+void Notifications::ShowNotification(Controllers::NotificationManager::Notification notification) {
+  // The BLE task may discard the notification while its text is copied into the labels,
+  // the newest notification is shown instead in this case.
+  for (uint8_t attempt = 0; attempt < maxShowAttempts && notification.valid; attempt++) {
+    currentId = notification.id;
+    currentItem.reset(nullptr);
+    currentItem = std::make_unique<NotificationItem>(notification.Title(),
+                                                     notification.Message(),
+                                                     notification.index,
+                                                     notification.category,
+                                                     notificationManager.NbNotifications(),
+                                                     mode,
+                                                     alertNotificationService,
+                                                     motorController);
+    if (notificationManager.IsStored(notification)) {
+      return;
+    }
+    notification = notificationManager.GetLastNotification();
+  }
+}
+
 void Notifications::OnPreviewInteraction() {
   systemTask.PushMessage(System::Messages::EnableSleeping);
   motorController.StopRinging();
@@ -119,17 +132,8 @@ bool Notifications::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
         return true;
 
       validDisplay = true;
-      currentId = previousNotification.id;
-      currentItem.reset(nullptr);
       app->SetFullRefresh(DisplayApp::FullRefreshDirections::Down);
-      currentItem = std::make_unique<NotificationItem>(previousNotification.Title(),
-                                                       previousNotification.Message(),
-                                                       previousNotification.index,
-                                                       previousNotification.category,
-                                                       notificationManager.NbNotifications(),
-                                                       mode,
-                                                       alertNotificationService,
-                                                       motorController);
+      ShowNotification(previousNotification);
     }
       return true;
     case Pinetime::Applications::TouchEvents::SwipeUp: {
@@ -145,17 +149,8 @@ bool Notifications::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
       }
 
       validDisplay = true;
-      currentId = nextNotification.id;
-      currentItem.reset(nullptr);
       app->SetFullRefresh(DisplayApp::FullRefreshDirections::Up);
-      currentItem = std::make_unique<NotificationItem>(nextNotification.Title(),
-                                                       nextNotification.Message(),
-                                                       nextNotification.index,
-                                                       nextNotification.category,
-                                                       notificationManager.NbNotifications(),
-                                                       mode,
-                                                       alertNotificationService,
-                                                       motorController);
+      ShowNotification(nextNotification);
     }
       return true;
     default:
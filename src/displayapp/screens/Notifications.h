@@ -62,6 +62,9 @@ namespace Pinetime {
         };
 
       private:
+        void ShowNotification(Controllers::NotificationManager::Notification notification);
+        static constexpr uint8_t maxShowAttempts = 3;
+
         Pinetime::Controllers::NotificationManager& notificationManager;
         Pinetime::Controllers::AlertNotificationService& alertNotificationService;
         Pinetime::Controllers::MotorController& motorController;
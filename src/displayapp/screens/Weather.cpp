@@ -71,8 +71,8 @@ bool Weather::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
 std::unique_ptr<Screen> Weather::CreateScreenTemperature() {
   lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
   lv_label_set_recolor(label, true);
-  std::unique_ptr<Controllers::WeatherData::Temperature>& current = weatherService.GetCurrentTemperature();
-  if (current->timestamp == 0) {
+  const Controllers::WeatherData::Temperature& current = weatherService.GetCurrentTemperature();
+  if (current.timestamp == 0) {
     // Do not use the data, it's invalid
     lv_label_set_text_fmt(label,
                           "#FFFF00 Temperature#\n\n"
@@ -91,10 +91,10 @@ std::unique_ptr<Screen> Weather::CreateScreenTemperature() {
                           "#444444 %hd#\n\n"
                           "%llu\n"
                           "%lu\n",
-                          current->temperature / 100,
-                          current->dewPoint,
-                          current->timestamp,
-                          current->expires);
+                          current.temperature / 100,
+                          current.dewPoint,
+                          current.timestamp,
+                          current.expires);
   }
   lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
@@ -104,8 +104,8 @@ std::unique_ptr<Screen> Weather::CreateScreenTemperature() {
 std::unique_ptr<Screen> Weather::CreateScreenAir() {
   lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
   lv_label_set_recolor(label, true);
-  std::unique_ptr<Controllers::WeatherData::AirQuality>& current = weatherService.GetCurrentQuality();
-  if (current->timestamp == 0) {
+  const Controllers::WeatherData::AirQuality& current = weatherService.GetCurrentQuality();
+  if (current.timestamp == 0) {
     // Do not use the data, it's invalid
     lv_label_set_text_fmt(label,
                           "#FFFF00 Air quality#\n\n"
@@ -124,10 +124,10 @@ std::unique_ptr<Screen> Weather::CreateScreenAir() {
                           "#444444 %lu#\n\n"
                           "%llu\n"
                           "%lu\n",
-                          current->polluter.c_str(),
-                          (current->amount / 100),
-                          current->timestamp,
-                          current->expires);
+                          current.polluter,
+                          (current.amount / 100),
+                          current.timestamp,
+                          current.expires);
   }
   lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
@@ -137,8 +137,8 @@ std::unique_ptr<Screen> Weather::CreateScreenAir() {
 std::unique_ptr<Screen> Weather::CreateScreenClouds() {
   lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
   lv_label_set_recolor(label, true);
-  std::unique_ptr<Controllers::WeatherData::Clouds>& current = weatherService.GetCurrentClouds();
-  if (current->timestamp == 0) {
+  const Controllers::WeatherData::Clouds& current = weatherService.GetCurrentClouds();
+  if (current.timestamp == 0) {
     // Do not use the data, it's invalid
     lv_label_set_text_fmt(label,
                           "#FFFF00 Clouds#\n\n"
@@ -154,9 +154,9 @@ std::unique_ptr<Screen> Weather::CreateScreenClouds() {
                           "#444444 %hhu%%#\n\n"
                           "%llu\n"
                           "%lu\n",
-                          current->amount,
-                          current->timestamp,
-                          current->expires);
+                          current.amount,
+                          current.timestamp,
+                          current.expires);
   }
   lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
@@ -166,8 +166,8 @@ std::unique_ptr<Screen> Weather::CreateScreenClouds() {
 std::unique_ptr<Screen> Weather::CreateScreenPrecipitation() {
   lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
   lv_label_set_recolor(label, true);
-  std::unique_ptr<Controllers::WeatherData::Precipitation>& current = weatherService.GetCurrentPrecipitation();
-  if (current->timestamp == 0) {
+  const Controllers::WeatherData::Precipitation& current = weatherService.GetCurrentPrecipitation();
+  if (current.timestamp == 0) {
     // Do not use the data, it's invalid
     lv_label_set_text_fmt(label,
                           "#FFFF00 Precipitation#\n\n"
@@ -183,9 +183,9 @@ std::unique_ptr<Screen> Weather::CreateScreenPrecipitation() {
                           "#444444 %hhu%%#\n\n"
                           "%llu\n"
                           "%lu\n",
-                          current->amount,
-                          current->timestamp,
-                          current->expires);
+                          current.amount,
+                          current.timestamp,
+                          current.expires);
   }
   lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
@@ -195,8 +195,8 @@ std::unique_ptr<Screen> Weather::CreateScreenPrecipitation() {
 std::unique_ptr<Screen> Weather::CreateScreenHumidity() {
   lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
   lv_label_set_recolor(label, true);
-  std::unique_ptr<Controllers::WeatherData::Humidity>& current = weatherService.GetCurrentHumidity();
-  if (current->timestamp == 0) {
+  const Controllers::WeatherData::Humidity& current = weatherService.GetCurrentHumidity();
+  if (current.timestamp == 0) {
     // Do not use the data, it's invalid
     lv_label_set_text_fmt(label,
                           "#FFFF00 Humidity#\n\n"
@@ -212,9 +212,9 @@ std::unique_ptr<Screen> Weather::CreateScreenHumidity() {
                           "#444444 %hhu%%#\n\n"
                           "%llu\n"
                           "%lu\n",
-                          current->humidity,
-                          current->timestamp,
-                          current->expires);
+                          current.humidity,
+                          current.timestamp,
+                          current.expires);
   }
   lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
@@ -1,4 +1,5 @@
 #include "drivers/Bma421.h"
+#include <algorithm>
 #include <libraries/delay/nrf_delay.h>
 #include <libraries/log/nrf_log.h>
 #include "drivers/TwiMaster.h"
@@ -22,8 +23,13 @@ namespace {
   void user_delay(uint32_t period_us, void* intf_ptr) {
     nrf_delay_us(period_us);
   }
+
+  constexpr uint8_t fifoFlushCommand = 0xB0;
 }
 
+static_assert(sizeof(Bma421::Sample) == 6, "Samples are decoded in place of the FIFO frames");
+static_assert(sizeof(Bma421::Sample) * Bma421::maxSamples <= TwiMaster::maxTransferSize, "The FIFO must be read in a single transfer");
+
 Bma421::Bma421(TwiMaster& twiMaster, uint8_t twiAddress) : twiMaster {twiMaster}, deviceAddress {twiAddress} {
   bma.intf = BMA4_I2C_INTF;
   bma.bus_read = user_i2c_read;
@@ -77,6 +83,33 @@ void Bma421::Init() {
   if (ret != BMA4_OK)
     return;
 
+  // Headerless FIFO: 6 bytes per frame, only accelerometer data
+  ret = bma4_set_fifo_config(BMA4_FIFO_HEADER, BMA4_DISABLE, &bma);
+  if (ret != BMA4_OK)
+    return;
+
+  ret = bma4_set_fifo_config(BMA4_FIFO_ACCEL, BMA4_ENABLE, &bma);
+  if (ret != BMA4_OK)
+    return;
+
+  ret = bma4_set_fifo_wm(fifoWatermark * fifoFrameSize, &bma);
+  if (ret != BMA4_OK)
+    return;
+
+  struct bma4_int_pin_config int_pin_conf;
+  int_pin_conf.edge_ctrl = BMA4_LEVEL_TRIGGER;
+  int_pin_conf.lvl = BMA4_ACTIVE_HIGH;
+  int_pin_conf.od = BMA4_PUSH_PULL;
+  int_pin_conf.output_en = BMA4_OUTPUT_ENABLE;
+  int_pin_conf.input_en = BMA4_INPUT_DISABLE;
+  ret = bma4_set_int_pin_config(&int_pin_conf, BMA4_INTR1_MAP, &bma);
+  if (ret != BMA4_OK)
+    return;
+
+  ret = bma4_map_interrupt(BMA4_INTR1_MAP, BMA4_FIFO_WM_INT, BMA4_ENABLE, &bma);
+  if (ret != BMA4_OK)
+    return;
+
   isOk = true;
 }
 
@@ -96,22 +129,42 @@ void Bma421::Write(uint8_t registerAddress, const uint8_t* data, size_t size) {
 Bma421::Values Bma421::Process() {
   if (not isOk)
     return {};
-  struct bma4_accel data;
-  bma4_read_accel_xyz(&data, &bma);
 
-  uint32_t steps = 0;
-  bma423_step_counter_output(&steps, &bma);
+  uint16_t fifoLength = 0;
+  bma4_get_fifo_length(&fifoLength, &bma);
 
-  int32_t temperature;
-  bma4_get_temperature(&temperature, BMA4_DEG, &bma);
-  temperature = temperature / 1000;
+  uint16_t length = std::min<uint16_t>(fifoLength, sizeof(samples));
+  length -= length % fifoFrameSize;
+  auto* frames = reinterpret_cast<uint8_t*>(samples);
+  if (length > 0) {
+    Read(BMA4_FIFO_DATA_ADDR, frames, length);
+  }
+  if (fifoLength > length) {
+    // Only happens if the FIFO was not drained for a while, keep the samples in order by dropping the rest
+    bma4_set_command_register(fifoFlushCommand, &bma);
+  }
+
+  // Reading the status clears the latched watermark interrupt
+  uint8_t status = 0;
+  bma4_read_int_status_1(&status, &bma);
+
+  uint8_t nbSamples = 0;
+  for (uint16_t i = 0; i < length; i += fifoFrameSize) {
+    // Each sample is written over its own frame, once it has been read
+    auto x = static_cast<int16_t>(frames[i] | (frames[i + 1] << 8));
+    auto y = static_cast<int16_t>(frames[i + 2] | (frames[i + 3] << 8));
+    auto z = static_cast<int16_t>(frames[i + 4] | (frames[i + 5] << 8));
+    // 12 bits values, left aligned, as returned by bma4_read_accel_xyz()
+    // X and Y axis are swapped because of the way the sensor is mounted in the PineTime
+    samples[nbSamples++] = {static_cast<int16_t>(y / 0x10), static_cast<int16_t>(x / 0x10), static_cast<int16_t>(z / 0x10)};
+  }
 
-  uint8_t activity = 0;
-  bma423_activity_output(&activity, &bma);
+  uint32_t steps = 0;
+  bma423_step_counter_output(&steps, &bma);
 
-  // X and Y axis are swapped because of the way the sensor is mounted in the PineTime
-  return {steps, data.y, data.x, data.z};
+  return {steps, samples, nbSamples};
 }
+
 bool Bma421::IsOk() const {
   return isOk;
 }
@@ -11,12 +11,24 @@ namespace Pinetime {
         BMA421,
         BMA425
       };
-      struct Values {
-        uint32_t steps;
+      struct Sample {
         int16_t x;
         int16_t y;
         int16_t z;
       };
+      /// The samples read from the FIFO, oldest first. They stay valid until the next call to Process().
+      struct Values {
+        uint32_t steps;
+        const Sample* samples;
+        uint8_t nbSamples;
+      };
+
+      static constexpr uint16_t sampleRate = 100; // Hz
+      /// The watermark interrupt is raised when the FIFO contains this many samples (250ms)
+      static constexpr uint8_t fifoWatermark = 25;
+      /// Number of samples read in a single burst: 252 bytes, the largest multiple of a FIFO frame a TWI transfer allows
+      static constexpr uint8_t maxSamples = 42;
+
       Bma421(TwiMaster& twiMaster, uint8_t twiAddress);
       Bma421(const Bma421&) = delete;
       Bma421& operator=(const Bma421&) = delete;
@@ -27,6 +39,7 @@ namespace Pinetime {
       /// Init() method to allow the caller to uninit and then reinit the TWI device after the softreset.
       void SoftReset();
       void Init();
+      /// Drains the FIFO in a single burst read and clears the watermark interrupt
       Values Process();
       void ResetStepCounter();
 
@@ -45,6 +58,9 @@ namespace Pinetime {
       bool isOk = false;
       bool isResetOk = false;
       DeviceTypes deviceType = DeviceTypes::Unknown;
+      static constexpr uint8_t fifoFrameSize = 6;
+      // The raw FIFO frames are decoded in place
+      Sample samples[maxSamples];
     };
   }
 }
\ No newline at end of file
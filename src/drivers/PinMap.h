@@ -17,6 +17,7 @@ namespace Pinetime {
     #endif
 
     static constexpr uint8_t Cst816sIrq = 28;
+    static constexpr uint8_t Bma421Irq = 8;
     static constexpr uint8_t PowerPresent = 19;
 
     static constexpr uint8_t Motor = 16;
@@ -2,6 +2,7 @@
 #include <hal/nrf_gpio.h>
 #include <hal/nrf_spim.h>
 #include <nrfx_log.h>
+#include "logging/Trace.h"
 #include <algorithm>
 
 using namespace Pinetime::Drivers;
@@ -129,27 +130,48 @@ void SpiMaster::OnEndEvent() {
 
   auto s = currentBufferSize;
   if (s > 0) {
-    auto currentSize = std::min((size_t) 255, s);
+    auto currentSize = std::min((size_t) MaxChunkSize, s);
     PrepareTx(currentBufferAddr, currentSize);
     currentBufferAddr += currentSize;
     currentBufferSize -= currentSize;
 
     spiBaseAddress->TASKS_START = 1;
   } else {
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    if (taskToNotify != nullptr) {
-      vTaskNotifyGiveFromISR(taskToNotify, &xHigherPriorityTaskWoken);
-      portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-    }
+    EndTransfer();
+  }
+}
 
-    nrf_gpio_pin_set(this->pinCsn);
-    currentBufferAddr = 0;
-    BaseType_t xHigherPriorityTaskWoken2 = pdFALSE;
-    xSemaphoreGiveFromISR(mutex, &xHigherPriorityTaskWoken2);
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken | xHigherPriorityTaskWoken2);
+void SpiMaster::OnStoppedEvent() {
+  if (!chainedTxRunning) {
+    return;
+  }
+
+  DisableChainedTx();
+
+  if (currentBufferSize > 0) {
+    // Send the remaining bytes that do not fill a whole chunk, the END event will complete the transfer
+    spiBaseAddress->INTENSET = ((unsigned) 1 << (unsigned) 6);
+    OnEndEvent();
+  } else {
+    EndTransfer();
   }
 }
 
+void SpiMaster::EndTransfer() {
+  Logging::Trace::End(Logging::Trace::Events::SpiWrite);
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  if (taskToNotify != nullptr) {
+    vTaskNotifyGiveFromISR(taskToNotify, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+  }
+
+  nrf_gpio_pin_set(this->pinCsn);
+  currentBufferAddr = 0;
+  BaseType_t xHigherPriorityTaskWoken2 = pdFALSE;
+  xSemaphoreGiveFromISR(mutex, &xHigherPriorityTaskWoken2);
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken | xHigherPriorityTaskWoken2);
+}
+
 void SpiMaster::OnStartedEvent() {
 }
 
@@ -163,6 +185,81 @@ void SpiMaster::PrepareTx(const volatile uint32_t bufferAddress, const volatile
   spiBaseAddress->EVENTS_END = 0;
 }
 
+size_t SpiMaster::ChainedChunkSize(size_t size) {
+  // Prefer a chunk size that divides the buffer so that the whole transfer is done by the chain.
+  // Display buffers are made of full lines of RGB565 pixels, so this is nearly always the case.
+  for (size_t chunkSize = MaxChunkSize; chunkSize >= MinChainedChunkSize; chunkSize--) {
+    if ((size % chunkSize) == 0) {
+      return chunkSize;
+    }
+  }
+  return MaxChunkSize;
+}
+
+void SpiMaster::PrepareChainedTx(const volatile uint32_t bufferAddress, size_t chunkSize, size_t nbChunks) {
+  spiBaseAddress->TXD.PTR = bufferAddress;
+  spiBaseAddress->TXD.MAXCNT = chunkSize;
+  spiBaseAddress->TXD.LIST = SPIM_TXD_LIST_LIST_ArrayList << SPIM_TXD_LIST_LIST_Pos;
+  spiBaseAddress->RXD.PTR = 0;
+  spiBaseAddress->RXD.MAXCNT = 0;
+  spiBaseAddress->RXD.LIST = 0;
+  spiBaseAddress->EVENTS_END = 0;
+  spiBaseAddress->EVENTS_STOPPED = 0;
+
+  // Only the STOPPED event (end of the chain) generates an interrupt
+  spiBaseAddress->INTENCLR = ((unsigned) 1 << (unsigned) 6);
+  spiBaseAddress->INTENCLR = ((unsigned) 1 << (unsigned) 19);
+  spiBaseAddress->INTENSET = ((unsigned) 1 << (unsigned) 1);
+
+  // TIMER2 counts the END events of the chunks
+  NRF_TIMER2->TASKS_STOP = 1;
+  NRF_TIMER2->TASKS_CLEAR = 1;
+  NRF_TIMER2->MODE = TIMER_MODE_MODE_Counter << TIMER_MODE_MODE_Pos;
+  NRF_TIMER2->BITMODE = TIMER_BITMODE_BITMODE_16Bit << TIMER_BITMODE_BITMODE_Pos;
+  NRF_TIMER2->CC[0] = nbChunks - 1;
+  NRF_TIMER2->EVENTS_COMPARE[0] = 0;
+  NRF_TIMER2->INTENCLR = 0xffffffff;
+  NRF_TIMER2->TASKS_START = 1;
+
+  // END -> START of the next chunk + count
+  NRF_PPI->CH[ppiChannelRestart].EEP = (uint32_t) &spiBaseAddress->EVENTS_END;
+  NRF_PPI->CH[ppiChannelRestart].TEP = (uint32_t) &spiBaseAddress->TASKS_START;
+  NRF_PPI->FORK[ppiChannelRestart].TEP = (uint32_t) &NRF_TIMER2->TASKS_COUNT;
+
+  // The last chunk has been started : disable the restart channel and enable the stop channel
+  NRF_PPI->CH[ppiChannelLastChunk].EEP = (uint32_t) &NRF_TIMER2->EVENTS_COMPARE[0];
+  NRF_PPI->CH[ppiChannelLastChunk].TEP = (uint32_t) &NRF_PPI->TASKS_CHG[ppiGroupRestart].DIS;
+  NRF_PPI->FORK[ppiChannelLastChunk].TEP = (uint32_t) &NRF_PPI->TASKS_CHG[ppiGroupStop].EN;
+
+  // END of the last chunk -> STOP
+  NRF_PPI->CH[ppiChannelStop].EEP = (uint32_t) &spiBaseAddress->EVENTS_END;
+  NRF_PPI->CH[ppiChannelStop].TEP = (uint32_t) &spiBaseAddress->TASKS_STOP;
+
+  NRF_PPI->CHG[ppiGroupRestart] = 1U << ppiChannelRestart;
+  NRF_PPI->CHG[ppiGroupStop] = 1U << ppiChannelStop;
+  NRF_PPI->CHENCLR = 1U << ppiChannelStop;
+  NRF_PPI->CHENSET = (1U << ppiChannelRestart) | (1U << ppiChannelLastChunk);
+
+  chainedTxRunning = true;
+}
+
+void SpiMaster::DisableChainedTx() {
+  NRF_PPI->CHENCLR = (1U << ppiChannelRestart) | (1U << ppiChannelLastChunk) | (1U << ppiChannelStop);
+  NRF_PPI->CHG[ppiGroupRestart] = 0;
+  NRF_PPI->CHG[ppiGroupStop] = 0;
+  NRF_PPI->FORK[ppiChannelRestart].TEP = 0;
+  NRF_PPI->FORK[ppiChannelLastChunk].TEP = 0;
+
+  NRF_TIMER2->TASKS_STOP = 1;
+  NRF_TIMER2->TASKS_CLEAR = 1;
+  NRF_TIMER2->EVENTS_COMPARE[0] = 0;
+
+  spiBaseAddress->TXD.LIST = 0;
+  spiBaseAddress->EVENTS_END = 0;
+  spiBaseAddress->INTENSET = ((unsigned) 1 << (unsigned) 19);
+  chainedTxRunning = false;
+}
+
 void SpiMaster::PrepareRx(const volatile uint32_t cmdAddress,
                           const volatile size_t cmdSize,
                           const volatile uint32_t bufferAddress,
@@ -182,6 +279,7 @@ bool SpiMaster::Write(uint8_t pinCsn, const uint8_t* data, size_t size) {
   auto ok = xSemaphoreTake(mutex, portMAX_DELAY);
   ASSERT(ok == true);
   taskToNotify = xTaskGetCurrentTaskHandle();
+  Logging::Trace::Begin(Logging::Trace::Events::SpiWrite, static_cast<uint16_t>(size));
 
   this->pinCsn = pinCsn;
 
@@ -196,10 +294,23 @@ bool SpiMaster::Write(uint8_t pinCsn, const uint8_t* data, size_t size) {
   currentBufferAddr = (uint32_t) data;
   currentBufferSize = size;
 
-  auto currentSize = std::min((size_t) 255, (size_t) currentBufferSize);
-  PrepareTx(currentBufferAddr, currentSize);
-  currentBufferSize -= currentSize;
-  currentBufferAddr += currentSize;
+  size_t chunkSize = 0;
+  size_t nbChunks = 0;
+  if (size > MaxChunkSize) {
+    chunkSize = ChainedChunkSize(size);
+    nbChunks = size / chunkSize;
+  }
+
+  if (nbChunks > 1) {
+    PrepareChainedTx(currentBufferAddr, chunkSize, nbChunks);
+    currentBufferSize -= chunkSize * nbChunks;
+    currentBufferAddr += chunkSize * nbChunks;
+  } else {
+    auto currentSize = std::min((size_t) MaxChunkSize, (size_t) currentBufferSize);
+    PrepareTx(currentBufferAddr, currentSize);
+    currentBufferSize -= currentSize;
+    currentBufferAddr += currentSize;
+  }
   spiBaseAddress->TASKS_START = 1;
 
   if (size == 1) {
@@ -207,6 +318,7 @@ bool SpiMaster::Write(uint8_t pinCsn, const uint8_t* data, size_t size) {
       ;
     nrf_gpio_pin_set(this->pinCsn);
     currentBufferAddr = 0;
+    Logging::Trace::End(Logging::Trace::Events::SpiWrite);
     xSemaphoreGive(mutex);
   }
 
@@ -215,6 +327,7 @@ bool SpiMaster::Write(uint8_t pinCsn, const uint8_t* data, size_t size) {
 
 bool SpiMaster::Read(uint8_t pinCsn, uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize) {
   xSemaphoreTake(mutex, portMAX_DELAY);
+  Logging::Trace::Scope trace {Logging::Trace::Events::SpiRead, static_cast<uint16_t>(dataSize)};
 
   taskToNotify = nullptr;
 
@@ -234,11 +347,17 @@ bool SpiMaster::Read(uint8_t pinCsn, uint8_t* cmd, size_t cmdSize, uint8_t* data
   while (spiBaseAddress->EVENTS_END == 0)
     ;
 
-  PrepareRx((uint32_t) cmd, cmdSize, (uint32_t) data, dataSize);
-  spiBaseAddress->TASKS_START = 1;
+  // The memory keeps sending data as long as CS is low, so bigger reads are split in chunks of MaxChunkSize bytes
+  do {
+    auto currentSize = std::min((size_t) MaxChunkSize, dataSize);
+    PrepareRx((uint32_t) cmd, cmdSize, (uint32_t) data, currentSize);
+    spiBaseAddress->TASKS_START = 1;
 
-  while (spiBaseAddress->EVENTS_END == 0)
-    ;
+    while (spiBaseAddress->EVENTS_END == 0)
+      ;
+    data += currentSize;
+    dataSize -= currentSize;
+  } while (dataSize > 0);
   nrf_gpio_pin_set(this->pinCsn);
 
   xSemaphoreGive(mutex);
@@ -264,6 +383,7 @@ void SpiMaster::Wakeup() {
 
 bool SpiMaster::WriteCmdAndBuffer(uint8_t pinCsn, const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize) {
   xSemaphoreTake(mutex, portMAX_DELAY);
+  Logging::Trace::Scope trace {Logging::Trace::Events::SpiWriteBuffer, static_cast<uint16_t>(dataSize)};
 
   taskToNotify = nullptr;
 
@@ -283,11 +403,16 @@ bool SpiMaster::WriteCmdAndBuffer(uint8_t pinCsn, const uint8_t* cmd, size_t cmd
   while (spiBaseAddress->EVENTS_END == 0)
     ;
 
-  PrepareTx((uint32_t) data, dataSize);
-  spiBaseAddress->TASKS_START = 1;
+  do {
+    auto currentSize = std::min((size_t) MaxChunkSize, dataSize);
+    PrepareTx((uint32_t) data, currentSize);
+    spiBaseAddress->TASKS_START = 1;
 
-  while (spiBaseAddress->EVENTS_END == 0)
-    ;
+    while (spiBaseAddress->EVENTS_END == 0)
+      ;
+    data += currentSize;
+    dataSize -= currentSize;
+  } while (dataSize > 0);
   nrf_gpio_pin_set(this->pinCsn);
 
   xSemaphoreGive(mutex);
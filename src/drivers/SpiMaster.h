@@ -37,6 +37,7 @@ namespace Pinetime {
 
       void OnStartedEvent();
       void OnEndEvent();
+      void OnStoppedEvent();
 
       void Sleep();
       void Wakeup();
@@ -45,6 +46,10 @@ namespace Pinetime {
       void SetupWorkaroundForFtpan58(NRF_SPIM_Type* spim, uint32_t ppi_channel, uint32_t gpiote_channel);
       void DisableWorkaroundForFtpan58(NRF_SPIM_Type* spim, uint32_t ppi_channel, uint32_t gpiote_channel);
       void PrepareTx(const volatile uint32_t bufferAddress, const volatile size_t size);
+      void PrepareChainedTx(const volatile uint32_t bufferAddress, size_t chunkSize, size_t nbChunks);
+      void DisableChainedTx();
+      void EndTransfer();
+      static size_t ChainedChunkSize(size_t size);
       void PrepareRx(const volatile uint32_t cmdAddress,
                      const volatile size_t cmdSize,
                      const volatile uint32_t bufferAddress,
@@ -59,7 +64,21 @@ namespace Pinetime {
       volatile uint32_t currentBufferAddr = 0;
       volatile size_t currentBufferSize = 0;
       volatile TaskHandle_t taskToNotify;
+      volatile bool chainedTxRunning = false;
       SemaphoreHandle_t mutex = nullptr;
+
+      // EasyDMA can only transfer 255 bytes at once (MAXCNT is 8 bits on the nRF52832).
+      // Bigger buffers are sent as a chain of equally sized chunks using the TXD.LIST array list mode :
+      // the END event of each chunk restarts the SPIM (PPI) and is counted by a timer, which swaps
+      // the restart channel for a STOP channel before the last chunk. Only the final STOPPED event
+      // raises an interrupt.
+      static constexpr size_t MaxChunkSize = 255;
+      static constexpr size_t MinChainedChunkSize = 128;
+      static constexpr uint8_t ppiChannelRestart = 1;
+      static constexpr uint8_t ppiChannelLastChunk = 2;
+      static constexpr uint8_t ppiChannelStop = 3;
+      static constexpr uint8_t ppiGroupRestart = 0;
+      static constexpr uint8_t ppiGroupStop = 1;
     };
   }
 }
@@ -1,15 +1,33 @@
 #include "drivers/SpiNorFlash.h"
+#include <algorithm>
+#include <cstring>
 #include <hal/nrf_gpio.h>
 #include <libraries/delay/nrf_delay.h>
 #include <libraries/log/nrf_log.h>
+#include <task.h>
 #include "drivers/Spi.h"
+#include "utility/LockGuard.h"
 
 using namespace Pinetime::Drivers;
+using Pinetime::Utility::RecursiveLockGuard;
+
+namespace {
+  void ProgramTimerCallback(TimerHandle_t xTimer) {
+    auto* spiNorFlash = static_cast<SpiNorFlash*>(pvTimerGetTimerID(xTimer));
+    spiNorFlash->OnProgramTimer();
+  }
+}
 
 SpiNorFlash::SpiNorFlash(Spi& spi) : spi {spi} {
 }
 
 void SpiNorFlash::Init() {
+  if (mutex == nullptr) {
+    mutex = xSemaphoreCreateRecursiveMutex();
+    ASSERT(mutex != nullptr);
+    programTimer = xTimerCreate("flashProgram", 1, pdFALSE, this, ProgramTimerCallback);
+    ASSERT(programTimer != nullptr);
+  }
   device_id = ReadIdentificaion();
   NRF_LOG_INFO(
     "[SpiNorFlash] Manufacturer : %d, Memory type : %d, memory density : %d", device_id.manufacturer, device_id.type, device_id.density);
@@ -19,12 +37,15 @@ void SpiNorFlash::Uninit() {
 }
 
 void SpiNorFlash::Sleep() {
+  RecursiveLockGuard lock {mutex};
+  WaitForCompletion();
   auto cmd = static_cast<uint8_t>(Commands::DeepPowerDown);
   spi.Write(&cmd, sizeof(uint8_t));
   NRF_LOG_INFO("[SpiNorFlash] Sleep")
 }
 
 void SpiNorFlash::Wakeup() {
+  RecursiveLockGuard lock {mutex};
   // send Commands::ReleaseFromDeepPowerDown then 3 dummy bytes before reading Device ID
   static constexpr uint8_t cmdSize = 4;
   uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::ReleaseFromDeepPowerDown), 0x01, 0x02, 0x03};
@@ -69,6 +90,20 @@ uint8_t SpiNorFlash::ReadConfigurationRegister() {
 }
 
 void SpiNorFlash::Read(uint32_t address, uint8_t* buffer, size_t size) {
+  RecursiveLockGuard lock {mutex};
+  // The data can be read during an erase if they are not in the sector being erased,
+  // the queued pages must be programmed before they are read back
+  WaitForProgram();
+  if (pendingOperation == PendingOperations::Erase && !IsBeingErased(address, size) && !IsQueued(address, size) && SuspendErase()) {
+    ReadData(address, buffer, size);
+    ResumeErase();
+  } else {
+    WaitForCompletion();
+    ReadData(address, buffer, size);
+  }
+}
+
+void SpiNorFlash::ReadData(uint32_t address, uint8_t* buffer, size_t size) {
   static constexpr uint8_t cmdSize = 4;
   uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::Read), (uint8_t) (address >> 16U), (uint8_t) (address >> 8U), (uint8_t) address};
   spi.Read(reinterpret_cast<uint8_t*>(&cmd), cmdSize, buffer, size);
@@ -80,20 +115,141 @@ void SpiNorFlash::WriteEnable() {
 }
 
 void SpiNorFlash::SectorErase(uint32_t sectorAddress) {
+  RecursiveLockGuard lock {mutex};
+  StartSectorErase(sectorAddress);
+  WaitForCompletion();
+}
+
+void SpiNorFlash::StartSectorErase(uint32_t sectorAddress) {
+  RecursiveLockGuard lock {mutex};
+  StartErase(Commands::SectorErase, sectorAddress & ~(sectorSize - 1u), sectorSize);
+}
+
+void SpiNorFlash::Erase(uint32_t address, size_t size) {
+  RecursiveLockGuard lock {mutex};
+  uint32_t end = address + size;
+  address &= ~(sectorSize - 1u);
+  while (address < end) {
+    address += StartErase(address, end - address);
+  }
+  WaitForCompletion();
+}
+
+size_t SpiNorFlash::StartErase(uint32_t address, size_t size) {
+  RecursiveLockGuard lock {mutex};
+  // Erase the biggest aligned block that fits in the range : a block erase is much faster than
+  // erasing all its sectors one by one.
+  if ((address % block64KBSize) == 0 && size >= block64KBSize) {
+    StartErase(Commands::BlockErase64KB, address, block64KBSize);
+    return block64KBSize;
+  }
+  if ((address % block32KBSize) == 0 && size >= block32KBSize) {
+    StartErase(Commands::BlockErase32KB, address, block32KBSize);
+    return block32KBSize;
+  }
+  StartErase(Commands::SectorErase, address & ~(sectorSize - 1u), sectorSize);
+  return sectorSize;
+}
+
+void SpiNorFlash::StartErase(Commands command, uint32_t address, size_t size) {
   static constexpr uint8_t cmdSize = 4;
-  uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::SectorErase),
-                          (uint8_t) (sectorAddress >> 16U),
-                          (uint8_t) (sectorAddress >> 8U),
-                          (uint8_t) sectorAddress};
+  uint8_t cmd[cmdSize] = {static_cast<uint8_t>(command), (uint8_t) (address >> 16U), (uint8_t) (address >> 8U), (uint8_t) address};
 
+  // The queued pages that are not erased are programmed during the erase
+  if (IsQueued(address, size)) {
+    WaitForCompletion();
+  } else {
+    WaitWhileBusy();
+  }
   WriteEnable();
-  while (!WriteEnabled())
-    vTaskDelay(1);
-
   spi.Read(reinterpret_cast<uint8_t*>(&cmd), cmdSize, nullptr, 0);
+  pendingOperation = PendingOperations::Erase;
+  erasingAddress = address;
+  erasingSize = size;
+}
+
+bool SpiNorFlash::IsBeingErased(uint32_t address, size_t size) const {
+  return (address < erasingAddress + erasingSize) && (address + size > erasingAddress);
+}
+
+bool SpiNorFlash::IsErasing() {
+  RecursiveLockGuard lock {mutex};
+  return IsBusy() && (pendingOperation == PendingOperations::Erase || pendingOperation == PendingOperations::ProgramDuringErase);
+}
+
+bool SpiNorFlash::IsBusy() {
+  RecursiveLockGuard lock {mutex};
+  if (pendingOperation != PendingOperations::None && !WriteInProgress()) {
+    if (pendingOperation == PendingOperations::Program) {
+      CheckProgramStatus();
+      pendingOperation = PendingOperations::None;
+    } else if (pendingOperation == PendingOperations::ProgramDuringErase) {
+      CheckProgramStatus();
+      ResumeErase();
+      pendingOperation = PendingOperations::Erase;
+    } else {
+      pendingOperation = PendingOperations::None;
+    }
+  }
+  return pendingOperation != PendingOperations::None;
+}
+
+void SpiNorFlash::WaitForCompletion() {
+  RecursiveLockGuard lock {mutex};
+  while (queueCount > 0 || IsBusy()) {
+    WaitWhileBusy();
+    ProgramNextPage();
+  }
+}
 
-  while (WriteInProgress())
+void SpiNorFlash::WaitForProgram() {
+  // The memory has no ready/busy output, the status register must be polled.
+  // A page is programmed in less than a tick : it is polled without blocking.
+  while ((pendingOperation == PendingOperations::Program || pendingOperation == PendingOperations::ProgramDuringErase) && IsBusy()) {
+    nrf_delay_us(programPollPeriod);
+  }
+}
+
+void SpiNorFlash::WaitWhileBusy() {
+  WaitForProgram();
+  // Block between two polls of an erase : DFU runs in the BLE host task, which has a higher priority than the
+  // other tasks and would starve them if it only yielded.
+  while (IsBusy()) {
     vTaskDelay(1);
+  }
+}
+
+bool SpiNorFlash::SuspendErase() {
+  if (!IsBusy()) {
+    return false;
+  }
+
+  // The erase would never complete if it was suspended again right after each resume.
+  // The tick count can't measure tRS, it only tells when a whole tick has elapsed since the resume.
+  if (xTaskGetTickCount() - resumeTick < 2) {
+    nrf_delay_us(resumeToSuspendTime);
+  }
+
+  auto cmd = static_cast<uint8_t>(Commands::EraseSuspend);
+  spi.Read(&cmd, sizeof(cmd), nullptr, 0);
+
+  // The memory is ready to be read when WIP is cleared
+  for (uint32_t waited = 0; WriteInProgress(); waited += suspendPollPeriod) {
+    if (waited >= suspendTimeout) {
+      // The suspend was not accepted : the caller waits for the end of the erase instead.
+      // Resume in case the suspend is accepted late, the erase would never complete otherwise.
+      ResumeErase();
+      return false;
+    }
+    nrf_delay_us(suspendPollPeriod);
+  }
+  return true;
+}
+
+void SpiNorFlash::ResumeErase() {
+  auto cmd = static_cast<uint8_t>(Commands::EraseResume);
+  spi.Read(&cmd, sizeof(cmd), nullptr, 0);
+  resumeTick = xTaskGetTickCount();
 }
 
 uint8_t SpiNorFlash::ReadSecurityRegister() {
@@ -104,36 +260,107 @@ uint8_t SpiNorFlash::ReadSecurityRegister() {
 }
 
 bool SpiNorFlash::ProgramFailed() {
-  return (ReadSecurityRegister() & 0x20u) == 0x20u;
+  RecursiveLockGuard lock {mutex};
+  WaitForCompletion();
+  bool failed = programFailed;
+  programFailed = false;
+  return failed;
+}
+
+void SpiNorFlash::CheckProgramStatus() {
+  // The status of a program is only kept until the next one
+  programFailed |= (ReadSecurityRegister() & 0x20u) == 0x20u;
 }
 
 bool SpiNorFlash::EraseFailed() {
+  RecursiveLockGuard lock {mutex};
+  WaitForCompletion();
   return (ReadSecurityRegister() & 0x40u) == 0x40u;
 }
 
 void SpiNorFlash::Write(uint32_t address, const uint8_t* buffer, size_t size) {
-  static constexpr uint8_t cmdSize = 4;
+  RecursiveLockGuard lock {mutex};
+  while (size > 0) {
+    uint32_t pageLimit = (address & ~(pageSize - 1u)) + pageSize;
+    size_t toWrite = std::min<size_t>(pageLimit - address, size);
 
-  size_t len = size;
-  uint32_t addr = address;
-  const uint8_t* b = buffer;
-  while (len > 0) {
-    uint32_t pageLimit = (addr & ~(pageSize - 1u)) + pageSize;
-    uint32_t toWrite = pageLimit - addr > len ? len : pageLimit - addr;
+    // The oldest page is programmed as soon as the memory can take it, even during an erase
+    while (queueCount == queueSize) {
+      WaitForProgram();
+      if (!ProgramNextPage()) {
+        WaitWhileBusy();
+      }
+    }
+    Page& page = queue[(queueHead + queueCount) % queueSize];
+    page.address = address;
+    page.size = toWrite;
+    std::memcpy(page.data, buffer, toWrite);
+    queueCount++;
+    ProgramNextPage();
 
-    uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::PageProgram), (uint8_t) (addr >> 16U), (uint8_t) (addr >> 8U), (uint8_t) addr};
+    address += toWrite;
+    buffer += toWrite;
+    size -= toWrite;
+  }
 
+  if (queueCount > 0 || pendingOperation == PendingOperations::ProgramDuringErase) {
+    xTimerStart(programTimer, 0);
+  }
+}
+
+bool SpiNorFlash::ProgramNextPage() {
+  if (queueCount == 0) {
+    return false;
+  }
+
+  const Page& page = queue[queueHead];
+  static constexpr uint8_t cmdSize = 4;
+  uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::PageProgram),
+                          (uint8_t) (page.address >> 16U),
+                          (uint8_t) (page.address >> 8U),
+                          (uint8_t) page.address};
+
+  if (IsBusy()) {
+    // Like the reads, the pages outside of the sector being erased can be programmed during an erase :
+    // a DFU does not have to wait for the erase of the next block to write the data it receives.
+    if (pendingOperation != PendingOperations::Erase || IsBeingErased(page.address, page.size) || !SuspendErase()) {
+      return false;
+    }
+    WriteEnable();
+    spi.WriteCmdAndBuffer(cmd, cmdSize, page.data, page.size);
+    pendingOperation = PendingOperations::ProgramDuringErase;
+  } else {
     WriteEnable();
-    while (!WriteEnabled())
-      vTaskDelay(1);
+    spi.WriteCmdAndBuffer(cmd, cmdSize, page.data, page.size);
+    pendingOperation = PendingOperations::Program;
+  }
 
-    spi.WriteCmdAndBuffer(cmd, cmdSize, b, toWrite);
+  queueHead = (queueHead + 1) % queueSize;
+  queueCount--;
+  return true;
+}
 
-    while (WriteInProgress())
-      vTaskDelay(1);
+bool SpiNorFlash::IsQueued(uint32_t address, size_t size) const {
+  for (uint8_t i = 0; i < queueCount; i++) {
+    const Page& page = queue[(queueHead + i) % queueSize];
+    if (address < page.address + page.size && address + size > page.address) {
+      return true;
+    }
+  }
+  return false;
+}
 
-    addr += toWrite;
-    b += toWrite;
-    len -= toWrite;
+void SpiNorFlash::OnProgramTimer() {
+  // The timer task must not block : if the mutex is taken, its owner programs the queue or the timer polls it again
+  if (xSemaphoreTakeRecursive(mutex, 0) != pdTRUE) {
+    xTimerStart(programTimer, 0);
+    return;
+  }
+  // Resumes the erase if a page was programmed while it was suspended
+  IsBusy();
+  ProgramNextPage();
+  if (queueCount > 0 || pendingOperation == PendingOperations::ProgramDuringErase) {
+    xTimerStart(programTimer, 0);
   }
+  xSemaphoreGiveRecursive(mutex);
 }
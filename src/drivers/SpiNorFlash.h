@@ -1,6 +1,9 @@
 #pragma once
 #include <cstddef>
 #include <cstdint>
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include <timers.h>
 
 namespace Pinetime {
   namespace Drivers {
@@ -28,7 +31,14 @@ namespace Pinetime {
       void Write(uint32_t address, const uint8_t* buffer, size_t size);
       void WriteEnable();
       void SectorErase(uint32_t sectorAddress);
+      void StartSectorErase(uint32_t sectorAddress);
+      void Erase(uint32_t address, size_t size);
+      size_t StartErase(uint32_t address, size_t size);
+      bool IsBusy();
+      bool IsErasing();
+      void WaitForCompletion();
       uint8_t ReadSecurityRegister();
+      // Returns true if a page program failed since the previous call
       bool ProgramFailed();
       bool EraseFailed();
 
@@ -38,6 +48,8 @@ namespace Pinetime {
       void Sleep();
       void Wakeup();
 
+      void OnProgramTimer();
+
     private:
       enum class Commands : uint8_t {
         PageProgram = 0x02,
@@ -46,13 +58,66 @@ namespace Pinetime {
         WriteEnable = 0x06,
         ReadConfigurationRegister = 0x15,
         SectorErase = 0x20,
+        BlockErase32KB = 0x52,
         ReadSecurityRegister = 0x2B,
+        EraseSuspend = 0x75,
+        EraseResume = 0x7A,
         ReadIdentification = 0x9F,
         ReleaseFromDeepPowerDown = 0xAB,
-        DeepPowerDown = 0xB9
+        DeepPowerDown = 0xB9,
+        BlockErase64KB = 0xD8
       };
       static constexpr uint16_t pageSize = 256;
 
+      void ReadData(uint32_t address, uint8_t* buffer, size_t size);
+      bool SuspendErase();
+      void ResumeErase();
+      void StartErase(Commands command, uint32_t address, size_t size);
+      bool IsBeingErased(uint32_t address, size_t size) const;
+      void WaitForProgram();
+      void WaitWhileBusy();
+      bool ProgramNextPage();
+      bool IsQueued(uint32_t address, size_t size) const;
+      void CheckProgramStatus();
+
+      // Program and erase operations are started without waiting for their completion : the memory
+      // works in background and the next operation waits for it only if needed.
+      // ProgramDuringErase : a page is programmed while the erase is suspended, the erase is resumed when it completes.
+      enum class PendingOperations : uint8_t { None, Program, Erase, ProgramDuringErase };
+      PendingOperations pendingOperation = PendingOperations::None;
+      uint32_t erasingAddress = 0;
+      size_t erasingSize = 0;
+      static constexpr uint32_t sectorSize = 0x1000;
+      static constexpr uint32_t block32KBSize = 0x8000;
+      static constexpr uint32_t block64KBSize = 0x10000;
+
+      // Write() only queues the pages : they are programmed one after the other by the callers that wait for the
+      // memory and by the program timer, which polls the memory every tick (about the page program time).
+      // The caller waits only when the queue is full.
+      struct Page {
+        uint32_t address;
+        uint16_t size;
+        uint8_t data[pageSize];
+      };
+      static constexpr uint8_t queueSize = 4;
+      Page queue[queueSize];
+      uint8_t queueHead = 0;
+      uint8_t queueCount = 0;
+      TimerHandle_t programTimer = nullptr;
+      bool programFailed = false;
+
+      // Timings of the datasheet, in µs
+      static constexpr uint32_t programPollPeriod = 50;    // A page is programmed in 0.6 to 3ms (tPP)
+      static constexpr uint32_t suspendTimeout = 100;      // WIP is cleared at most 30µs after a suspend (tSUS)
+      static constexpr uint32_t suspendPollPeriod = 5;
+      static constexpr uint32_t resumeToSuspendTime = 100; // An erase must run this long after a resume (tRS)
+      TickType_t resumeTick = 0;
+
+      // The flash memory is shared by DFU (BLE host task) and the filesystem (SystemTask and DisplayApp) :
+      // the pending operation and the suspend/read/resume sequences are only accessed with this mutex taken.
+      // It is recursive because the public operations call each other.
+      SemaphoreHandle_t mutex = nullptr;
+
       Spi& spi;
       Identification device_id;
     };
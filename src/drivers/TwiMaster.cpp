@@ -2,12 +2,10 @@
 #include <cstring>
 #include <hal/nrf_gpio.h>
 #include <nrfx_log.h>
+#include "logging/Trace.h"
 
 using namespace Pinetime::Drivers;
 
-// TODO use shortcut to automatically send STOP when receive LastTX, for example
-// TODO use DMA/IRQ
-
 TwiMaster::TwiMaster(NRF_TWIM_Type* module, uint32_t frequency, uint8_t pinSda, uint8_t pinScl)
   : module {module}, frequency {frequency}, pinSda {pinSda}, pinScl {pinScl} {
 }
@@ -32,6 +30,9 @@ void TwiMaster::Init() {
   if (mutex == nullptr) {
     mutex = xSemaphoreCreateBinary();
   }
+  if (transferDone == nullptr) {
+    transferDone = xSemaphoreCreateBinary();
+  }
 
   ConfigurePins();
 
@@ -49,118 +50,86 @@ void TwiMaster::Init() {
   twiBaseAddress->EVENTS_SUSPENDED = 0;
   twiBaseAddress->EVENTS_TXSTARTED = 0;
 
+  twiBaseAddress->INTENSET = TWIM_INTENSET_STOPPED_Msk | TWIM_INTENSET_ERROR_Msk;
+  NRFX_IRQ_PRIORITY_SET(SPIM1_SPIS1_TWIM1_TWIS1_SPI1_TWI1_IRQn, 2);
+  NRFX_IRQ_ENABLE(SPIM1_SPIS1_TWIM1_TWIS1_SPI1_TWI1_IRQn);
+
   twiBaseAddress->ENABLE = (TWIM_ENABLE_ENABLE_Enabled << TWIM_ENABLE_ENABLE_Pos);
 
   xSemaphoreGive(mutex);
 }
 
 TwiMaster::ErrorCodes TwiMaster::Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t* data, size_t size) {
+  if (size > maxTransferSize) {
+    return ErrorCodes::TransactionFailed;
+  }
   xSemaphoreTake(mutex, portMAX_DELAY);
+  Logging::Trace::Scope trace {Logging::Trace::Events::TwiRead, static_cast<uint16_t>((deviceAddress << 8) | size)};
   Wakeup();
-  auto ret = Write(deviceAddress, &registerAddress, 1, false);
-  ret = Read(deviceAddress, data, size, true);
+  auto ret = Transfer(deviceAddress, &registerAddress, registerSize, data, size);
   Sleep();
   xSemaphoreGive(mutex);
   return ret;
 }
 
 TwiMaster::ErrorCodes TwiMaster::Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t* data, size_t size) {
-  ASSERT(size <= maxDataSize);
+  ASSERT(size <= maxWriteSize);
   xSemaphoreTake(mutex, portMAX_DELAY);
+  Logging::Trace::Scope trace {Logging::Trace::Events::TwiWrite, static_cast<uint16_t>((deviceAddress << 8) | size)};
   Wakeup();
   internalBuffer[0] = registerAddress;
-  std::memcpy(internalBuffer + 1, data, size);
-  auto ret = Write(deviceAddress, internalBuffer, size + 1, true);
+  std::memcpy(internalBuffer + registerSize, data, size);
+  auto ret = Transfer(deviceAddress, internalBuffer, size + registerSize, nullptr, 0);
   Sleep();
   xSemaphoreGive(mutex);
   return ret;
 }
 
-TwiMaster::ErrorCodes TwiMaster::Read(uint8_t deviceAddress, uint8_t* buffer, size_t size, bool stop) {
+// Sends txData then, if rxSize is not 0, receives rxData after a repeated start.
+// The shortcuts chain the whole transaction in hardware: the only interrupt is STOPPED (or ERROR).
+TwiMaster::ErrorCodes TwiMaster::Transfer(uint8_t deviceAddress, const uint8_t* txData, size_t txSize, uint8_t* rxData, size_t rxSize) {
   twiBaseAddress->ADDRESS = deviceAddress;
-  twiBaseAddress->TASKS_RESUME = 0x1UL;
-  twiBaseAddress->RXD.PTR = (uint32_t) buffer;
-  twiBaseAddress->RXD.MAXCNT = size;
-
-  twiBaseAddress->TASKS_STARTRX = 1;
-
-  while (!twiBaseAddress->EVENTS_RXSTARTED && !twiBaseAddress->EVENTS_ERROR)
-    ;
-  twiBaseAddress->EVENTS_RXSTARTED = 0x0UL;
-
-  txStartedCycleCount = DWT->CYCCNT;
-  uint32_t currentCycleCount;
-  while (!twiBaseAddress->EVENTS_LASTRX && !twiBaseAddress->EVENTS_ERROR) {
-    currentCycleCount = DWT->CYCCNT;
-    if ((currentCycleCount - txStartedCycleCount) > HwFreezedDelay) {
-      FixHwFreezed();
-      return ErrorCodes::TransactionFailed;
-    }
-  }
-  twiBaseAddress->EVENTS_LASTRX = 0x0UL;
-
-  if (stop || twiBaseAddress->EVENTS_ERROR) {
-    twiBaseAddress->TASKS_STOP = 0x1UL;
-    while (!twiBaseAddress->EVENTS_STOPPED)
-      ;
-    twiBaseAddress->EVENTS_STOPPED = 0x0UL;
+  twiBaseAddress->TXD.PTR = (uint32_t) txData;
+  twiBaseAddress->TXD.MAXCNT = txSize;
+  if (rxSize > 0) {
+    twiBaseAddress->RXD.PTR = (uint32_t) rxData;
+    twiBaseAddress->RXD.MAXCNT = rxSize;
+    twiBaseAddress->SHORTS = TWIM_SHORTS_LASTTX_STARTRX_Msk | TWIM_SHORTS_LASTRX_STOP_Msk;
   } else {
-    twiBaseAddress->TASKS_SUSPEND = 0x1UL;
-    while (!twiBaseAddress->EVENTS_SUSPENDED)
-      ;
-    twiBaseAddress->EVENTS_SUSPENDED = 0x0UL;
-  }
-
-  if (twiBaseAddress->EVENTS_ERROR) {
-    twiBaseAddress->EVENTS_ERROR = 0x0UL;
+    twiBaseAddress->SHORTS = TWIM_SHORTS_LASTTX_STOP_Msk;
   }
-  return ErrorCodes::NoError;
-}
 
-TwiMaster::ErrorCodes TwiMaster::Write(uint8_t deviceAddress, const uint8_t* data, size_t size, bool stop) {
-  twiBaseAddress->ADDRESS = deviceAddress;
+  transferFailed = false;
+  xSemaphoreTake(transferDone, 0);
   twiBaseAddress->TASKS_RESUME = 0x1UL;
-  twiBaseAddress->TXD.PTR = (uint32_t) data;
-  twiBaseAddress->TXD.MAXCNT = size;
-
-  twiBaseAddress->TASKS_STARTTX = 1;
-
-  while (!twiBaseAddress->EVENTS_TXSTARTED && !twiBaseAddress->EVENTS_ERROR)
-    ;
-  twiBaseAddress->EVENTS_TXSTARTED = 0x0UL;
-
-  txStartedCycleCount = DWT->CYCCNT;
-  uint32_t currentCycleCount;
-  while (!twiBaseAddress->EVENTS_LASTTX && !twiBaseAddress->EVENTS_ERROR) {
-    currentCycleCount = DWT->CYCCNT;
-    if ((currentCycleCount - txStartedCycleCount) > HwFreezedDelay) {
-      FixHwFreezed();
-      return ErrorCodes::TransactionFailed;
-    }
-  }
-  twiBaseAddress->EVENTS_LASTTX = 0x0UL;
+  twiBaseAddress->TASKS_STARTTX = 0x1UL;
 
-  if (stop || twiBaseAddress->EVENTS_ERROR) {
-    twiBaseAddress->TASKS_STOP = 0x1UL;
-    while (!twiBaseAddress->EVENTS_STOPPED)
-      ;
-    twiBaseAddress->EVENTS_STOPPED = 0x0UL;
-  } else {
-    twiBaseAddress->TASKS_SUSPEND = 0x1UL;
-    while (!twiBaseAddress->EVENTS_SUSPENDED)
-      ;
-    twiBaseAddress->EVENTS_SUSPENDED = 0x0UL;
+  if (xSemaphoreTake(transferDone, HwFreezedDelay) == pdFALSE) {
+    FixHwFreezed();
+    return ErrorCodes::TransactionFailed;
   }
 
-  if (twiBaseAddress->EVENTS_ERROR) {
-    twiBaseAddress->EVENTS_ERROR = 0x0UL;
+  if (transferFailed) {
     uint32_t error = twiBaseAddress->ERRORSRC;
     twiBaseAddress->ERRORSRC = error;
+    return ErrorCodes::TransactionFailed;
   }
-
   return ErrorCodes::NoError;
 }
 
+void TwiMaster::OnStoppedEvent() {
+  twiBaseAddress->SHORTS = 0;
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  xSemaphoreGiveFromISR(transferDone, &xHigherPriorityTaskWoken);
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+void TwiMaster::OnErrorEvent() {
+  // A NACK does not stop the bus by itself, the STOPPED event will complete the transaction
+  transferFailed = true;
+  twiBaseAddress->TASKS_STOP = 0x1UL;
+}
+
 void TwiMaster::Sleep() {
   twiBaseAddress->ENABLE = (TWIM_ENABLE_ENABLE_Disabled << TWIM_ENABLE_ENABLE_Pos);
 }
@@ -169,7 +138,7 @@ void TwiMaster::Wakeup() {
   twiBaseAddress->ENABLE = (TWIM_ENABLE_ENABLE_Enabled << TWIM_ENABLE_ENABLE_Pos);
 }
 
-/* Sometimes, the TWIM device just freeze and never set the event EVENTS_LASTTX.
+/* Sometimes, the TWIM device just freeze and never set the event EVENTS_STOPPED.
  * This method disable and re-enable the peripheral so that it works again.
  * This is just a workaround, and it would be better if we could find a way to prevent
  * this issue from happening.
@@ -177,9 +146,12 @@ void TwiMaster::Wakeup() {
 void TwiMaster::FixHwFreezed() {
   NRF_LOG_INFO("I2C device frozen, reinitializing it!");
 
-  uint32_t twi_state = NRF_TWI1->ENABLE;
+  uint32_t twi_state = twiBaseAddress->ENABLE;
 
   Sleep();
+  twiBaseAddress->SHORTS = 0;
+  twiBaseAddress->EVENTS_STOPPED = 0;
+  twiBaseAddress->EVENTS_ERROR = 0;
 
   twiBaseAddress->ENABLE = twi_state;
 }
@@ -13,29 +13,38 @@ namespace Pinetime {
       TwiMaster(NRF_TWIM_Type* module, uint32_t frequency, uint8_t pinSda, uint8_t pinScl);
 
       void Init();
+      // Transactions are run by EasyDMA, the calling task sleeps until the STOPPED interrupt.
+      // Tasks calling concurrently are queued on the mutex and served one transaction at a time.
       ErrorCodes Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t* buffer, size_t size);
       ErrorCodes Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t* data, size_t size);
 
       void Sleep();
       void Wakeup();
 
+      void OnStoppedEvent();
+      void OnErrorEvent();
+
+      // Length of a single EasyDMA transfer (MAXCNT is 8 bits wide on the nRF52832)
+      static constexpr size_t maxTransferSize {255};
+      // The register address is sent in the same DMA buffer as the data, which is copied in internalBuffer
+      static constexpr size_t maxWriteSize {32};
+
     private:
-      ErrorCodes Read(uint8_t deviceAddress, uint8_t* buffer, size_t size, bool stop);
-      ErrorCodes Write(uint8_t deviceAddress, const uint8_t* data, size_t size, bool stop);
+      ErrorCodes Transfer(uint8_t deviceAddress, const uint8_t* txData, size_t txSize, uint8_t* rxData, size_t rxSize);
       void FixHwFreezed();
       void ConfigurePins() const;
 
       NRF_TWIM_Type* twiBaseAddress;
       SemaphoreHandle_t mutex = nullptr;
+      SemaphoreHandle_t transferDone = nullptr;
       NRF_TWIM_Type* module;
       uint32_t frequency;
       uint8_t pinSda;
       uint8_t pinScl;
-      static constexpr uint8_t maxDataSize {16};
       static constexpr uint8_t registerSize {1};
-      uint8_t internalBuffer[maxDataSize + registerSize];
-      uint32_t txStartedCycleCount = 0;
-      static constexpr uint32_t HwFreezedDelay {161000};
+      uint8_t internalBuffer[maxWriteSize + registerSize];
+      volatile bool transferFailed = false;
+      static constexpr TickType_t HwFreezedDelay {pdMS_TO_TICKS(20)};
     };
   }
 }
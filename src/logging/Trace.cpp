@@ -0,0 +1,41 @@
+#include "logging/Trace.h"
+
+using namespace Pinetime::Logging;
+
+#ifdef USE_TRACE
+Trace::Record Trace::records[Trace::capacity];
+volatile uint32_t Trace::head = 0;
+volatile bool Trace::recording = false;
+
+// TIMER3 is free running: the HFCLK stays enabled while the firmware is built with the tracer.
+void Trace::Init() {
+  NRF_TIMER3->TASKS_STOP = 1;
+  NRF_TIMER3->TASKS_CLEAR = 1;
+  NRF_TIMER3->MODE = TIMER_MODE_MODE_Timer << TIMER_MODE_MODE_Pos;
+  NRF_TIMER3->BITMODE = TIMER_BITMODE_BITMODE_32Bit << TIMER_BITMODE_BITMODE_Pos;
+  NRF_TIMER3->PRESCALER = 4; // 16MHz / 2^4 = 1MHz
+  NRF_TIMER3->TASKS_START = 1;
+  recording = true;
+}
+
+void Trace::Pause() {
+  recording = false;
+}
+
+void Trace::Resume() {
+  head = 0;
+  recording = true;
+}
+
+uint16_t Trace::Size() {
+  return (head < capacity) ? head : capacity;
+}
+
+const Trace::Record& Trace::At(uint16_t index) {
+  uint32_t oldest = head - Size();
+  return records[(oldest + index) & (capacity - 1)];
+}
+#else
+void Trace::Init() {
+}
+#endif
@@ -0,0 +1,107 @@
+#pragma once
+#include <cstdint>
+#ifdef USE_TRACE
+  #include <nrf.h>
+#endif
+
+namespace Pinetime {
+  namespace Logging {
+    // Binary event tracer for the hot paths, enabled by building with -DUSE_TRACE=1.
+    //
+    // Each event is a fixed size record written in a RAM ring (the oldest records are overwritten), timestamped by
+    // TIMER3 at 1MHz. Recording an event only disables the interrupts for a few cycles, and it is compiled out when
+    // the tracer is disabled. The ring is dumped into a file by the debug service, tools/trace_decode.py converts it
+    // into a Chrome trace (see doc/DebugService.md).
+    class Trace {
+    public:
+      // The IDs are part of the dump format: append new events, and don't reuse the IDs.
+      // The first word of the name is the track of the event in the timeline.
+      enum class Events : uint8_t {
+        DisplayFlush = 0,   // height of the area
+        SpiWrite = 1,       // size
+        SpiRead = 2,        // size of the data
+        SpiWriteBuffer = 3, // size of the data
+        TwiRead = 4,        // device address << 8 | size
+        TwiWrite = 5,       // device address << 8 | size
+        BleGapEvent = 6,    // type of the GAP event
+        BleAlert = 7,       // size of the alert
+        FsRead = 8,         // size
+        FsProg = 9,         // size
+        FsErase = 10,       // block
+        FsSync = 11,
+      };
+
+      enum class Phases : uint8_t { Begin = 0, End = 1, Instant = 2 };
+      static constexpr uint8_t isrFlag = 0x80; // set in the phase when the event is recorded in an interrupt handler
+
+      struct Record {
+        uint32_t timestamp;
+        Events event;
+        uint8_t phase;
+        uint16_t argument;
+      };
+      static_assert(sizeof(Record) == 8, "The records are dumped as is");
+
+      static constexpr uint16_t capacity = 256; // must be a power of 2
+      static constexpr uint32_t timestampFrequency = 1000000;
+
+      static void Init();
+
+      static void Begin(Events event, uint16_t argument = 0) {
+        Add(event, Phases::Begin, argument);
+      }
+      static void End(Events event, uint16_t argument = 0) {
+        Add(event, Phases::End, argument);
+      }
+      static void Instant(Events event, uint16_t argument = 0) {
+        Add(event, Phases::Instant, argument);
+      }
+
+      // Records the beginning of the event when it's created and its end when it's destroyed
+      class Scope {
+      public:
+        explicit Scope(Events event, uint16_t argument = 0) : event {event} {
+          Begin(event, argument);
+        }
+        ~Scope() {
+          End(event);
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+      private:
+        const Events event;
+      };
+
+#ifdef USE_TRACE
+      // Stops the recording so that the records can be read, Resume() clears them and restarts the recording
+      static void Pause();
+      static void Resume();
+      static uint16_t Size();
+      // Records are indexed from the oldest one
+      static const Record& At(uint16_t index);
+
+    private:
+      static Record records[capacity];
+      static volatile uint32_t head;
+      static volatile bool recording;
+
+      static void Add(Events event, Phases phase, uint16_t argument) {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        if (recording) {
+          NRF_TIMER3->TASKS_CAPTURE[0] = 1;
+          uint8_t flags = static_cast<uint8_t>(phase) | ((__get_IPSR() != 0) ? isrFlag : 0);
+          records[head & (capacity - 1)] = {NRF_TIMER3->CC[0], event, flags, argument};
+          head = head + 1;
+        }
+        __set_PRIMASK(primask);
+      }
+#else
+    private:
+      static void Add(Events /*event*/, Phases /*phase*/, uint16_t /*argument*/) {
+      }
+#endif
+    };
+  }
+}
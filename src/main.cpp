@@ -46,6 +46,8 @@
 #include "drivers/Cst816s.h"
 #include "drivers/PinMap.h"
 #include "systemtask/SystemTask.h"
+#include "systemtask/RunTimeStats.h"
+#include "logging/Trace.h"
 #include "drivers/PinMap.h"
 #include "touchhandler/TouchHandler.h"
 #include "buttonhandler/ButtonHandler.h"
@@ -170,11 +172,17 @@ std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> NoI
 
 
 void nrfx_gpiote_evt_handler(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t action) {
+  Pinetime::System::IsrScope isrScope;
   if (pin == Pinetime::PinMap::Cst816sIrq) {
     systemTask.OnTouchEvent();
     return;
   }
 
+  if (pin == Pinetime::PinMap::Bma421Irq) {
+    systemTask.PushMessage(Pinetime::System::Messages::OnMotionEvent);
+    return;
+  }
+
   BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
   if (pin == Pinetime::PinMap::PowerPresent and action == NRF_GPIOTE_POLARITY_TOGGLE) {
@@ -196,6 +204,7 @@ void DebounceTimerCallback(TimerHandle_t /*unused*/) {
 }
 
 void SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQHandler(void) {
+  Pinetime::System::IsrScope isrScope;
   if (((NRF_SPIM0->INTENSET & (1 << 6)) != 0) && NRF_SPIM0->EVENTS_END == 1) {
     NRF_SPIM0->EVENTS_END = 0;
     spi.OnEndEvent();
@@ -208,6 +217,20 @@ void SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQHandler(void) {
 
   if (((NRF_SPIM0->INTENSET & (1 << 1)) != 0) && NRF_SPIM0->EVENTS_STOPPED == 1) {
     NRF_SPIM0->EVENTS_STOPPED = 0;
+    spi.OnStoppedEvent();
+  }
+}
+
+void SPIM1_SPIS1_TWIM1_TWIS1_SPI1_TWI1_IRQHandler(void) {
+  Pinetime::System::IsrScope isrScope;
+  if (((NRF_TWIM1->INTENSET & TWIM_INTENSET_ERROR_Msk) != 0) && NRF_TWIM1->EVENTS_ERROR == 1) {
+    NRF_TWIM1->EVENTS_ERROR = 0;
+    twiMaster.OnErrorEvent();
+  }
+
+  if (((NRF_TWIM1->INTENSET & TWIM_INTENSET_STOPPED_Msk) != 0) && NRF_TWIM1->EVENTS_STOPPED == 1) {
+    NRF_TWIM1->EVENTS_STOPPED = 0;
+    twiMaster.OnStoppedEvent();
   }
 }
 
@@ -218,14 +241,17 @@ static void (*rtc0_isr_addr)(void);
 /* Some interrupt handlers required for NimBLE radio driver */
 extern "C" {
 void RADIO_IRQHandler(void) {
+  Pinetime::System::IsrScope isrScope;
   ((void (*)(void)) radio_isr_addr)();
 }
 
 void RNG_IRQHandler(void) {
+  Pinetime::System::IsrScope isrScope;
   ((void (*)(void)) rng_isr_addr)();
 }
 
 void RTC0_IRQHandler(void) {
+  Pinetime::System::IsrScope isrScope;
   ((void (*)(void)) rtc0_isr_addr)();
 }
 
@@ -306,6 +332,7 @@ int main(void) {
   logger.Init();
 
   nrf_drv_clock_init();
+  Pinetime::Logging::Trace::Init();
 
   // Unblock i2c?
   nrf_gpio_cfg(Pinetime::PinMap::TwiScl,
@@ -18,7 +18,7 @@
 #include "drivers/PinMap.h"
 
 #include "displayapp/icons/infinitime/infinitime-nb.c"
-#include "components/rle/RleDecoder.h"
+#include "components/rle/PaletteRleDecoder.h"
 
 #if NRF_LOG_ENABLED
   #include "logging/NrfLogger.h"
@@ -73,6 +73,7 @@ void SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQHandler(void) {
 
   if (((NRF_SPIM0->INTENSET & (1 << 1)) != 0) && NRF_SPIM0->EVENTS_STOPPED == 1) {
     NRF_SPIM0->EVENTS_STOPPED = 0;
+    spi.OnStoppedEvent();
   }
 }
 }
@@ -98,8 +99,9 @@ void Process(void* instance) {
   DisplayLogo();
 
   NRF_LOG_INFO("Erasing...");
-  for (uint32_t erased = 0; erased < sizeof(recoveryImage); erased += 0x1000) {
-    spiNorFlash.SectorErase(erased);
+  for (uint32_t erased = 0; erased < sizeof(recoveryImage);) {
+    erased += spiNorFlash.StartErase(erased, sizeof(recoveryImage) - erased);
+    spiNorFlash.WaitForCompletion();
     RefreshWatchdog();
   }
 
@@ -112,6 +114,8 @@ void Process(void* instance) {
     DisplayProgressBar((static_cast<float>(offset) / static_cast<float>(sizeof(recoveryImage))) * 100.0f, colorWhite);
     RefreshWatchdog();
   }
+  // The last pages are still queued in the driver
+  spiNorFlash.WaitForCompletion();
   NRF_LOG_INFO("Writing factory image done!");
   DisplayProgressBar(100.0f, colorGreen);
 
@@ -121,10 +125,11 @@ void Process(void* instance) {
 }
 
 void DisplayLogo() {
-  Pinetime::Tools::RleDecoder rleDecoder(infinitime_nb, sizeof(infinitime_nb));
+  Pinetime::Tools::PaletteRleDecoder rleDecoder(infinitime_nb, sizeof(infinitime_nb));
   for (int i = 0; i < displayWidth; i++) {
-    rleDecoder.DecodeNext(displayBuffer, displayWidth * bytesPerPixel);
+    // Wait for the previous line to be sent before overwriting the buffer
     ulTaskNotifyTake(pdTRUE, 500);
+    rleDecoder.DecodeNext(displayBuffer, displayWidth * bytesPerPixel);
     lcd.DrawBuffer(0, i, displayWidth, 1, reinterpret_cast<const uint8_t*>(displayBuffer), displayWidth * bytesPerPixel);
   }
 }
@@ -15,6 +15,7 @@ namespace Pinetime {
         BleFirmwareUpdateStarted,
         BleFirmwareUpdateFinished,
         OnTouchEvent,
+        OnMotionEvent,
         HandleButtonEvent,
         HandleButtonTimerEvent,
         OnDisplayTaskSleeping,
@@ -28,10 +29,15 @@ namespace Pinetime {
         SetOffAlarm,
         StopRinging,
         MeasureBatteryTimerExpired,
+        BleDiscoveryTimerExpired,
+        BleConnectionIdleTimerExpired,
+        TimeRolloverTimerExpired,
+        WatchdogTimerExpired,
         BatteryPercentageUpdated,
         StartFileTransfer,
         StopFileTransfer,
-        BleRadioEnableToggle
+        BleRadioEnableToggle,
+        NbMessages // Keep last, used to size the wake-up counters
       };
     }
 }
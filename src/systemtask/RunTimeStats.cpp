@@ -0,0 +1,63 @@
+#include "systemtask/RunTimeStats.h"
+#include <algorithm>
+
+using namespace Pinetime::System;
+
+#if configGENERATE_RUN_TIME_STATS == 1
+namespace {
+  bool SortByNumber(const TaskStatus_t& lhs, const TaskStatus_t& rhs) {
+    return lhs.xTaskNumber < rhs.xTaskNumber;
+  }
+}
+
+void RunTimeStats::Update() {
+  TaskStatus_t tasksStatus[maxTaskCount];
+  uint32_t totalRunTime = 0;
+  auto nb = uxTaskGetSystemState(tasksStatus, maxTaskCount, &totalRunTime);
+  std::sort(tasksStatus, tasksStatus + nb, SortByNumber);
+
+  uint32_t isrRunTime = ulPortGetIsrRunTime();
+  uint32_t contextSwitchCount = ulPortGetContextSwitchCount();
+  window = totalRunTime - lastTotalRunTime;
+  contextSwitches = contextSwitchCount - lastContextSwitchCount;
+  isrUsage = Usage(isrRunTime - lastIsrRunTime);
+  idleUsage = 0;
+
+  // The counters are matched by task number, a task created during the window starts from 0
+  Counter newCounters[maxTaskCount];
+  TaskHandle_t idleTask = xTaskGetIdleTaskHandle();
+  for (uint8_t i = 0; i < nb; i++) {
+    uint32_t runTime = tasksStatus[i].ulRunTimeCounter - PreviousRunTime(tasksStatus[i].xTaskNumber);
+    newCounters[i] = {tasksStatus[i].xTaskNumber, tasksStatus[i].ulRunTimeCounter};
+    tasks[i] = {tasksStatus[i].pcTaskName, Usage(runTime)};
+    if (tasksStatus[i].xHandle == idleTask) {
+      idleUsage = tasks[i].usage;
+    }
+  }
+  std::copy(newCounters, newCounters + nb, counters);
+  nbTasks = nb;
+
+  lastTotalRunTime = totalRunTime;
+  lastIsrRunTime = isrRunTime;
+  lastContextSwitchCount = contextSwitchCount;
+}
+#else
+void RunTimeStats::Update() {
+}
+#endif
+
+uint32_t RunTimeStats::PreviousRunTime(UBaseType_t taskNumber) const {
+  for (uint8_t i = 0; i < nbTasks; i++) {
+    if (counters[i].taskNumber == taskNumber) {
+      return counters[i].runTime;
+    }
+  }
+  return 0;
+}
+
+uint16_t RunTimeStats::Usage(uint32_t runTime) const {
+  if (window == 0) {
+    return 0;
+  }
+  return static_cast<uint16_t>(std::min<uint64_t>((static_cast<uint64_t>(runTime) * 1000) / window, 1000));
+}
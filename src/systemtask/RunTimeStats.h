@@ -0,0 +1,89 @@
+#pragma once
+#include <FreeRTOS.h> // declares configGENERATE_RUN_TIME_STATS
+#include <task.h>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace System {
+    // CPU usage of the tasks over the window elapsed between the last two calls to Update().
+    // Each user owns its instance, so that the windows of the screen and of the BLE service are independent.
+    // The statistics are only measured when the firmware is built with USE_RUNTIME_STATS, Update() does nothing otherwise.
+    class RunTimeStats {
+    public:
+      static constexpr bool enabled = (configGENERATE_RUN_TIME_STATS == 1);
+      static constexpr uint8_t maxTaskCount = 10;
+      static constexpr uint32_t counterFrequency = 32768;
+
+      struct Task {
+        const char* name;
+        uint16_t usage; // per mille of the window
+      };
+
+      void Update();
+
+      uint8_t NbTasks() const {
+        return nbTasks;
+      }
+      const Task* Tasks() const {
+        return tasks;
+      }
+      uint16_t IdleUsage() const {
+        return idleUsage;
+      }
+      // The time spent in the interrupt handlers is also accounted to the tasks they interrupted
+      uint16_t IsrUsage() const {
+        return isrUsage;
+      }
+      uint32_t ContextSwitches() const {
+        return contextSwitches;
+      }
+      uint32_t WindowMs() const {
+        return static_cast<uint32_t>((static_cast<uint64_t>(window) * 1000) / counterFrequency);
+      }
+
+    private:
+      struct Counter {
+        UBaseType_t taskNumber;
+        uint32_t runTime;
+      };
+
+      Task tasks[maxTaskCount] {};
+      Counter counters[maxTaskCount] {};
+      uint8_t nbTasks = 0;
+      uint16_t idleUsage = 0;
+      uint16_t isrUsage = 0;
+      uint32_t contextSwitches = 0;
+      uint32_t window = 0;
+
+      uint32_t lastTotalRunTime = 0;
+      uint32_t lastIsrRunTime = 0;
+      uint32_t lastContextSwitchCount = 0;
+
+      uint32_t PreviousRunTime(UBaseType_t taskNumber) const;
+      uint16_t Usage(uint32_t runTime) const;
+    };
+
+#if configGENERATE_RUN_TIME_STATS == 1
+    // Accounts the time spent in an interrupt handler, from the beginning of the scope to its end
+    class IsrScope {
+    public:
+      IsrScope() : start {ulPortGetRunTimeCounterValue()} {
+      }
+      ~IsrScope() {
+        vPortIsrExit(start);
+      }
+      IsrScope(const IsrScope&) = delete;
+      IsrScope& operator=(const IsrScope&) = delete;
+
+    private:
+      const uint32_t start;
+    };
+#else
+    class IsrScope {
+    public:
+      IsrScope() {
+      }
+    };
+#endif
+  }
+}
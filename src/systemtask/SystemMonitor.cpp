@@ -1,4 +1,10 @@
 #include "systemtask/SystemTask.h"
+#include <numeric>
+
+uint32_t Pinetime::System::SystemMonitor::WakeUpCount() const {
+  return std::accumulate(wakeUpCounters.begin(), wakeUpCounters.end(), uint32_t {0});
+}
+
 #if configUSE_TRACE_FACILITY == 1
 // FreeRtosMonitor
 #include <FreeRTOS.h>
@@ -8,18 +14,42 @@
 void Pinetime::System::SystemMonitor::Process() {
   if (xTaskGetTickCount() - lastTick > 10000) {
     NRF_LOG_INFO("---------------------------------------\nFree heap : %d", xPortGetFreeHeapSize());
-    TaskStatus_t tasksStatus[10];
-    auto nb = uxTaskGetSystemState(tasksStatus, 10, nullptr);
-    for (uint32_t i = 0; i < nb; i++) {
-      NRF_LOG_INFO("Task [%s] - %d", tasksStatus[i].pcTaskName, tasksStatus[i].usStackHighWaterMark);
-      if (tasksStatus[i].usStackHighWaterMark < 20)
-        NRF_LOG_INFO("WARNING!!! Task %s task is nearly full, only %dB available",
-                      tasksStatus[i].pcTaskName,
-                      tasksStatus[i].usStackHighWaterMark * 4);
-    }
+    NRF_LOG_INFO("System task wake-ups : %d", WakeUpCount());
+  #if configGENERATE_RUN_TIME_STATS == 1
+    LogCpuUsage();
+  #endif
+    LogStackUsage();
     lastTick = xTaskGetTickCount();
   }
 }
+
+// Process() runs on the stack of the system task : the task status arrays of LogCpuUsage() (in RunTimeStats::Update())
+// and LogStackUsage() must not be on the stack at the same time.
+__attribute__((noinline)) void Pinetime::System::SystemMonitor::LogStackUsage() const {
+  TaskStatus_t tasksStatus[10];
+  auto nb = uxTaskGetSystemState(tasksStatus, 10, nullptr);
+  for (uint32_t i = 0; i < nb; i++) {
+    NRF_LOG_INFO("Task [%s] - %d", tasksStatus[i].pcTaskName, tasksStatus[i].usStackHighWaterMark);
+    if (tasksStatus[i].usStackHighWaterMark < 20)
+      NRF_LOG_INFO("WARNING!!! Task %s task is nearly full, only %dB available",
+                    tasksStatus[i].pcTaskName,
+                    tasksStatus[i].usStackHighWaterMark * 4);
+  }
+}
+
+  #if configGENERATE_RUN_TIME_STATS == 1
+__attribute__((noinline)) void Pinetime::System::SystemMonitor::LogCpuUsage() {
+  runTimeStats.Update();
+  NRF_LOG_INFO("CPU per mille - idle : %d, ISR : %d - context switches : %d in %dms",
+               runTimeStats.IdleUsage(),
+               runTimeStats.IsrUsage(),
+               runTimeStats.ContextSwitches(),
+               runTimeStats.WindowMs());
+  for (uint8_t i = 0; i < runTimeStats.NbTasks(); i++) {
+    NRF_LOG_INFO("Task [%s] - CPU %d", runTimeStats.Tasks()[i].name, runTimeStats.Tasks()[i].usage);
+  }
+}
+  #endif
 #else
 // DummyMonitor
 void Pinetime::System::SystemMonitor::Process() {}
@@ -1,15 +1,35 @@
 #pragma once
 #include <FreeRTOS.h> // declares configUSE_TRACE_FACILITY
 #include <task.h>
+#include <array>
+#include <cstdint>
+#include "systemtask/Messages.h"
+#include "systemtask/RunTimeStats.h"
 
 namespace Pinetime {
   namespace System {
     class SystemMonitor {
     public:
       void Process();
-#if configUSE_TRACE_FACILITY == 1
+
+      // The system task only wakes up to handle a message, the counters tell why it did
+      void OnWakeUp(Messages message) {
+        wakeUpCounters[static_cast<uint8_t>(message)]++;
+      }
+      uint32_t WakeUpCount(Messages message) const {
+        return wakeUpCounters[static_cast<uint8_t>(message)];
+      }
+      uint32_t WakeUpCount() const;
+
     private:
+      std::array<uint32_t, static_cast<uint8_t>(Messages::NbMessages)> wakeUpCounters {};
+#if configUSE_TRACE_FACILITY == 1
       mutable TickType_t lastTick = 0;
+      void LogStackUsage() const;
+  #if configGENERATE_RUN_TIME_STATS == 1
+      RunTimeStats runTimeStats;
+      void LogCpuUsage();
+  #endif
 #endif
     };
   }
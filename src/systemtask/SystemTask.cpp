@@ -46,6 +46,21 @@ void MeasureBatteryTimerCallback(TimerHandle_t xTimer) {
   sysTask->PushMessage(Pinetime::System::Messages::MeasureBatteryTimerExpired);
 }
 
+void BleDiscoveryTimerCallback(TimerHandle_t xTimer) {
+  auto* sysTask = static_cast<SystemTask*>(pvTimerGetTimerID(xTimer));
+  sysTask->PushMessage(Pinetime::System::Messages::BleDiscoveryTimerExpired);
+}
+
+void TimeRolloverTimerCallback(TimerHandle_t xTimer) {
+  auto* sysTask = static_cast<SystemTask*>(pvTimerGetTimerID(xTimer));
+  sysTask->PushMessage(Pinetime::System::Messages::TimeRolloverTimerExpired);
+}
+
+void WatchdogTimerCallback(TimerHandle_t xTimer) {
+  auto* sysTask = static_cast<SystemTask*>(pvTimerGetTimerID(xTimer));
+  sysTask->PushMessage(Pinetime::System::Messages::WatchdogTimerExpired);
+}
+
 SystemTask::SystemTask(Drivers::SpiMaster& spi,
                        Drivers::St7789& lcd,
                        Pinetime::Drivers::SpiNorFlash& spiNorFlash,
@@ -208,22 +223,38 @@ void SystemTask::Work() {
   nrfx_gpiote_in_init(PinMap::PowerPresent, &pinConfig, nrfx_gpiote_evt_handler);
   nrfx_gpiote_in_event_enable(PinMap::PowerPresent, true);
 
+  // Motion sensor FIFO watermark
+  pinConfig.sense = NRF_GPIOTE_POLARITY_LOTOHI;
+  pinConfig.pull = NRF_GPIO_PIN_NOPULL;
+  nrfx_gpiote_in_init(PinMap::Bma421Irq, &pinConfig, nrfx_gpiote_evt_handler);
+  nrfx_gpiote_in_event_enable(PinMap::Bma421Irq, true);
+  // Clears the interrupt if the watermark was reached before the pin was configured
+  UpdateMotion();
+
   batteryController.MeasureVoltage();
 
   idleTimer = xTimerCreate("idleTimer", pdMS_TO_TICKS(2000), pdFALSE, this, IdleTimerCallback);
   dimTimer = xTimerCreate("dimTimer", pdMS_TO_TICKS(settingsController.GetScreenTimeOut() - 2000), pdFALSE, this, DimTimerCallback);
   measureBatteryTimer = xTimerCreate("measureBattery", batteryMeasurementPeriod, pdTRUE, this, MeasureBatteryTimerCallback);
+  bleDiscoveryTimer = xTimerCreate("bleDiscovery", bleDiscoveryDelay, pdFALSE, this, BleDiscoveryTimerCallback);
+  // The period is set to the time left until the next half hour when the timer is started
+  timeRolloverTimer = xTimerCreate("timeRollover", portMAX_DELAY, pdFALSE, this, TimeRolloverTimerCallback);
+  watchdogTimer = xTimerCreate("watchdog", watchdogKickPeriod, pdTRUE, this, WatchdogTimerCallback);
   xTimerStart(dimTimer, 0);
   xTimerStart(measureBatteryTimer, portMAX_DELAY);
+  xTimerStart(watchdogTimer, portMAX_DELAY);
+  UpdateTime();
+  StartTimeRolloverTimer();
 
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "EndlessLoop"
   while (true) {
-    UpdateMotion();
-
     uint8_t msg;
-    if (xQueueReceive(systemTasksMsgQueue, &msg, 100)) {
+    if (xQueueReceive(systemTasksMsgQueue, &msg, portMAX_DELAY)) {
       Messages message = static_cast<Messages>(msg);
+      monitor.OnWakeUp(message);
+      // The time is only kept up to date by the system task when it wakes up (and by the display app while it's running)
+      UpdateTime();
       switch (message) {
         case Messages::EnableSleeping:
           // Make sure that exiting an app doesn't enable sleeping,
@@ -286,6 +317,7 @@ void SystemTask::Work() {
           heartRateApp.PushMessage(Pinetime::Applications::HeartRateTask::Messages::GoToSleep);
           break;
         case Messages::OnNewTime:
+          StartTimeRolloverTimer();
           ReloadIdleTimer();
           displayApp.PushMessage(Pinetime::Applications::Display::Messages::UpdateDateTime);
           if (alarmController.State() == Controllers::AlarmController::AlarmState::Set) {
@@ -321,20 +353,29 @@ void SystemTask::Work() {
           break;
         case Messages::BleConnected:
           ReloadIdleTimer();
-          isBleDiscoveryTimerRunning = true;
-          bleDiscoveryTimer = 5;
+          // Services discovery is deffered from 3 seconds to avoid the conflicts between the host communicating with the
+          // target and vice-versa. I'm not sure if this is the right way to handle this...
+          xTimerStart(bleDiscoveryTimer, 0);
+          break;
+        case Messages::BleDiscoveryTimerExpired:
+          nimbleController.StartDiscovery();
+          break;
+        case Messages::BleConnectionIdleTimerExpired:
+          nimbleController.connectionParameters().OnIdleTimer();
           break;
         case Messages::BleFirmwareUpdateStarted:
           doNotGoToSleep = true;
           if (isSleeping && !isWakingUp) {
             GoToRunning();
           }
+          nimbleController.connectionParameters().StartActivity(Controllers::ConnectionParameters::Activities::FirmwareUpdate);
           displayApp.PushMessage(Pinetime::Applications::Display::Messages::BleFirmwareUpdateStarted);
           break;
         case Messages::BleFirmwareUpdateFinished:
           if (bleController.State() == Pinetime::Controllers::Ble::FirmwareUpdateStates::Validated) {
             NVIC_SystemReset();
           }
+          nimbleController.connectionParameters().StopActivity(Controllers::ConnectionParameters::Activities::FirmwareUpdate);
           doNotGoToSleep = false;
           xTimerStart(dimTimer, 0);
           break;
@@ -343,11 +384,13 @@ void SystemTask::Work() {
           doNotGoToSleep = true;
           if (isSleeping && !isWakingUp)
             GoToRunning();
+          nimbleController.connectionParameters().StartActivity(Controllers::ConnectionParameters::Activities::FileTransfer);
           // TODO add intent of fs access icon or something
           break;
         case Messages::StopFileTransfer:
           NRF_LOG_INFO("[systemtask] FS Stopped");
           doNotGoToSleep = false;
+          nimbleController.connectionParameters().StopActivity(Controllers::ConnectionParameters::Activities::FileTransfer);
           xTimerStart(dimTimer, 0);
           // TODO add intent of fs access icon or something
           break;
@@ -358,6 +401,9 @@ void SystemTask::Work() {
           ReloadIdleTimer();
           displayApp.PushMessage(Pinetime::Applications::Display::Messages::TouchEvent);
           break;
+        case Messages::OnMotionEvent:
+          UpdateMotion();
+          break;
         case Messages::HandleButtonEvent: {
           Controllers::ButtonActions action;
           if (nrf_gpio_pin_read(Pinetime::PinMap::Button) == 0) {
@@ -430,6 +476,10 @@ void SystemTask::Work() {
         case Messages::MeasureBatteryTimerExpired:
           batteryController.MeasureVoltage();
           break;
+        case Messages::TimeRolloverTimerExpired:
+          // UpdateTime() sent OnNewHalfHour, OnNewHour and OnNewDay if needed
+          StartTimeRolloverTimer();
+          break;
         case Messages::BatteryPercentageUpdated:
           nimbleController.NotifyBatteryLevel(batteryController.PercentRemaining());
           break;
@@ -452,21 +502,8 @@ void SystemTask::Work() {
       }
     }
 
-    if (isBleDiscoveryTimerRunning) {
-      if (bleDiscoveryTimer == 0) {
-        isBleDiscoveryTimerRunning = false;
-        // Services discovery is deffered from 3 seconds to avoid the conflicts between the host communicating with the
-        // target and vice-versa. I'm not sure if this is the right way to handle this...
-        nimbleController.StartDiscovery();
-      } else {
-        bleDiscoveryTimer--;
-      }
-    }
-
     monitor.Process();
-    uint32_t systick_counter = nrf_rtc_counter_get(portNRF_RTC_REG);
-    dateTimeController.UpdateTime(systick_counter);
-    NoInit_BackUpTime = dateTimeController.CurrentDateTime();
+    // watchdogTimer makes sure this happens at least every watchdogKickPeriod
     if (!nrf_gpio_pin_read(PinMap::Button)) {
       watchdog.Kick();
     }
@@ -474,7 +511,28 @@ void SystemTask::Work() {
 #pragma clang diagnostic pop
 }
 
+void SystemTask::UpdateTime() {
+  uint32_t systick_counter = nrf_rtc_counter_get(portNRF_RTC_REG);
+  dateTimeController.UpdateTime(systick_counter);
+  NoInit_BackUpTime = dateTimeController.CurrentDateTime();
+}
+
+void SystemTask::StartTimeRolloverTimer() {
+  // OnNewHalfHour, OnNewHour and OnNewDay are all sent at a half hour boundary.
+  // If the timer expires a bit early, it is simply restarted for the remaining second.
+  uint32_t secondsLeft = (30 - dateTimeController.Minutes() % 30) * 60 - dateTimeController.Seconds();
+  xTimerChangePeriod(timeRolloverTimer, pdMS_TO_TICKS(secondsLeft * 1000), 0);
+}
+
 void SystemTask::UpdateMotion() {
+  if (stepCounterMustBeReset) {
+    motionSensor.ResetStepCounter();
+    stepCounterMustBeReset = false;
+  }
+
+  // The FIFO is always drained: the watermark interrupt is latched until then
+  auto motionValues = motionSensor.Process();
+
   if (isGoingToSleep or isWakingUp) {
     return;
   }
@@ -483,15 +541,9 @@ void SystemTask::UpdateMotion() {
                       settingsController.isWakeUpModeOn(Pinetime::Controllers::Settings::WakeUpMode::Shake))) {
     return;
   }
-  if (stepCounterMustBeReset) {
-    motionSensor.ResetStepCounter();
-    stepCounterMustBeReset = false;
-  }
-
-  auto motionValues = motionSensor.Process();
 
   motionController.IsSensorOk(motionSensor.IsOk());
-  motionController.Update(motionValues.x, motionValues.y, motionValues.z, motionValues.steps);
+  motionController.Update(motionValues.samples, motionValues.nbSamples, motionValues.steps);
 
   if (settingsController.isWakeUpModeOn(Pinetime::Controllers::Settings::WakeUpMode::RaiseWrist) &&
       motionController.Should_RaiseWake(isSleeping)) {
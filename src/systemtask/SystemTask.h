@@ -133,11 +133,12 @@ namespace Pinetime {
       static void Process(void* instance);
       void Work();
       void ReloadIdleTimer();
-      bool isBleDiscoveryTimerRunning = false;
-      uint8_t bleDiscoveryTimer = 0;
       TimerHandle_t dimTimer;
       TimerHandle_t idleTimer;
       TimerHandle_t measureBatteryTimer;
+      TimerHandle_t bleDiscoveryTimer;
+      TimerHandle_t timeRolloverTimer;
+      TimerHandle_t watchdogTimer;
       bool doNotGoToSleep = false;
 
       void HandleButtonAction(Controllers::ButtonActions action);
@@ -145,10 +146,20 @@ namespace Pinetime {
 
       void GoToRunning();
       void UpdateMotion();
+      void UpdateTime();
+      void StartTimeRolloverTimer();
       bool stepCounterMustBeReset = false;
       static constexpr TickType_t batteryMeasurementPeriod = pdMS_TO_TICKS(10 * 60 * 1000);
+      static constexpr TickType_t bleDiscoveryDelay = pdMS_TO_TICKS(500);
+      // Must be shorter than the watchdog timeout (7s)
+      static constexpr TickType_t watchdogKickPeriod = pdMS_TO_TICKS(3000);
 
       SystemMonitor monitor;
+
+    public:
+      const SystemMonitor& Monitor() const {
+        return monitor;
+      }
     };
   }
 }
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <FreeRTOS.h>
+#include <semphr.h>
+
+namespace Pinetime {
+  namespace Utility {
+    // Holds a FreeRTOS mutex for the lifetime of the scope
+    class LockGuard {
+    public:
+      explicit LockGuard(SemaphoreHandle_t mutex) : mutex {mutex} {
+        xSemaphoreTake(mutex, portMAX_DELAY);
+      }
+      ~LockGuard() {
+        xSemaphoreGive(mutex);
+      }
+      LockGuard(const LockGuard&) = delete;
+      LockGuard& operator=(const LockGuard&) = delete;
+
+    private:
+      SemaphoreHandle_t mutex;
+    };
+
+    // Same as LockGuard, for a mutex created with xSemaphoreCreateRecursiveMutex()
+    class RecursiveLockGuard {
+    public:
+      explicit RecursiveLockGuard(SemaphoreHandle_t mutex) : mutex {mutex} {
+        xSemaphoreTakeRecursive(mutex, portMAX_DELAY);
+      }
+      ~RecursiveLockGuard() {
+        xSemaphoreGiveRecursive(mutex);
+      }
+      RecursiveLockGuard(const RecursiveLockGuard&) = delete;
+      RecursiveLockGuard& operator=(const RecursiveLockGuard&) = delete;
+
+    private:
+      SemaphoreHandle_t mutex;
+    };
+  }
+}
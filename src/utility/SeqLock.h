@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Pinetime {
+  namespace Utility {
+    /* Sequence counter used to publish data from a single writer task to reader tasks without locking.
+     *
+     * The writer increments the counter before and after modifying the data: the counter is odd while a write is in
+     * progress. A reader records the counter, copies the data and checks that the counter has not changed in the
+     * meantime, otherwise the copy may be torn and must be discarded.
+     * The writer never waits for the readers. Readers retry a bounded number of times, so that a reader with a higher
+     * priority than the writer can't spin forever on a write it preempted.
+     */
+    class SequenceCounter {
+    public:
+      void BeginWrite() {
+        uint32_t value = sequence.load(std::memory_order_relaxed);
+        sequence.store(value + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+      }
+
+      void EndWrite() {
+        uint32_t value = sequence.load(std::memory_order_relaxed);
+        sequence.store(value + 1, std::memory_order_release);
+      }
+
+      // Returns false if a write is in progress
+      bool BeginRead(uint32_t& value) const {
+        value = sequence.load(std::memory_order_acquire);
+        return (value & 1) == 0;
+      }
+
+      // Returns true if no write happened since BeginRead()
+      bool Validate(uint32_t value) const {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence.load(std::memory_order_relaxed) == value;
+      }
+
+      // Changes each time the data is written
+      uint32_t Version() const {
+        return sequence.load(std::memory_order_acquire);
+      }
+
+      static constexpr uint8_t maxReadAttempts = 4;
+
+    private:
+      std::atomic<uint32_t> sequence {0};
+    };
+
+    // Value of type T published by a single writer with a SequenceCounter
+    template <class T> class SeqLock {
+      static_assert(std::is_trivially_copyable<T>::value, "The value is copied with memcpy()");
+
+    public:
+      SeqLock() = default;
+      explicit SeqLock(const T& initialValue) : value {initialValue} {
+      }
+
+      // Calls writer(T&) to modify the value in place
+      template <class Writer> void Write(Writer&& writer) {
+        counter.BeginWrite();
+        writer(value);
+        counter.EndWrite();
+      }
+
+      // Copies the value into destination. Returns false, and leaves destination unchanged,
+      // if every attempt overlapped a write.
+      bool Read(T& destination) const {
+        T copy;
+        for (uint8_t attempt = 0; attempt < SequenceCounter::maxReadAttempts; attempt++) {
+          uint32_t version;
+          if (!counter.BeginRead(version)) {
+            continue;
+          }
+          std::memcpy(&copy, &value, sizeof(T));
+          if (counter.Validate(version)) {
+            destination = copy;
+            return true;
+          }
+        }
+        return false;
+      }
+
+      uint32_t Version() const {
+        return counter.Version();
+      }
+
+    private:
+      SequenceCounter counter;
+      T value {};
+    };
+  }
+}
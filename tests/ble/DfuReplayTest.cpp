@@ -0,0 +1,147 @@
+// Replays DFU sessions, as sent by the companion apps, through DfuService and a RAM model of the external flash.
+// The packets of the firmware image have the size allowed by the negotiated MTU, from 20 bytes (legacy clients)
+// to 509 bytes (MTU 512, split in several mbufs by the host).
+#include "components/ble/DfuService.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "Check.h"
+#include "NimbleStubs.h"
+#include "components/ble/BleController.h"
+#include "drivers/SpiNorFlash.h"
+#include "systemtask/SystemTask.h"
+
+using Pinetime::Controllers::Ble;
+using Pinetime::Controllers::DfuService;
+
+namespace {
+  constexpr uint32_t slotOffset = 0x40000;
+  constexpr uint32_t slotSize = 475136;
+  constexpr uint8_t packetReceiptInterval = 10;
+
+  struct Handles {
+    uint16_t packet;
+    uint16_t controlPoint;
+  };
+
+  struct Session {
+    size_t packetSize;
+    size_t mbufSize;
+    uint16_t crc;
+  };
+
+  void Write(uint16_t handle, const std::vector<uint8_t>& data, size_t mbufSize = 512) {
+    os_mbuf* om = Stubs::MakeMbufChain(data.data(), data.size(), mbufSize);
+    CHECK(Stubs::Access(handle, BLE_GATT_ACCESS_OP_WRITE_CHR, om) == 0);
+    Stubs::FreeMbufChain(om);
+  }
+
+  std::vector<uint8_t> LittleEndian(uint32_t value, uint8_t size) {
+    std::vector<uint8_t> bytes;
+    for (uint8_t i = 0; i < size; i++) {
+      bytes.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+    return bytes;
+  }
+
+  size_t CountPacketReceiptNotifications() {
+    size_t count = 0;
+    for (const auto& notification : Stubs::Notifications()) {
+      count += (notification.data[0] == 0x11) ? 1 : 0;
+    }
+    return count;
+  }
+
+  // Returns the duration of the transfer of the image, in seconds
+  double Replay(DfuService& dfuService, const Handles& handles, const std::vector<uint8_t>& image, const Session& session) {
+    Stubs::Notifications().clear();
+
+    // Start DFU (application), then the sizes of the softdevice, the bootloader and the application
+    Write(handles.controlPoint, {0x01, 0x04});
+    std::vector<uint8_t> sizes = LittleEndian(0, 4);
+    for (auto size : {uint32_t {0}, static_cast<uint32_t>(image.size())}) {
+      auto bytes = LittleEndian(size, 4);
+      sizes.insert(sizes.end(), bytes.begin(), bytes.end());
+    }
+    Write(handles.packet, sizes);
+
+    // Init packet : device type, revision, application version, softdevices, CRC
+    Write(handles.controlPoint, {0x02, 0x00});
+    std::vector<uint8_t> initPacket {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0xfe, 0xff};
+    auto crc = LittleEndian(session.crc, 2);
+    initPacket.insert(initPacket.end(), crc.begin(), crc.end());
+    Write(handles.packet, initPacket);
+    Write(handles.controlPoint, {0x02, 0x01});
+
+    Write(handles.controlPoint, {0x08, packetReceiptInterval});
+    Write(handles.controlPoint, {0x03});
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t offset = 0; offset < image.size(); offset += session.packetSize) {
+      size_t size = std::min(session.packetSize, image.size() - offset);
+      Write(handles.packet, std::vector<uint8_t>(image.begin() + offset, image.begin() + offset + size), session.mbufSize);
+    }
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+    size_t nbPackets = (image.size() + session.packetSize - 1) / session.packetSize;
+    size_t expectedNotifications = nbPackets / packetReceiptInterval;
+    if (nbPackets % packetReceiptInterval == 0) {
+      // No receipt for the last packet, the response to ReceiveFirmwareImage is sent instead
+      expectedNotifications--;
+    }
+    CHECK(CountPacketReceiptNotifications() == expectedNotifications);
+    CHECK(!Stubs::Notifications().empty());
+    CHECK((Stubs::Notifications().back().data == std::vector<uint8_t> {0x10, 0x03, 0x01}));
+
+    Write(handles.controlPoint, {0x04});
+    return duration.count();
+  }
+}
+
+int main() {
+  Pinetime::System::SystemTask systemTask;
+  Ble bleController;
+  Pinetime::Drivers::SpiNorFlash spiNorFlash;
+  DfuService dfuService {systemTask, bleController, spiNorFlash};
+  dfuService.Init();
+
+  static const ble_uuid128_t serviceUuid {
+    .u {.type = BLE_UUID_TYPE_128},
+    .value = {0x23, 0xD1, 0xBC, 0xEA, 0x5F, 0x78, 0x23, 0x15, 0xDE, 0xEF, 0x12, 0x12, 0x30, 0x15, 0x00, 0x00}};
+  ble_uuid128_t characteristicUuid = serviceUuid;
+  Handles handles {};
+  characteristicUuid.value[12] = 0x32;
+  CHECK(ble_gatts_find_chr(&serviceUuid.u, &characteristicUuid.u, nullptr, &handles.packet) == 0);
+  characteristicUuid.value[12] = 0x31;
+  CHECK(ble_gatts_find_chr(&serviceUuid.u, &characteristicUuid.u, nullptr, &handles.controlPoint) == 0);
+
+  std::vector<uint8_t> image(300 * 1024 + 123);
+  std::mt19937 random {11};
+  for (auto& b : image) {
+    b = random();
+  }
+  const uint16_t crc = Pinetime::Tools::Crc16::Compute(image.data(), image.size());
+  static const uint8_t magic[] = {0x77, 0xc2, 0x95, 0xf3, 0x60, 0xd2, 0xef, 0x7f, 0x35, 0x52, 0x50, 0x0f, 0x2c, 0xb6, 0x79, 0x80};
+
+  const Session sessions[] = {{20, 20, crc}, {244, 244, crc}, {509, 256, crc}, {509, 27, crc}};
+  for (const auto& session : sessions) {
+    // A previous image in the slot: the DFU must erase what it programs
+    std::fill(spiNorFlash.memory.begin() + slotOffset, spiNorFlash.memory.begin() + slotOffset + slotSize, 0x00);
+
+    double duration = Replay(dfuService, handles, image, session);
+    CHECK(bleController.State() == Ble::FirmwareUpdateStates::Validated);
+    CHECK(std::equal(image.begin(), image.end(), spiNorFlash.memory.begin() + slotOffset));
+    CHECK(std::equal(std::begin(magic), std::end(magic), spiNorFlash.memory.begin() + slotOffset + slotSize - sizeof(magic)));
+
+    Write(handles.controlPoint, {0x05});
+    CHECK(!bleController.IsFirmwareUpdating());
+    std::printf("packets of %zu bytes (mbufs of %zu bytes) : %.1f MB/s\n", session.packetSize, session.mbufSize, image.size() / duration / 1e6);
+  }
+
+  // A corrupted transfer is rejected
+  Replay(dfuService, handles, image, {244, 244, static_cast<uint16_t>(crc ^ 1)});
+  CHECK(bleController.State() == Ble::FirmwareUpdateStates::Error);
+  CHECK(!bleController.IsFirmwareUpdating());
+  return 0;
+}
@@ -0,0 +1,148 @@
+// Decodes the compressed and delta DFU streams generated by tools/dfu_compress.py and tools/dfu_delta.py (see
+// dfu_streams.py), received in packets of random sizes, and prints the compression ratio, the decoding throughput
+// and the RAM used by the decoders.
+#include "components/ble/DfuDecompressor.h"
+#include "components/ble/DfuPatch.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <vector>
+#include "Check.h"
+
+using Pinetime::Controllers::DfuDecompressor;
+using Pinetime::Controllers::DfuPatch;
+
+namespace {
+  // Size of the OTA slot, and of the running image
+  constexpr size_t maxSize = 475136;
+  constexpr size_t maxTargetSize = maxSize - (2 * 4096);
+
+  std::vector<uint8_t> ReadFile(const char* path) {
+    std::ifstream file {path, std::ios::binary};
+    CHECK(file.good());
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+  }
+
+  // Feeds the stream in packets of random sizes (or packetSize) to the decoder, as DfuService::DfuImage does,
+  // and returns the decoded data
+  template <class DecodeFunction, class IsFinishedFunction>
+  std::vector<uint8_t> Decode(const std::vector<uint8_t>& stream, std::mt19937& random, size_t packetSize, DecodeFunction&& decode, IsFinishedFunction&& isFinished) {
+    std::vector<uint8_t> output;
+    uint8_t buffer[256];
+    size_t offset = 0;
+    while (offset < stream.size()) {
+      size_t size = std::min<size_t>((packetSize > 0) ? packetSize : 1 + random() % 509, stream.size() - offset);
+      const uint8_t* data = stream.data() + offset;
+      offset += size;
+
+      size_t produced;
+      do {
+        size_t outputSize = 1 + random() % sizeof(buffer);
+        produced = decode(data, size, buffer, outputSize);
+        output.insert(output.end(), buffer, buffer + produced);
+      } while (produced > 0 || (size > 0 && !isFinished()));
+    }
+    return output;
+  }
+
+  std::vector<uint8_t> Decompress(DfuDecompressor& decompressor, const std::vector<uint8_t>& stream, std::mt19937& random, size_t packetSize = 0) {
+    decompressor.Init(maxSize);
+    return Decode(
+      stream,
+      random,
+      packetSize,
+      [&decompressor](const uint8_t*& data, size_t& size, uint8_t* output, size_t outputSize) {
+        return decompressor.Decompress(data, size, output, outputSize);
+      },
+      [&decompressor]() {
+        return decompressor.IsDone() || decompressor.HasFailed();
+      });
+  }
+
+  std::vector<uint8_t> Patch(DfuPatch& patch, const std::vector<uint8_t>& source, const std::vector<uint8_t>& stream, std::mt19937& random) {
+    patch.Init(source.data(), maxSize, maxTargetSize);
+    return Decode(
+      stream,
+      random,
+      0,
+      [&patch](const uint8_t*& data, size_t& size, uint8_t* output, size_t outputSize) {
+        return patch.Apply(data, size, output, outputSize);
+      },
+      [&patch]() {
+        return patch.IsDone() || patch.HasFailed();
+      });
+  }
+
+  void TestCompressedImage(const std::vector<uint8_t>& image, const std::vector<uint8_t>& compressed, std::mt19937& random) {
+    static DfuDecompressor decompressor;
+    for (int i = 0; i < 10; i++) {
+      CHECK(Decompress(decompressor, compressed, random) == image);
+      CHECK(decompressor.IsValid());
+    }
+
+    // Benchmark with the packets of a 247 bytes MTU
+    auto start = std::chrono::steady_clock::now();
+    auto output = Decompress(decompressor, compressed, random, 244);
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+    CHECK(output == image);
+    std::printf("Compressed image : %zu -> %zu bytes (ratio %.2f), %.1f MB/s, decoder RAM %zu bytes\n",
+                image.size(),
+                compressed.size(),
+                static_cast<double>(image.size()) / compressed.size(),
+                image.size() / duration.count() / 1e6,
+                sizeof(DfuDecompressor));
+
+    // A corrupted stream is never accepted
+    for (int i = 0; i < 20; i++) {
+      auto corrupted = compressed;
+      corrupted[random() % corrupted.size()] ^= static_cast<uint8_t>(1 + random() % 255);
+      Decompress(decompressor, corrupted, random);
+      CHECK(!decompressor.IsValid());
+    }
+    std::vector<uint8_t> truncated(compressed.begin(), compressed.end() - 100);
+    Decompress(decompressor, truncated, random);
+    CHECK(!decompressor.IsValid());
+  }
+
+  void TestPatch(std::vector<uint8_t> oldImage,
+                 const std::vector<uint8_t>& newImage,
+                 const std::vector<uint8_t>& patchStream,
+                 const std::vector<uint8_t>& compressedPatch,
+                 std::mt19937& random) {
+    // The running image is read from the primary slot
+    oldImage.resize(maxSize, 0xff);
+    static DfuPatch patch;
+    for (int i = 0; i < 10; i++) {
+      CHECK(Patch(patch, oldImage, patchStream, random) == newImage);
+      CHECK(patch.IsValid());
+    }
+    std::printf("Patch : %zu bytes, %zu bytes compressed, for an image of %zu bytes, decoder RAM %zu bytes\n",
+                patchStream.size(),
+                compressedPatch.size(),
+                newImage.size(),
+                sizeof(DfuPatch));
+
+    // A compressed patch is decompressed, then applied
+    static DfuDecompressor decompressor;
+    CHECK(Decompress(decompressor, compressedPatch, random) == patchStream);
+    CHECK(decompressor.IsValid());
+
+    // The patch is rejected if the running image is not the one it was generated from
+    oldImage[random() % 1000] ^= 0x01;
+    Patch(patch, oldImage, patchStream, random);
+    CHECK(patch.HasFailed());
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc != 7) {
+    std::fprintf(stderr, "Usage : %s image image.z old new patch patch.z (see dfu_streams.py)\n", argv[0]);
+    return 1;
+  }
+  std::mt19937 random {9};
+  TestCompressedImage(ReadFile(argv[1]), ReadFile(argv[2]), random);
+  TestPatch(ReadFile(argv[3]), ReadFile(argv[4]), ReadFile(argv[5]), ReadFile(argv[6]), random);
+  return 0;
+}
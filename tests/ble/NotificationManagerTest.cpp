@@ -0,0 +1,138 @@
+#include "components/ble/NotificationManager.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <random>
+#include <string>
+#include <thread>
+#include "Check.h"
+
+using Pinetime::Controllers::NotificationManager;
+
+namespace {
+  struct StoredNotification {
+    NotificationManager::Notification::Id id;
+    std::string message;
+  };
+
+  // Random messages of every size pushed into the arena, compared to a model of the retained notifications.
+  // Walking the notifications checks that no message was overwritten by a newer one.
+  void TestWrapAround() {
+    NotificationManager manager;
+    CHECK(!manager.GetLastNotification().valid);
+    CHECK(manager.NbNotifications() == 0);
+
+    std::deque<StoredNotification> model;
+    std::mt19937 random {1};
+    NotificationManager::Notification::Id id = 0;
+    for (int i = 0; i < 200000; i++) {
+      size_t length = random() % 260;
+      std::string message;
+      for (size_t j = 0; j < length; j++) {
+        message += static_cast<char>('a' + random() % 26);
+      }
+      if (random() % 3 == 0 && length > 2) {
+        message[length / 2] = '\0';
+      }
+      auto size = static_cast<uint8_t>(std::min<size_t>(length + 1, 255));
+      manager.Push(NotificationManager::Categories::Sms, message.data(), size);
+      size_t storedSize = std::min<size_t>(size, NotificationManager::MessageSize + 1) - 1;
+      model.push_back({id++, message.substr(0, storedSize)});
+
+      size_t count = manager.NbNotifications();
+      CHECK(count >= 1 && count <= 16);
+      while (model.size() > count) {
+        model.pop_front();
+      }
+
+      // From the newest to the oldest notification
+      auto notification = manager.GetLastNotification();
+      for (size_t j = 0; j < count; j++) {
+        const auto& expected = model[count - 1 - j];
+        CHECK(notification.valid);
+        CHECK(notification.id == expected.id);
+        CHECK(notification.index == j + 1);
+        CHECK(notification.size == expected.message.size() + 1);
+        CHECK(std::memcmp(notification.message, expected.message.data(), expected.message.size()) == 0);
+        CHECK(notification.message[expected.message.size()] == '\0');
+        CHECK(manager.IsStored(notification));
+
+        auto previous = manager.GetPrevious(notification.id);
+        if (j + 1 < count) {
+          CHECK(manager.GetNext(previous.id).id == notification.id);
+        } else {
+          CHECK(!previous.valid);
+        }
+        notification = previous;
+      }
+      CHECK(!manager.GetNext(manager.GetLastNotification().id).valid);
+    }
+  }
+
+  void TestSmallMessages() {
+    NotificationManager manager;
+    for (int i = 0; i < 30; i++) {
+      manager.Push(NotificationManager::Categories::Sms, "Title\0hello", 12);
+      CHECK(manager.NbNotifications() == static_cast<size_t>(std::min(i + 1, 16)));
+    }
+    auto notification = manager.GetLastNotification();
+    CHECK(std::strcmp(notification.Title(), "Title") == 0);
+    CHECK(std::strcmp(notification.Message(), "hello") == 0);
+
+    manager.Push(NotificationManager::Categories::Sms, "body", 5);
+    notification = manager.GetLastNotification();
+    CHECK(notification.Title() == nullptr);
+    CHECK(std::strcmp(notification.Message(), "body") == 0);
+  }
+
+  // The BLE task pushes while the display task reads: a message copied from a view that is still stored afterwards
+  // must be the one that was pushed with this id.
+  void TestConcurrentPushAndRead() {
+    NotificationManager manager;
+    std::atomic<bool> stop {false};
+
+    auto Character = [](NotificationManager::Notification::Id id) {
+      return static_cast<char>('A' + id % 26);
+    };
+    auto Length = [](NotificationManager::Notification::Id id) {
+      return static_cast<size_t>(1 + (id * 37) % NotificationManager::MessageSize);
+    };
+
+    std::thread reader([&] {
+      char copy[NotificationManager::MessageSize + 1];
+      uint32_t nbChecked = 0;
+      while (!stop.load() || nbChecked == 0) {
+        auto notification = manager.GetLastNotification();
+        if (!notification.valid) {
+          continue;
+        }
+        std::memcpy(copy, notification.message, notification.size);
+        if (!manager.IsStored(notification)) {
+          continue;
+        }
+        CHECK(notification.size == Length(notification.id) + 1);
+        for (size_t i = 0; i < Length(notification.id); i++) {
+          CHECK(copy[i] == Character(notification.id));
+        }
+        nbChecked++;
+      }
+    });
+
+    std::string message;
+    for (uint32_t i = 0; i < 2000000; i++) {
+      auto id = static_cast<NotificationManager::Notification::Id>(i);
+      message.assign(Length(id), Character(id));
+      manager.Push(NotificationManager::Categories::Sms, message.c_str(), static_cast<uint8_t>(message.size() + 1));
+    }
+    stop.store(true);
+    reader.join();
+  }
+}
+
+int main() {
+  TestWrapAround();
+  TestSmallMessages();
+  TestConcurrentPushAndRead();
+  return 0;
+}
@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+
+# Generates the DFU streams checked by DfuStreamsTest with the tools of the repository, then runs the test :
+#   dfu_streams.py <DfuStreamsTest executable> <tools folder> <output folder>
+# The images are pseudo firmware images: code made of recurring instruction sequences, literal pools and strings.
+
+import os
+import random
+import subprocess
+import sys
+
+IMAGE_SIZE = 400 * 1024
+
+
+def random_bytes(rng, size):
+    return bytes(rng.getrandbits(8) for _ in range(size))
+
+
+def firmware(rng, size):
+    instructions = [random_bytes(rng, 2) for _ in range(128)]
+    sequences = [b''.join(rng.choice(instructions) for _ in range(rng.randint(2, 12))) for _ in range(100)]
+    words = [b'notification', b'weather', b'bluetooth', b'battery', b'settings', b'timer', b'alarm', b'steps']
+    image = bytearray()
+    while len(image) < size:
+        kind = rng.random()
+        if kind < 0.75:
+            for _ in range(rng.randint(2, 10)):
+                image += rng.choice(sequences) if rng.random() < 0.8 else rng.choice(instructions)
+        elif kind < 0.9:
+            image += random_bytes(rng, 4 * rng.randint(1, 8))
+        else:
+            image += b' '.join(rng.choice(words) for _ in range(rng.randint(1, 5))) + b'\0'
+    return bytes(image[:size])
+
+
+def new_version(rng, image):
+    """A few functions are modified, code is inserted and removed: the following code is shifted."""
+    new = bytearray(image)
+    for _ in range(30):
+        position = rng.randrange(len(new))
+        change = rng.random()
+        if change < 0.4:
+            size = rng.randint(1, 64)
+            new[position:position + size] = random_bytes(rng, size)
+        elif change < 0.7:
+            new[position:position] = firmware(rng, rng.randint(16, 1024))
+        else:
+            del new[position:position + rng.randint(16, 1024)]
+    return bytes(new)
+
+
+def run_tool(tools, name, *args):
+    subprocess.run([sys.executable, os.path.join(tools, name), *args], check=True, stdout=subprocess.DEVNULL)
+
+
+def main():
+    test, tools, output = sys.argv[1:4]
+    os.makedirs(output, exist_ok=True)
+    paths = {name: os.path.join(output, name) for name in ('image', 'image.z', 'old', 'new', 'patch', 'patch.z')}
+
+    rng = random.Random(5)
+    old = firmware(rng, IMAGE_SIZE)
+    for name, data in (('image', old), ('old', old), ('new', new_version(rng, old))):
+        with open(paths[name], 'wb') as f:
+            f.write(data)
+
+    run_tool(tools, 'dfu_compress.py', paths['image'], '-o', paths['image.z'])
+    run_tool(tools, 'dfu_delta.py', paths['old'], paths['new'], '-o', paths['patch'])
+    run_tool(tools, 'dfu_compress.py', paths['patch'], '-o', paths['patch.z'])
+
+    sys.exit(subprocess.run([test, *(paths[name] for name in ('image', 'image.z', 'old', 'new', 'patch', 'patch.z'))]).returncode)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,123 @@
+// Checks the table driven CRC engines against bitwise implementations and prints their throughput on the host.
+#include "components/crc/Crc.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "Check.h"
+
+using namespace Pinetime::Tools;
+
+namespace {
+  // The implementation of the Nordic SDK (crc16_compute())
+  uint16_t ReferenceCrc16(const uint8_t* data, size_t size, uint16_t crc = 0xffff) {
+    for (size_t i = 0; i < size; i++) {
+      crc = static_cast<uint8_t>(crc >> 8) | (crc << 8);
+      crc ^= data[i];
+      crc ^= static_cast<uint8_t>(crc & 0xff) >> 4;
+      crc ^= (crc << 8) << 4;
+      crc ^= ((crc & 0xff) << 4) << 1;
+    }
+    return crc;
+  }
+
+  uint32_t ReferenceCrc32(const uint8_t* data, size_t size) {
+    uint32_t crc = 0xffffffff;
+    for (size_t i = 0; i < size; i++) {
+      crc ^= data[i];
+      for (uint8_t bit = 0; bit < 8; bit++) {
+        crc = (crc & 1) ? ((crc >> 1) ^ 0xedb88320) : (crc >> 1);
+      }
+    }
+    return crc ^ 0xffffffff;
+  }
+
+  // Computes the CRC in chunks of random sizes, like the DFU packets and the FS service chunks
+  template <class Engine> auto ComputeInChunks(const std::vector<uint8_t>& data, std::mt19937& random) -> decltype(Engine {}.Value()) {
+    Engine engine;
+    size_t offset = 0;
+    while (offset < data.size()) {
+      size_t chunkSize = std::min<size_t>(random() % 300, data.size() - offset);
+      engine.Update(data.data() + offset, chunkSize);
+      offset += chunkSize;
+    }
+    return engine.Value();
+  }
+
+  template <class Engine> void CheckEngine(const std::vector<uint8_t>& data, std::mt19937& random) {
+    static const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    if (sizeof(Engine {}.Value()) == 2) {
+      CHECK(Engine::Compute(check, sizeof(check)) == 0x29b1);
+      CHECK(Engine::Compute(data.data(), data.size()) == ReferenceCrc16(data.data(), data.size()));
+      CHECK(ComputeInChunks<Engine>(data, random) == ReferenceCrc16(data.data(), data.size()));
+    } else {
+      CHECK(Engine::Compute(check, sizeof(check)) == 0xcbf43926);
+      CHECK(Engine::Compute(data.data(), data.size()) == ReferenceCrc32(data.data(), data.size()));
+      CHECK(ComputeInChunks<Engine>(data, random) == ReferenceCrc32(data.data(), data.size()));
+    }
+  }
+
+  // Throughput in MB/s, with chunks of the size of a DFU packet
+  template <class Compute> double Benchmark(const std::vector<uint8_t>& data, Compute&& compute) {
+    static constexpr int nbRuns = 20;
+    uint32_t result = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int run = 0; run < nbRuns; run++) {
+      result ^= compute();
+    }
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+    // Keep the result alive so the computation is not optimized away
+    volatile uint32_t sink = result;
+    (void) sink;
+    return nbRuns * data.size() / 1e6 / duration.count();
+  }
+
+  template <class Engine> double BenchmarkEngine(const std::vector<uint8_t>& data) {
+    return Benchmark(data, [&data]() {
+      Engine engine;
+      for (size_t offset = 0; offset < data.size(); offset += 200) {
+        engine.Update(data.data() + offset, std::min<size_t>(200, data.size() - offset));
+      }
+      return engine.Value();
+    });
+  }
+}
+
+int main() {
+  // The size of a DFU image
+  std::vector<uint8_t> data(400 * 1024 + 13);
+  std::mt19937 random {3};
+  for (auto& b : data) {
+    b = random();
+  }
+
+  CheckEngine<Crc16Engine<1>>(data, random);
+  CheckEngine<Crc16Engine<4>>(data, random);
+  CheckEngine<Crc16Engine<8>>(data, random);
+  CheckEngine<Crc32Engine<1>>(data, random);
+  CheckEngine<Crc32Engine<4>>(data, random);
+  CheckEngine<Crc32Engine<8>>(data, random);
+
+  double reference16 = Benchmark(data, [&data]() {
+    uint16_t crc = 0xffff;
+    for (size_t offset = 0; offset < data.size(); offset += 200) {
+      crc = ReferenceCrc16(data.data() + offset, std::min<size_t>(200, data.size() - offset), crc);
+    }
+    return crc;
+  });
+  std::printf("CRC16 MB/s : bitwise %.0f, 1 table %.0f, 4 tables %.0f, 8 tables %.0f\n",
+              reference16,
+              BenchmarkEngine<Crc16Engine<1>>(data),
+              BenchmarkEngine<Crc16Engine<4>>(data),
+              BenchmarkEngine<Crc16Engine<8>>(data));
+  std::printf("CRC32 MB/s : bitwise %.0f, 1 table %.0f, 4 tables %.0f, 8 tables %.0f\n",
+              Benchmark(data,
+                        [&data]() {
+                          return ReferenceCrc32(data.data(), data.size());
+                        }),
+              BenchmarkEngine<Crc32Engine<1>>(data),
+              BenchmarkEngine<Crc32Engine<4>>(data),
+              BenchmarkEngine<Crc32Engine<8>>(data));
+  return 0;
+}
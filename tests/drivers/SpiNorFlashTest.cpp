@@ -0,0 +1,252 @@
+// Runs the external flash driver against a model of the memory : queued page programs, reads and programs during an
+// erase (suspend/resume), program failures. Prints how long the caller waits per page when a DFU writes the image.
+#include "drivers/SpiNorFlash.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "Check.h"
+#include "drivers/Spi.h"
+#include "task.h"
+
+using namespace Pinetime::Drivers;
+
+namespace {
+  constexpr size_t pageSize = 256;
+
+  struct Harness {
+    Harness() : flash {spi} {
+      flash.Init();
+      timer = Stubs::FindTimer("flashProgram");
+      CHECK(timer != nullptr);
+    }
+
+    // The timer task runs when the other tasks are blocked for a tick
+    void RunTimerTask(unsigned nbTicks) {
+      for (unsigned i = 0; i < nbTicks; i++) {
+        Stubs::TickCount()++;
+        Stubs::ExpireTimer(timer);
+      }
+    }
+
+    unsigned RunTimerTaskUntilIdle() {
+      unsigned nbTicks = 0;
+      while (xTimerIsTimerActive(timer)) {
+        RunTimerTask(1);
+        nbTicks++;
+        CHECK(nbTicks < 10000);
+      }
+      return nbTicks;
+    }
+
+    Spi spi;
+    SpiNorFlash flash;
+    TimerHandle_t timer;
+  };
+
+  std::vector<uint8_t> RandomData(std::mt19937& random, size_t size) {
+    std::vector<uint8_t> data(size);
+    for (auto& byte : data) {
+      byte = static_cast<uint8_t>(random());
+    }
+    return data;
+  }
+
+  void TestQueue() {
+    std::mt19937 random(1);
+    Harness harness;
+    auto data = RandomData(random, 10 * pageSize);
+
+    // The first page is programmed right away, the next ones are queued : the caller doesn't wait
+    uint64_t start = Spi::Now();
+    harness.flash.Write(0x1000, data.data(), 4 * pageSize);
+    CHECK(Spi::Now() - start < Spi::pageProgramTime);
+    CHECK(harness.spi.nbPrograms == 1);
+    CHECK(xTimerIsTimerActive(harness.timer));
+
+    // The timer programs a page per tick
+    CHECK(harness.RunTimerTaskUntilIdle() == 3);
+    CHECK(harness.spi.nbPrograms == 4);
+
+    // When the queue is full, the caller waits for the programs of the oldest pages, without blocking
+    harness.flash.WaitForCompletion();
+    start = Spi::Now();
+    TickType_t startTick = xTaskGetTickCount();
+    harness.flash.Write(0x2000, data.data(), 7 * pageSize);
+    CHECK(xTaskGetTickCount() == startTick);
+    CHECK(Spi::Now() - start > 2 * Spi::pageProgramTime);
+    CHECK(Spi::Now() - start < 4 * Spi::pageProgramTime);
+
+    // The pages are read back even if they are still queued
+    std::vector<uint8_t> read(7 * pageSize);
+    harness.flash.Read(0x2000, read.data(), read.size());
+    CHECK(std::equal(read.begin(), read.end(), data.begin()));
+    CHECK(std::equal(data.begin(), data.begin() + 4 * pageSize, harness.spi.memory.begin() + 0x1000));
+    CHECK(harness.spi.nbViolations == 0);
+
+    // Unaligned writes
+    harness.flash.Write(0x3080, data.data(), 3 * pageSize + 10);
+    harness.flash.WaitForCompletion();
+    CHECK(std::equal(data.begin(), data.begin() + 3 * pageSize + 10, harness.spi.memory.begin() + 0x3080));
+    CHECK(harness.spi.nbPrograms == 4 + 7 + 4);
+    CHECK(!harness.flash.ProgramFailed());
+    CHECK(harness.spi.nbViolations == 0);
+  }
+
+  void TestWritesDuringErase() {
+    std::mt19937 random(2);
+    Harness harness;
+    auto data = RandomData(random, 8 * pageSize);
+    harness.spi.memory[0x30000 + 8 * pageSize] = 0x5a;
+
+    CHECK(harness.flash.StartErase(0x10000, 0x10000) == 0x10000);
+    uint64_t eraseStart = Spi::Now();
+    harness.flash.Write(0x30000, data.data(), data.size());
+    harness.RunTimerTaskUntilIdle();
+    CHECK(harness.spi.IsErasing());
+    CHECK(harness.spi.nbProgramsDuringErase == 8);
+
+    // Reads outside of the block being erased don't wait for the erase, even right after a resume
+    std::vector<uint8_t> read(data.size() + 1);
+    uint64_t start = Spi::Now();
+    for (int i = 0; i < 10; i++) {
+      harness.flash.Read(0x30000, read.data(), read.size());
+      CHECK(std::equal(data.begin(), data.end(), read.begin()));
+      CHECK(read.back() == 0x5a);
+    }
+    CHECK(Spi::Now() - start < 10 * (Spi::resumeToSuspendTime + read.size() + 100));
+    CHECK(harness.spi.IsErasing());
+
+    // Reads inside the block wait for the end of the erase
+    harness.flash.Read(0x18000, read.data(), read.size());
+    CHECK(std::all_of(read.begin(), read.end(), [](uint8_t byte) {
+      return byte == 0xff;
+    }));
+    CHECK(Spi::Now() - eraseStart >= Spi::block64KBEraseTime);
+    CHECK(!harness.spi.IsErasing());
+    CHECK(harness.spi.nbViolations == 0);
+  }
+
+  void TestSuspendNotAccepted() {
+    Harness harness;
+    harness.spi.ignoreSuspend = true;
+    harness.spi.memory[0x40000] = 0x12;
+
+    harness.flash.StartErase(0x10000, 0x1000);
+    uint64_t start = Spi::Now();
+    uint8_t byte = 0;
+    harness.flash.Read(0x40000, &byte, 1);
+    CHECK(byte == 0x12);
+    CHECK(Spi::Now() - start >= Spi::sectorEraseTime);
+    CHECK(!harness.spi.IsErasing());
+    CHECK(harness.spi.nbViolations == 0);
+  }
+
+  void TestProgramFailure() {
+    std::mt19937 random(3);
+    Harness harness;
+    auto data = RandomData(random, 3 * pageSize);
+    harness.spi.failProgramAddress = 0x5000 + pageSize + 12;
+
+    // The failure of a page is reported even if the next ones succeed
+    harness.flash.Write(0x5000, data.data(), data.size());
+    CHECK(harness.flash.ProgramFailed());
+    CHECK(!harness.flash.ProgramFailed());
+    CHECK(harness.spi.nbPrograms == 3);
+    CHECK(harness.spi.nbViolations == 0);
+  }
+
+  // Random operations, compared with a model that applies them immediately
+  void TestRandomOperations() {
+    std::mt19937 random(4);
+    Harness harness;
+    std::vector<uint8_t> expected(Spi::size, 0xff);
+    constexpr uint32_t area = 0x80000;
+
+    for (int i = 0; i < 20000; i++) {
+      uint32_t address = random() % (area - 2048);
+      switch (random() % 8) {
+        case 0:
+        case 1:
+        case 2: {
+          auto data = RandomData(random, 1 + random() % 1500);
+          harness.flash.Write(address, data.data(), data.size());
+          for (size_t j = 0; j < data.size(); j++) {
+            expected[address + j] &= data[j];
+          }
+          break;
+        }
+        case 3:
+        case 4: {
+          std::vector<uint8_t> read(1 + random() % 2000);
+          harness.flash.Read(address, read.data(), read.size());
+          CHECK(std::equal(read.begin(), read.end(), expected.begin() + address));
+          break;
+        }
+        case 5: {
+          if (random() % 8 == 0) {
+            size_t erased = harness.flash.StartErase(address & ~0xfffu, 0x1000 * (1 + random() % 32));
+            std::fill_n(expected.begin() + (address & ~0xfffu), erased, 0xff);
+          }
+          break;
+        }
+        case 6:
+          harness.RunTimerTask(1 + random() % 3);
+          break;
+        default:
+          CHECK(!harness.flash.ProgramFailed());
+          break;
+      }
+      CHECK(harness.spi.nbViolations == 0);
+    }
+    harness.flash.WaitForCompletion();
+    CHECK(!harness.spi.IsErasing());
+    CHECK(std::equal(expected.begin(), expected.begin() + area, harness.spi.memory.begin()));
+    CHECK(harness.spi.nbViolations == 0);
+  }
+
+  // A DFU writes a page every few ms and erases the next block ahead
+  void Benchmark() {
+    std::mt19937 random(5);
+    Harness harness;
+    auto data = RandomData(random, pageSize);
+    constexpr unsigned nbPages = 1024;
+    constexpr uint32_t imageOffset = 0x40000;
+    uint64_t waited = 0;
+    uint32_t erased = 0;
+    for (unsigned page = 0; page < nbPages; page++) {
+      uint32_t address = imageOffset + page * pageSize;
+      if (erased <= page * pageSize) {
+        erased += harness.flash.StartErase(imageOffset + erased, nbPages * pageSize - erased);
+      }
+      uint64_t start = Spi::Now();
+      harness.flash.Write(address, data.data(), data.size());
+      if (erased < nbPages * pageSize && !harness.flash.IsErasing()) {
+        erased += harness.flash.StartErase(imageOffset + erased, nbPages * pageSize - erased);
+      }
+      waited += Spi::Now() - start;
+      // 2 packets of 244 bytes per connection interval of 7.5ms
+      harness.RunTimerTask(4);
+    }
+    harness.flash.WaitForCompletion();
+    CHECK(harness.spi.nbViolations == 0);
+    for (unsigned page = 0; page < nbPages; page++) {
+      CHECK(std::equal(data.begin(), data.end(), harness.spi.memory.begin() + imageOffset + page * pageSize));
+    }
+    std::printf("DFU of %u pages : the BLE task waits %.0f us per page for the flash, %u pages programmed during an erase\n",
+                nbPages,
+                static_cast<double>(waited) / nbPages,
+                harness.spi.nbProgramsDuringErase);
+  }
+}
+
+int main() {
+  TestQueue();
+  TestWritesDuringErase();
+  TestSuspendNotAccepted();
+  TestProgramFailure();
+  TestRandomOperations();
+  Benchmark();
+  std::printf("SpiNorFlashTest passed\n");
+  return 0;
+}
@@ -0,0 +1,210 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "FreeRTOS.h"
+#include "libraries/delay/nrf_delay.h"
+
+namespace Pinetime {
+  namespace Drivers {
+    // Model of the external NOR flash on the SPI bus : it executes the commands sent by SpiNorFlash with the timings of
+    // the datasheet, and counts the commands that the memory would reject or execute wrongly.
+    class Spi {
+    public:
+      static constexpr size_t size = 4 * 1024 * 1024;
+      static constexpr uint64_t pageProgramTime = 700;
+      static constexpr uint64_t sectorEraseTime = 45000;
+      static constexpr uint64_t block32KBEraseTime = 150000;
+      static constexpr uint64_t block64KBEraseTime = 250000;
+      static constexpr uint64_t suspendTime = 20;
+      static constexpr uint64_t resumeToSuspendTime = 100;
+
+      Spi() : memory(size, 0xff) {
+      }
+
+      bool Write(const uint8_t* data, size_t dataSize) {
+        Execute(data, dataSize, nullptr, 0, nullptr, 0);
+        return true;
+      }
+
+      bool Read(uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize) {
+        Execute(cmd, cmdSize, nullptr, 0, data, dataSize);
+        return true;
+      }
+
+      bool WriteCmdAndBuffer(const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize) {
+        Execute(cmd, cmdSize, data, dataSize, nullptr, 0);
+        return true;
+      }
+
+      // In µs, the tick count advances when a task blocks, the µs when it waits actively
+      static uint64_t Now() {
+        return uint64_t {Stubs::TickCount()} * 1000000 / configTICK_RATE_HZ + Stubs::Microseconds();
+      }
+
+      bool IsErasing() {
+        Update();
+        return eraseState != EraseStates::None;
+      }
+
+      std::vector<uint8_t> memory;
+
+      // The program of the page that contains this address fails
+      uint32_t failProgramAddress = UINT32_MAX;
+      // The memory ignores the erase suspend command
+      bool ignoreSuspend = false;
+
+      unsigned nbViolations = 0;
+      unsigned nbPrograms = 0;
+      unsigned nbProgramsDuringErase = 0;
+      unsigned nbSuspends = 0;
+
+    private:
+      enum class EraseStates { None, Running, Suspended };
+
+      bool writeEnabled = false;
+      bool programFailed = false;
+      bool asleep = false;
+      uint64_t programEnd = 0;
+      EraseStates eraseState = EraseStates::None;
+      uint32_t eraseAddress = 0;
+      uint32_t eraseSize = 0;
+      uint64_t eraseEnd = 0;
+      uint64_t eraseRemaining = 0;
+      uint64_t suspendEnd = 0;
+      uint64_t resumeTime = 0;
+
+      void Violation() {
+        nbViolations++;
+      }
+
+      void Update() {
+        if (eraseState == EraseStates::Running && Now() >= eraseEnd) {
+          std::memset(memory.data() + eraseAddress, 0xff, eraseSize);
+          eraseState = EraseStates::None;
+        }
+      }
+
+      bool WriteInProgress() const {
+        return Now() < programEnd || eraseState == EraseStates::Running || (eraseState == EraseStates::Suspended && Now() < suspendEnd);
+      }
+
+      bool IsBeingErased(uint32_t address, size_t length) const {
+        return eraseState != EraseStates::None && address < eraseAddress + eraseSize && address + length > eraseAddress;
+      }
+
+      static uint32_t Address(const uint8_t* cmd) {
+        return (cmd[1] << 16) | (cmd[2] << 8) | cmd[3];
+      }
+
+      void StartErase(uint32_t address, uint32_t length, uint64_t duration) {
+        if (WriteInProgress() || eraseState != EraseStates::None || !writeEnabled || (address % length) != 0) {
+          Violation();
+          return;
+        }
+        writeEnabled = false;
+        eraseState = EraseStates::Running;
+        eraseAddress = address;
+        eraseSize = length;
+        eraseEnd = Now() + duration;
+      }
+
+      void Execute(const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize, uint8_t* response, size_t responseSize) {
+        // 8MHz : 1µs per byte
+        Stubs::Microseconds() += cmdSize + dataSize + responseSize;
+        Update();
+
+        if (asleep && cmd[0] != 0xAB) {
+          Violation();
+          return;
+        }
+        switch (cmd[0]) {
+          case 0x05: // Read status register
+            response[0] = (WriteInProgress() ? 0x01 : 0) | (writeEnabled ? 0x02 : 0);
+            break;
+          case 0x06: // Write enable
+            writeEnabled = true;
+            break;
+          case 0x02: { // Page program
+            uint32_t address = Address(cmd);
+            if (WriteInProgress() || !writeEnabled || dataSize > 256 || IsBeingErased(address, dataSize)) {
+              Violation();
+              return;
+            }
+            writeEnabled = false;
+            programFailed = failProgramAddress / 256 == address / 256;
+            if (!programFailed) {
+              // The address wraps within the page
+              for (size_t i = 0; i < dataSize; i++) {
+                memory[(address & ~0xffu) | ((address + i) & 0xffu)] &= data[i];
+              }
+            }
+            programEnd = Now() + pageProgramTime;
+            nbPrograms++;
+            nbProgramsDuringErase += (eraseState == EraseStates::Suspended);
+            break;
+          }
+          case 0x20:
+            StartErase(Address(cmd), 0x1000, sectorEraseTime);
+            break;
+          case 0x52:
+            StartErase(Address(cmd), 0x8000, block32KBEraseTime);
+            break;
+          case 0xD8:
+            StartErase(Address(cmd), 0x10000, block64KBEraseTime);
+            break;
+          case 0x75: // Erase suspend
+            if (eraseState == EraseStates::Running && !ignoreSuspend) {
+              if (Now() < resumeTime + resumeToSuspendTime) {
+                Violation();
+              }
+              nbSuspends++;
+              eraseState = EraseStates::Suspended;
+              eraseRemaining = eraseEnd - Now();
+              suspendEnd = Now() + suspendTime;
+            }
+            break;
+          case 0x7A: // Erase resume
+            if (eraseState == EraseStates::Suspended) {
+              if (Now() < suspendEnd || Now() < programEnd) {
+                Violation();
+              }
+              eraseState = EraseStates::Running;
+              eraseEnd = Now() + eraseRemaining;
+              resumeTime = Now();
+            }
+            break;
+          case 0x03: { // Read
+            uint32_t address = Address(cmd);
+            if (WriteInProgress() || IsBeingErased(address, responseSize)) {
+              Violation();
+            }
+            std::memcpy(response, memory.data() + address, responseSize);
+            break;
+          }
+          case 0x2B: // Read security register
+            response[0] = programFailed ? 0x20 : 0;
+            break;
+          case 0x9F: // Read identification
+            response[0] = 0x0b;
+            response[1] = 0x40;
+            response[2] = 0x16;
+            break;
+          case 0xB9: // Deep power down
+            if (WriteInProgress()) {
+              Violation();
+            }
+            asleep = true;
+            break;
+          case 0xAB: // Release from deep power down
+            asleep = false;
+            break;
+          default:
+            Violation();
+            break;
+        }
+      }
+    };
+  }
+}
@@ -0,0 +1,94 @@
+#include "components/fs/FlashCache.h"
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "Check.h"
+#include "drivers/SpiNorFlash.h"
+
+using Pinetime::Controllers::FlashCache;
+using Pinetime::Drivers::SpiNorFlash;
+
+namespace {
+  // Bytes of a line read while other bytes of the same line are still in the write buffer
+  void TestReadNextToBufferedWrite() {
+    SpiNorFlash flash;
+    FlashCache cache {flash};
+
+    const uint8_t written[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    CHECK(cache.Write(0x1000, written, sizeof(written)));
+
+    uint8_t other[16];
+    cache.Read(0x1080, other, sizeof(other));
+    for (auto b : other) {
+      CHECK(b == 0xff);
+    }
+
+    uint8_t readBack[16];
+    cache.Read(0x1000, readBack, sizeof(readBack));
+    CHECK(std::memcmp(readBack, written, sizeof(written)) == 0);
+  }
+
+  void TestProgramFailure() {
+    SpiNorFlash flash;
+    FlashCache cache {flash};
+    std::vector<uint8_t> page(256, 0x55);
+
+    // A full page is programmed by the write itself
+    flash.failProgramAddress = 0x2000;
+    CHECK(!cache.Write(0x2000, page.data(), page.size()));
+    CHECK(cache.Write(0x2100, page.data(), page.size()));
+
+    // A partial page is programmed by the flush
+    flash.failProgramAddress = 0x3000;
+    CHECK(cache.Write(0x3000, page.data(), 16));
+    CHECK(!cache.Flush());
+    CHECK(cache.Flush());
+  }
+
+  // Random reads, writes and erases compared to a model of the memory
+  void TestRandomOperations() {
+    static constexpr uint32_t areaSize = 64 * 1024;
+    SpiNorFlash flash;
+    FlashCache cache {flash};
+    std::vector<uint8_t> model(areaSize, 0xff);
+    std::vector<uint8_t> buffer(1024);
+    std::mt19937 random {42};
+
+    uint32_t nextWrite = 0;
+    for (int i = 0; i < 200000; i++) {
+      auto operation = random() % 100;
+      if (operation < 45) {
+        // littlefs mostly programs contiguous data
+        uint32_t address = (random() % 4 == 0) ? random() % areaSize : nextWrite;
+        size_t size = std::min<size_t>(1 + random() % 300, areaSize - address);
+        for (size_t j = 0; j < size; j++) {
+          buffer[j] = random();
+          model[address + j] &= buffer[j];
+        }
+        CHECK(cache.Write(address, buffer.data(), size));
+        nextWrite = (address + size) % areaSize;
+      } else if (operation < 95) {
+        uint32_t address = random() % areaSize;
+        size_t size = std::min<size_t>(1 + random() % ((random() % 8 == 0) ? 1024 : 64), areaSize - address);
+        cache.Read(address, buffer.data(), size);
+        CHECK(std::memcmp(buffer.data(), model.data() + address, size) == 0);
+      } else if (operation < 98) {
+        uint32_t address = (random() % areaSize) & ~(SpiNorFlash::sectorSize - 1u);
+        CHECK(cache.Erase(address, SpiNorFlash::sectorSize));
+        std::memset(model.data() + address, 0xff, SpiNorFlash::sectorSize);
+      } else {
+        CHECK(cache.Flush());
+      }
+    }
+    CHECK(cache.Flush());
+    CHECK(std::memcmp(flash.memory.data(), model.data(), areaSize) == 0);
+  }
+}
+
+int main() {
+  TestReadNextToBufferedWrite();
+  TestProgramFailure();
+  TestRandomOperations();
+  return 0;
+}
@@ -0,0 +1,138 @@
+// littlefs over the flash cache and a RAM model of the external flash memory, configured like Pinetime::Controllers::FS.
+// Every read must return what was written last, including when programs fail and littlefs relocates blocks.
+#include <littlefs/lfs.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "Check.h"
+#include "components/fs/FlashCache.h"
+#include "drivers/SpiNorFlash.h"
+
+using Pinetime::Controllers::FlashCache;
+using Pinetime::Drivers::SpiNorFlash;
+
+namespace {
+  constexpr uint32_t startAddress = 0x0B4000;
+  constexpr uint32_t size = 0x34C000;
+  constexpr uint32_t blockSize = 4096;
+
+  SpiNorFlash flash;
+  FlashCache flashCache {flash};
+
+  int SectorSync(const struct lfs_config* c) {
+    return flashCache.Flush() ? 0 : -1;
+  }
+
+  int SectorErase(const struct lfs_config* c, lfs_block_t block) {
+    return flashCache.Erase(startAddress + (block * blockSize), blockSize) ? 0 : -1;
+  }
+
+  int SectorProg(const struct lfs_config* c, lfs_block_t block, lfs_off_t off, const void* buffer, lfs_size_t size) {
+    const uint32_t address = startAddress + (block * blockSize) + off;
+    return flashCache.Write(address, static_cast<const uint8_t*>(buffer), size) ? 0 : LFS_ERR_CORRUPT;
+  }
+
+  int SectorRead(const struct lfs_config* c, lfs_block_t block, lfs_off_t off, void* buffer, lfs_size_t size) {
+    flashCache.Read(startAddress + (block * blockSize) + off, static_cast<uint8_t*>(buffer), size);
+    return 0;
+  }
+
+  lfs_config MakeConfig() {
+    lfs_config config {};
+    config.read = SectorRead;
+    config.prog = SectorProg;
+    config.erase = SectorErase;
+    config.sync = SectorSync;
+    config.read_size = 16;
+    config.prog_size = 8;
+    config.block_size = blockSize;
+    config.block_count = size / blockSize;
+    config.block_cycles = 1000u;
+    config.cache_size = 16;
+    config.lookahead_size = 16;
+    config.name_max = 50;
+    config.attr_max = 50;
+    return config;
+  }
+
+  void WriteFile(lfs_t& lfs, const std::string& name, const std::vector<uint8_t>& content, std::mt19937& random) {
+    lfs_file_t file;
+    CHECK(lfs_file_open(&lfs, &file, name.c_str(), LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) == 0);
+    size_t offset = 0;
+    while (offset < content.size()) {
+      // Chunks of the size of the FS service and settings writes
+      size_t chunkSize = std::min<size_t>(1 + random() % 500, content.size() - offset);
+      CHECK(lfs_file_write(&lfs, &file, content.data() + offset, chunkSize) == static_cast<lfs_ssize_t>(chunkSize));
+      offset += chunkSize;
+    }
+    CHECK(lfs_file_close(&lfs, &file) == 0);
+  }
+
+  void CheckFile(lfs_t& lfs, const std::string& name, const std::vector<uint8_t>& content) {
+    lfs_file_t file;
+    CHECK(lfs_file_open(&lfs, &file, name.c_str(), LFS_O_RDONLY) == 0);
+    CHECK(lfs_file_size(&lfs, &file) == static_cast<lfs_soff_t>(content.size()));
+    std::vector<uint8_t> buffer(content.size() + 1);
+    CHECK(lfs_file_read(&lfs, &file, buffer.data(), buffer.size()) == static_cast<lfs_ssize_t>(content.size()));
+    CHECK(std::memcmp(buffer.data(), content.data(), content.size()) == 0);
+    CHECK(lfs_file_close(&lfs, &file) == 0);
+  }
+}
+
+int main() {
+  lfs_config config = MakeConfig();
+  lfs_t lfs;
+  CHECK(lfs_format(&lfs, &config) == 0);
+  CHECK(lfs_mount(&lfs, &config) == 0);
+
+  std::mt19937 random {7};
+  std::map<std::string, std::vector<uint8_t>> files;
+  for (int i = 0; i < 3000; i++) {
+    std::string name = "/file" + std::to_string(random() % 20);
+    auto operation = random() % 10;
+    if (operation < 5) {
+      std::vector<uint8_t> content(random() % ((random() % 10 == 0) ? 20000 : 600));
+      for (auto& b : content) {
+        b = random();
+      }
+      // The superblock pair (blocks 0 and 1) cannot be relocated
+      if (random() % 8 == 0) {
+        flash.failProgramAddress = startAddress + (2 * blockSize) + (random() % (size - (2 * blockSize)));
+      }
+      WriteFile(lfs, name, content, random);
+      files[name] = content;
+    } else if (operation < 8) {
+      auto file = files.find(name);
+      if (file != files.end()) {
+        CheckFile(lfs, name, file->second);
+      }
+    } else if (operation < 9) {
+      if (files.erase(name) > 0) {
+        CHECK(lfs_remove(&lfs, name.c_str()) == 0);
+      }
+    } else {
+      CHECK(lfs_unmount(&lfs) == 0);
+      CHECK(lfs_mount(&lfs, &config) == 0);
+    }
+  }
+
+  flash.failProgramAddress = 0xffffffff;
+  CHECK(lfs_unmount(&lfs) == 0);
+  CHECK(lfs_mount(&lfs, &config) == 0);
+  for (const auto& file : files) {
+    CheckFile(lfs, file.first, file.second);
+  }
+  CHECK(lfs_unmount(&lfs) == 0);
+
+  const auto& statistics = flashCache.GetStatistics();
+  std::printf("hits %u, misses %u, flash reads %u, flash writes %u\n",
+              static_cast<unsigned>(statistics.hits),
+              static_cast<unsigned>(statistics.misses),
+              static_cast<unsigned>(statistics.flashReads),
+              static_cast<unsigned>(statistics.flashWrites));
+  return 0;
+}
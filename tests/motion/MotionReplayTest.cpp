@@ -0,0 +1,203 @@
+// Replays a recorded-like accelerometer trace (100Hz) through the batch API of the motion controller, in FIFO
+// batches of several sizes, checks the wake-up gestures against a replay one sample at a time and prints the cost per sample.
+#include "components/motion/MotionController.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "Check.h"
+#include "systemtask/SystemTask.h"
+
+using namespace Pinetime::Controllers;
+using Sample = MotionController::Sample;
+
+// The BLE service is replaced by these definitions, which record the notifications
+namespace {
+  std::vector<uint32_t> stepCountNotifications;
+  std::vector<Sample> motionNotifications;
+}
+
+MotionService::MotionService(Pinetime::System::SystemTask& system, Controllers::MotionController& motionController)
+  : system {system}, motionController {motionController} {
+}
+
+void MotionService::OnNewStepCountValue(uint32_t stepCount) {
+  stepCountNotifications.push_back(stepCount);
+}
+
+void MotionService::OnNewMotionValues(int16_t x, int16_t y, int16_t z) {
+  motionNotifications.push_back({x, y, z});
+}
+
+namespace {
+  constexpr uint16_t shakeThreshold = 150; // Default of the settings
+  constexpr uint8_t batchSizes[] = {1, 7, Pinetime::Drivers::Bma421::fifoWatermark, Pinetime::Drivers::Bma421::maxSamples};
+
+  struct Phase {
+    const char* name;
+    size_t begin;
+    size_t end;
+  };
+
+  // Wrist at rest, raise, watch held in front of the face, rest, shake, rest
+  std::vector<Sample> MakeTrace(std::vector<Phase>& phases) {
+    std::mt19937 random(3);
+    std::uniform_int_distribution<int> noise(-4, 4);
+    std::vector<Sample> trace;
+    auto add = [&](const char* name, int nbSamples, auto function) {
+      size_t begin = trace.size();
+      for (int i = 0; i < nbSamples; i++) {
+        Sample sample = function(i);
+        sample.x += noise(random);
+        sample.y += noise(random);
+        sample.z += noise(random);
+        trace.push_back(sample);
+      }
+      phases.push_back({name, begin, trace.size()});
+    };
+
+    // The shake speed is computed from the previous sample, which is 0 for the first one
+    add("start", 100, [](int) {
+      return Sample {0, 60, -1000};
+    });
+    add("rest", 300, [](int) {
+      return Sample {0, 60, -1000};
+    });
+    add("raise", 40, [](int i) {
+      return Sample {0, static_cast<int16_t>(60 - i * 17), static_cast<int16_t>(-1000 + i * 5)};
+    });
+    add("hold", 200, [](int) {
+      return Sample {0, -620, -800};
+    });
+    add("lower", 40, [](int i) {
+      return Sample {0, static_cast<int16_t>(-620 + i * 17), static_cast<int16_t>(-800 - i * 5)};
+    });
+    add("rest", 200, [](int) {
+      return Sample {0, 60, -1000};
+    });
+    add("shake", 200, [](int i) {
+      double phase = i * 2 * M_PI / 12; // About 8Hz
+      return Sample {static_cast<int16_t>(800 * std::sin(phase)),
+                     static_cast<int16_t>(600 * std::sin(phase + 1)),
+                     static_cast<int16_t>(-300 + 700 * std::sin(phase))};
+    });
+    add("rest", 600, [](int) {
+      return Sample {0, 60, -1000};
+    });
+    return trace;
+  }
+
+  struct Detections {
+    std::vector<bool> raise;
+    std::vector<bool> shake;
+  };
+
+  // Returns, for each batch, whether a gesture was detected
+  Detections Replay(const std::vector<Sample>& trace, uint8_t batchSize) {
+    MotionController controller;
+    Detections detections;
+    uint32_t steps = 0;
+    for (size_t i = 0; i < trace.size(); i += batchSize) {
+      auto nbSamples = static_cast<uint8_t>(std::min<size_t>(batchSize, trace.size() - i));
+      steps += nbSamples / 4;
+      controller.Update(&trace[i], nbSamples, steps);
+      detections.raise.push_back(controller.Should_RaiseWake(true));
+      detections.shake.push_back(controller.Should_ShakeWake(shakeThreshold));
+      CHECK(controller.X() == trace[i + nbSamples - 1].x);
+      CHECK(controller.Y() == trace[i + nbSamples - 1].y);
+      CHECK(controller.Z() == trace[i + nbSamples - 1].z);
+      CHECK(controller.NbSteps() == steps);
+      CHECK(controller.GetTripSteps() == steps);
+    }
+    return detections;
+  }
+
+  bool DetectedIn(const std::vector<bool>& detections, const Phase& phase) {
+    for (size_t i = phase.begin; i < phase.end; i++) {
+      if (detections[i]) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void TestGestures() {
+    std::vector<Phase> phases;
+    auto trace = MakeTrace(phases);
+    auto reference = Replay(trace, 1);
+
+    for (size_t i = 1; i < phases.size(); i++) {
+      bool raise = DetectedIn(reference.raise, phases[i]);
+      bool shake = DetectedIn(reference.shake, phases[i]);
+      std::printf("%-6s : raise %d, shake %d\n", phases[i].name, raise, shake);
+      // The wrist also goes up and down while shaking
+      CHECK(raise == (phases[i].name == std::string("raise")) || phases[i].name == std::string("shake"));
+      // The speed average takes a few hundred ms to decay after the shake
+      bool afterShake = i > 0 && phases[i - 1].name == std::string("shake");
+      CHECK(shake == (phases[i].name == std::string("shake")) || (afterShake && shake));
+    }
+    CHECK(!reference.shake.back());
+
+    // A batch reports a gesture if and only if one of its samples does when the samples are processed one at a time
+    for (uint8_t batchSize : batchSizes) {
+      auto detections = Replay(trace, batchSize);
+      for (size_t batch = 0; batch < detections.raise.size(); batch++) {
+        Phase samples {"", batch * batchSize, std::min(trace.size(), (batch + 1) * batchSize)};
+        CHECK(detections.raise[batch] == DetectedIn(reference.raise, samples));
+        CHECK(detections.shake[batch] == DetectedIn(reference.shake, samples));
+      }
+    }
+  }
+
+  void TestService() {
+    MotionController controller;
+    Pinetime::System::SystemTask system;
+    MotionService service {system, controller};
+    controller.SetService(&service);
+
+    Sample samples[3] = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+    controller.Update(samples, 3, 10);
+    controller.Update(samples + 2, 1, 10);
+    controller.Update(samples, 0, 12);
+    CHECK(stepCountNotifications.size() == 2 && stepCountNotifications.back() == 12);
+    CHECK(motionNotifications.size() == 1);
+    CHECK(motionNotifications[0].x == 7 && motionNotifications[0].y == 8 && motionNotifications[0].z == 9);
+    CHECK(controller.X() == 7 && controller.NbSteps() == 12);
+  }
+
+  void Benchmark() {
+    std::vector<Phase> phases;
+    auto trace = MakeTrace(phases);
+    constexpr int nbReplays = 500;
+    for (uint8_t batchSize : batchSizes) {
+      auto start = std::chrono::steady_clock::now();
+      int nbDetections = 0;
+      for (int replay = 0; replay < nbReplays; replay++) {
+        MotionController controller;
+        for (size_t i = 0; i < trace.size(); i += batchSize) {
+          auto nbSamples = static_cast<uint8_t>(std::min<size_t>(batchSize, trace.size() - i));
+          controller.Update(&trace[i], nbSamples, 0);
+          nbDetections += controller.Should_RaiseWake(true);
+          nbDetections += controller.Should_ShakeWake(shakeThreshold);
+        }
+      }
+      std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+      std::printf("Batches of %2u samples : %.1f ns per sample, %.1f wake-ups of SystemTask per second at %uHz (%d detections)\n",
+                  batchSize,
+                  elapsed.count() / (nbReplays * trace.size()),
+                  static_cast<double>(Pinetime::Drivers::Bma421::sampleRate) / batchSize,
+                  Pinetime::Drivers::Bma421::sampleRate,
+                  nbDetections / nbReplays);
+    }
+  }
+}
+
+int main() {
+  TestGestures();
+  TestService();
+  Benchmark();
+  std::printf("MotionReplayTest passed\n");
+  return 0;
+}
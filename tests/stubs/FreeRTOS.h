@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+
+// Host replacement of the parts of FreeRTOS used by the tested components. Nothing is scheduled: delays return
+// immediately and timers never expire by themselves.
+
+#define configTICK_RATE_HZ 1024
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdPASS 1
+#define portMAX_DELAY 0xffffffffUL
+#define pdMS_TO_TICKS(xTimeInMs) ((TickType_t) (((uint64_t) (xTimeInMs) * configTICK_RATE_HZ) / 1000))
+
+// Defined by nrf_assert.h in the firmware (included by FreeRTOSConfig.h)
+#define ASSERT(expression)                                                                                                                 \
+  do {                                                                                                                                     \
+    if (!(expression)) {                                                                                                                   \
+      abort();                                                                                                                             \
+    }                                                                                                                                      \
+  } while (0)
+
+using TickType_t = uint32_t;
+using BaseType_t = long;
+using UBaseType_t = unsigned long;
+
+namespace Stubs {
+  inline TickType_t& TickCount() {
+    static TickType_t tickCount = 0;
+    return tickCount;
+  }
+}
@@ -0,0 +1,132 @@
+#include "NimbleStubs.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Stubs {
+  std::vector<Characteristic>& Characteristics() {
+    static std::vector<Characteristic> characteristics;
+    return characteristics;
+  }
+
+  std::vector<Notification>& Notifications() {
+    static std::vector<Notification> notifications;
+    return notifications;
+  }
+
+  size_t PacketLength(const os_mbuf* om) {
+    size_t length = 0;
+    for (; om != nullptr; om = SLIST_NEXT(om, om_next)) {
+      length += om->om_len;
+    }
+    return length;
+  }
+
+  os_mbuf* MakeMbufChain(const uint8_t* data, size_t size, size_t segmentSize) {
+    os_mbuf* head = nullptr;
+    os_mbuf** next = &head;
+    do {
+      auto* om = new os_mbuf {};
+      om->om_data = om->om_databuf;
+      om->om_len = static_cast<uint16_t>(std::min({size, segmentSize, sizeof(om->om_databuf)}));
+      std::memcpy(om->om_data, data, om->om_len);
+      data += om->om_len;
+      size -= om->om_len;
+      *next = om;
+      next = &SLIST_NEXT(om, om_next);
+    } while (size > 0);
+    return head;
+  }
+
+  void FreeMbufChain(os_mbuf* om) {
+    while (om != nullptr) {
+      os_mbuf* next = SLIST_NEXT(om, om_next);
+      delete om;
+      om = next;
+    }
+  }
+
+  std::vector<uint8_t> MbufData(const os_mbuf* om) {
+    std::vector<uint8_t> data;
+    for (; om != nullptr; om = SLIST_NEXT(om, om_next)) {
+      data.insert(data.end(), om->om_data, om->om_data + om->om_len);
+    }
+    return data;
+  }
+
+  int Access(uint16_t handle, uint8_t op, os_mbuf* om) {
+    for (const auto& characteristic : Characteristics()) {
+      if (characteristic.handle == handle) {
+        ble_gatt_access_ctxt context {op, om};
+        return characteristic.definition->access_cb(0, handle, &context, characteristic.definition->arg);
+      }
+    }
+    return BLE_ATT_ERR_INVALID_HANDLE;
+  }
+}
+
+int ble_gatts_count_cfg(const struct ble_gatt_svc_def* services) {
+  return 0;
+}
+
+int ble_gatts_add_svcs(const struct ble_gatt_svc_def* services) {
+  for (; services->type != BLE_GATT_SVC_TYPE_END; services++) {
+    for (auto* characteristic = services->characteristics; characteristic->uuid != nullptr; characteristic++) {
+      auto handle = static_cast<uint16_t>(Stubs::Characteristics().size() + 1);
+      Stubs::Characteristics().push_back({services->uuid, characteristic, handle});
+      if (characteristic->val_handle != nullptr) {
+        *characteristic->val_handle = handle;
+      }
+    }
+  }
+  return 0;
+}
+
+int ble_gatts_find_chr(const ble_uuid_t* service, const ble_uuid_t* characteristic, uint16_t* definitionHandle, uint16_t* valueHandle) {
+  for (const auto& registered : Stubs::Characteristics()) {
+    if (ble_uuid_cmp(registered.service, service) == 0 && ble_uuid_cmp(registered.definition->uuid, characteristic) == 0) {
+      if (valueHandle != nullptr) {
+        *valueHandle = registered.handle;
+      }
+      return 0;
+    }
+  }
+  return 1;
+}
+
+int os_mbuf_append(struct os_mbuf* om, const void* data, uint16_t length) {
+  while (SLIST_NEXT(om, om_next) != nullptr) {
+    om = SLIST_NEXT(om, om_next);
+  }
+  if (om->om_data + om->om_len + length > om->om_databuf + sizeof(om->om_databuf)) {
+    return 1;
+  }
+  std::memcpy(om->om_data + om->om_len, data, length);
+  om->om_len += length;
+  return 0;
+}
+
+int os_mbuf_copydata(const struct os_mbuf* om, int offset, int length, void* destination) {
+  auto* output = static_cast<uint8_t*>(destination);
+  for (; om != nullptr && length > 0; om = SLIST_NEXT(om, om_next)) {
+    if (offset >= om->om_len) {
+      offset -= om->om_len;
+      continue;
+    }
+    int copySize = std::min(length, om->om_len - offset);
+    std::memcpy(output, om->om_data + offset, copySize);
+    output += copySize;
+    length -= copySize;
+    offset = 0;
+  }
+  return (length > 0) ? -1 : 0;
+}
+
+struct os_mbuf* ble_hs_mbuf_from_flat(const void* data, uint16_t length) {
+  return Stubs::MakeMbufChain(static_cast<const uint8_t*>(data), length, length);
+}
+
+int ble_gattc_notify_custom(uint16_t connectionHandle, uint16_t characteristicHandle, struct os_mbuf* om) {
+  Stubs::Notifications().push_back({connectionHandle, characteristicHandle, Stubs::MbufData(om)});
+  Stubs::FreeMbufChain(om);
+  return 0;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "host/ble_gap.h"
+
+// Helpers of the tests that go through the NimBLE stubs. The services are registered in a table so that the tests
+// can find the handles of the characteristics, the notifications are recorded.
+namespace Stubs {
+  struct Characteristic {
+    const ble_uuid_t* service;
+    const ble_gatt_chr_def* definition;
+    uint16_t handle;
+  };
+
+  struct Notification {
+    uint16_t connectionHandle;
+    uint16_t characteristicHandle;
+    std::vector<uint8_t> data;
+  };
+
+  std::vector<Characteristic>& Characteristics();
+  std::vector<Notification>& Notifications();
+
+  // Splits the data in a chain of mbufs, like a long ATT write received by the NimBLE host
+  os_mbuf* MakeMbufChain(const uint8_t* data, size_t size, size_t segmentSize);
+  void FreeMbufChain(os_mbuf* om);
+  std::vector<uint8_t> MbufData(const os_mbuf* om);
+
+  // Calls the access callback of the characteristic, as the host does when the peer reads or writes it
+  int Access(uint16_t handle, uint8_t op, os_mbuf* om);
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Controllers {
+    // The clock of the watch, set by the tests (UTC, no settings)
+    class DateTime {
+    public:
+      std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> CurrentDateTime() const {
+        return currentDateTime;
+      }
+
+      void SetCurrentTime(std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> t) {
+        currentDateTime = t;
+      }
+
+      uint8_t Hours() const {
+        return SecondsOfDay() / 3600;
+      }
+
+      uint8_t Minutes() const {
+        return SecondsOfDay() / 60 % 60;
+      }
+
+      uint8_t Seconds() const {
+        return SecondsOfDay() % 60;
+      }
+
+    private:
+      std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> currentDateTime;
+
+      uint32_t SecondsOfDay() const {
+        return std::chrono::duration_cast<std::chrono::seconds>(currentDateTime.time_since_epoch()).count() % 86400;
+      }
+    };
+  }
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace Pinetime {
+  namespace Drivers {
+    // RAM model of the external NOR flash : a program can only clear bits, an erase sets whole sectors to 0xFF.
+    class SpiNorFlash {
+    public:
+      static constexpr size_t size = 4 * 1024 * 1024;
+      static constexpr size_t sectorSize = 0x1000;
+      static constexpr size_t pageSize = 256;
+
+      SpiNorFlash() : memory(size, 0xff) {
+      }
+
+      void Read(uint32_t address, uint8_t* buffer, size_t length) {
+        std::memcpy(buffer, memory.data() + address, length);
+        nbReads++;
+      }
+
+      void Write(uint32_t address, const uint8_t* buffer, size_t length) {
+        nbPrograms++;
+        if (failProgramAddress >= address && failProgramAddress < address + length) {
+          programFailed = true;
+          failProgramAddress = 0xffffffff;
+          return;
+        }
+        // Like the real memory, a program wraps around at the end of the page
+        for (size_t i = 0; i < length; i++) {
+          uint32_t pageStart = address & ~(pageSize - 1u);
+          uint32_t target = pageStart + ((address + i) % pageSize);
+          memory[target] &= buffer[i];
+        }
+      }
+
+      void Erase(uint32_t address, size_t length) {
+        uint32_t end = address + length;
+        for (address &= ~(sectorSize - 1u); address < end; address += sectorSize) {
+          std::memset(memory.data() + address, 0xff, sectorSize);
+        }
+      }
+
+      void SectorErase(uint32_t sectorAddress) {
+        Erase(sectorAddress, sectorSize);
+      }
+
+      // The erases complete immediately, the sizes are the ones chosen by the real driver
+      size_t StartErase(uint32_t address, size_t length) {
+        for (size_t blockSize : {0x10000u, 0x8000u}) {
+          if ((address % blockSize) == 0 && length >= blockSize) {
+            Erase(address, blockSize);
+            return blockSize;
+          }
+        }
+        SectorErase(address);
+        return sectorSize;
+      }
+
+      bool IsErasing() {
+        return false;
+      }
+
+      void WaitForCompletion() {
+      }
+
+      bool ProgramFailed() {
+        bool failed = programFailed;
+        programFailed = false;
+        return failed;
+      }
+
+      bool EraseFailed() {
+        return false;
+      }
+
+      std::vector<uint8_t> memory;
+      uint32_t nbReads = 0;
+      uint32_t nbPrograms = 0;
+      // The next program that includes this address fails and leaves the memory unchanged
+      uint32_t failProgramAddress = 0xffffffff;
+      bool programFailed = false;
+    };
+  }
+}
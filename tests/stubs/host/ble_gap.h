@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "host/ble_uuid.h"
+// Included by the FreeRTOS port of NimBLE in the firmware
+#include "FreeRTOS.h"
+#include "timers.h"
+
+// Host replacement of the parts of the NimBLE host used by the tested services, implemented in NimbleStubs.cpp.
+// The services include this header between '#define min' and '#undef min' : no standard header can be included here.
+
+#define BLE_ATT_ERR_INVALID_HANDLE 0x01
+#define BLE_ATT_ERR_READ_NOT_PERMITTED 0x02
+#define BLE_ATT_ERR_WRITE_NOT_PERMITTED 0x03
+#define BLE_ATT_ERR_INVALID_PDU 0x04
+#define BLE_ATT_ERR_INVALID_OFFSET 0x07
+#define BLE_ATT_ERR_REQ_NOT_SUPPORTED 0x06
+#define BLE_ATT_ERR_INVALID_ATTR_VALUE_LEN 0x0d
+#define BLE_ATT_ERR_UNLIKELY 0x0e
+#define BLE_ATT_ERR_INSUFFICIENT_RES 0x11
+
+#define BLE_GATT_ACCESS_OP_READ_CHR 0
+#define BLE_GATT_ACCESS_OP_WRITE_CHR 1
+#define BLE_GATT_ACCESS_OP_READ_DSC 2
+#define BLE_GATT_ACCESS_OP_WRITE_DSC 3
+
+#define BLE_GATT_CHR_F_READ 0x0002
+#define BLE_GATT_CHR_F_WRITE_NO_RSP 0x0004
+#define BLE_GATT_CHR_F_WRITE 0x0008
+#define BLE_GATT_CHR_F_NOTIFY 0x0010
+#define BLE_GATT_CHR_F_INDICATE 0x0020
+
+#define BLE_GATT_SVC_TYPE_END 0
+#define BLE_GATT_SVC_TYPE_PRIMARY 1
+
+#define SLIST_ENTRY(type)                                                                                                                  \
+  struct {                                                                                                                                 \
+    struct type* sle_next;                                                                                                                 \
+  }
+#define SLIST_NEXT(elm, field) ((elm)->field.sle_next)
+
+struct os_mbuf {
+  uint8_t* om_data;
+  uint16_t om_len;
+  SLIST_ENTRY(os_mbuf) om_next;
+  uint8_t om_databuf[512];
+};
+
+
+struct ble_gatt_access_ctxt {
+  uint8_t op;
+  struct os_mbuf* om;
+};
+
+typedef int ble_gatt_access_fn(uint16_t conn_handle, uint16_t attr_handle, struct ble_gatt_access_ctxt* ctxt, void* arg);
+typedef uint16_t ble_gatt_chr_flags;
+
+struct ble_gatt_chr_def {
+  const ble_uuid_t* uuid;
+  ble_gatt_access_fn* access_cb;
+  void* arg;
+  struct ble_gatt_dsc_def* descriptors;
+  ble_gatt_chr_flags flags;
+  uint8_t min_key_size;
+  uint16_t* val_handle;
+};
+
+struct ble_gatt_svc_def {
+  uint8_t type;
+  const ble_uuid_t* uuid;
+  const struct ble_gatt_svc_def** includes;
+  const struct ble_gatt_chr_def* characteristics;
+};
+
+#define OS_MBUF_PKTLEN(om) Stubs::PacketLength(om)
+
+namespace Stubs {
+  size_t PacketLength(const os_mbuf* om);
+}
+
+int ble_gatts_count_cfg(const struct ble_gatt_svc_def* services);
+int ble_gatts_add_svcs(const struct ble_gatt_svc_def* services);
+int ble_gatts_find_chr(const ble_uuid_t* service, const ble_uuid_t* characteristic, uint16_t* definitionHandle, uint16_t* valueHandle);
+int os_mbuf_append(struct os_mbuf* om, const void* data, uint16_t length);
+int os_mbuf_copydata(const struct os_mbuf* om, int offset, int length, void* destination);
+struct os_mbuf* ble_hs_mbuf_from_flat(const void* data, uint16_t length);
+int ble_gattc_notify_custom(uint16_t connectionHandle, uint16_t characteristicHandle, struct os_mbuf* om);
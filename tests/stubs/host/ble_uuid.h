@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+// Host replacement of the NimBLE UUID types
+#define BLE_UUID_TYPE_16 16
+#define BLE_UUID_TYPE_32 32
+#define BLE_UUID_TYPE_128 128
+
+typedef struct {
+  uint8_t type;
+} ble_uuid_t;
+
+typedef struct {
+  ble_uuid_t u;
+  uint16_t value;
+} ble_uuid16_t;
+
+typedef struct {
+  ble_uuid_t u;
+  uint8_t value[16];
+} ble_uuid128_t;
+
+inline int ble_uuid_cmp(const ble_uuid_t* uuid1, const ble_uuid_t* uuid2) {
+  if (uuid1->type != uuid2->type) {
+    return uuid1->type - uuid2->type;
+  }
+  if (uuid1->type == BLE_UUID_TYPE_16) {
+    return reinterpret_cast<const ble_uuid16_t*>(uuid1)->value - reinterpret_cast<const ble_uuid16_t*>(uuid2)->value;
+  }
+  return std::memcmp(reinterpret_cast<const ble_uuid128_t*>(uuid1)->value, reinterpret_cast<const ble_uuid128_t*>(uuid2)->value, 16);
+}
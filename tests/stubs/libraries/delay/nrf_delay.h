@@ -0,0 +1,14 @@
+#pragma once
+#include <cstdint>
+
+namespace Stubs {
+  // Time spent in busy waits, the tick count of FreeRTOS only advances when a task blocks
+  inline uint64_t& Microseconds() {
+    static uint64_t microseconds = 0;
+    return microseconds;
+  }
+}
+
+inline void nrf_delay_us(uint32_t microseconds) {
+  Stubs::Microseconds() += microseconds;
+}
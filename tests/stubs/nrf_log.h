@@ -0,0 +1,20 @@
+#pragma once
+
+namespace Stubs {
+  template <class... Args> void Unused(const Args&...) {
+  }
+}
+
+// Statements like the macros of the SDK, which can be used without a semicolon
+#define NRF_LOG_INFO(...)                                                                                                                  \
+  {                                                                                                                                        \
+    Stubs::Unused(__VA_ARGS__);                                                                                                            \
+  }
+#define NRF_LOG_WARNING(...)                                                                                                               \
+  {                                                                                                                                        \
+    Stubs::Unused(__VA_ARGS__);                                                                                                            \
+  }
+#define NRF_LOG_ERROR(...)                                                                                                                 \
+  {                                                                                                                                        \
+    Stubs::Unused(__VA_ARGS__);                                                                                                            \
+  }
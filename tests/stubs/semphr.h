@@ -0,0 +1,50 @@
+#pragma once
+#include "FreeRTOS.h"
+
+// Nothing runs concurrently on the host : a semaphore only counts how many times it is taken,
+// to check that it is always released.
+struct QueueDefinition {
+  unsigned count;
+};
+using SemaphoreHandle_t = QueueDefinition*;
+
+namespace Stubs {
+  inline SemaphoreHandle_t CreateSemaphore() {
+    static QueueDefinition semaphores[16];
+    static unsigned nbSemaphores = 0;
+    ASSERT(nbSemaphores < sizeof(semaphores) / sizeof(semaphores[0]));
+    semaphores[nbSemaphores] = {0};
+    return &semaphores[nbSemaphores++];
+  }
+}
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() {
+  return Stubs::CreateSemaphore();
+}
+
+inline SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() {
+  return Stubs::CreateSemaphore();
+}
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticksToWait) {
+  ASSERT(semaphore->count == 0);
+  semaphore->count++;
+  return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+  ASSERT(semaphore->count == 1);
+  semaphore->count--;
+  return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t semaphore, TickType_t ticksToWait) {
+  semaphore->count++;
+  return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t semaphore) {
+  ASSERT(semaphore->count > 0);
+  semaphore->count--;
+  return pdTRUE;
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "systemtask/Messages.h"
+
+namespace Pinetime {
+  namespace System {
+    // Records the messages pushed by the tested components
+    class SystemTask {
+    public:
+      void PushMessage(Messages message) {
+        messages.push_back(message);
+      }
+
+      bool IsSleeping() const {
+        return false;
+      }
+
+      std::vector<Messages> messages;
+    };
+  }
+}
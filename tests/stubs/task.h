@@ -0,0 +1,11 @@
+#pragma once
+#include "FreeRTOS.h"
+
+inline TickType_t xTaskGetTickCount() {
+  return Stubs::TickCount();
+}
+
+// The time advances only when a task waits
+inline void vTaskDelay(TickType_t ticks) {
+  Stubs::TickCount() += ticks;
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <cstring>
+#include "FreeRTOS.h"
+
+struct tmrTimerControl;
+using TimerHandle_t = tmrTimerControl*;
+using TimerCallbackFunction_t = void (*)(TimerHandle_t);
+
+struct tmrTimerControl {
+  const char* name;
+  void* id;
+  TimerCallbackFunction_t callback;
+  TickType_t period;
+  bool active;
+};
+
+namespace Stubs {
+  // The timers are never deleted, like in the firmware
+  struct Timers {
+    tmrTimerControl timers[64];
+    unsigned nbTimers = 0;
+  };
+
+  inline Timers& AllTimers() {
+    static Timers timers;
+    return timers;
+  }
+
+  inline TimerHandle_t CreateTimer(const tmrTimerControl& timer) {
+    auto& all = AllTimers();
+    ASSERT(all.nbTimers < sizeof(all.timers) / sizeof(all.timers[0]));
+    all.timers[all.nbTimers] = timer;
+    return &all.timers[all.nbTimers++];
+  }
+
+  // Returns the last timer created with this name
+  inline TimerHandle_t FindTimer(const char* name) {
+    auto& all = AllTimers();
+    for (unsigned i = all.nbTimers; i > 0; i--) {
+      if (std::strcmp(all.timers[i - 1].name, name) == 0) {
+        return &all.timers[i - 1];
+      }
+    }
+    return nullptr;
+  }
+}
+
+inline TimerHandle_t
+xTimerCreate(const char* name, TickType_t period, UBaseType_t autoReload, void* id, TimerCallbackFunction_t callback) {
+  return Stubs::CreateTimer({name, id, callback, period, false});
+}
+
+inline void* pvTimerGetTimerID(TimerHandle_t timer) {
+  return timer->id;
+}
+
+inline BaseType_t xTimerStart(TimerHandle_t timer, TickType_t ticksToWait) {
+  timer->active = true;
+  return pdPASS;
+}
+
+inline BaseType_t xTimerReset(TimerHandle_t timer, TickType_t ticksToWait) {
+  timer->active = true;
+  return pdPASS;
+}
+
+inline BaseType_t xTimerStop(TimerHandle_t timer, TickType_t ticksToWait) {
+  timer->active = false;
+  return pdPASS;
+}
+
+inline BaseType_t xTimerChangePeriod(TimerHandle_t timer, TickType_t period, TickType_t ticksToWait) {
+  timer->period = period;
+  timer->active = true;
+  return pdPASS;
+}
+
+inline BaseType_t xTimerIsTimerActive(TimerHandle_t timer) {
+  return timer->active ? pdTRUE : pdFALSE;
+}
+
+namespace Stubs {
+  // Runs the callback of an active timer, as the timer task would when it expires
+  inline void ExpireTimer(TimerHandle_t timer) {
+    if (timer->active) {
+      timer->active = false;
+      timer->callback(timer);
+    }
+  }
+}
@@ -0,0 +1,72 @@
+// One writer thread and several reader threads: a successful read must never return a value that is partially written.
+#include "utility/SeqLock.h"
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "Check.h"
+
+using Pinetime::Utility::SeqLock;
+
+namespace {
+  struct Value {
+    uint32_t words[50];
+  };
+
+  constexpr uint32_t nbWrites = 2000000;
+  constexpr uint8_t nbReaders = 3;
+}
+
+int main() {
+  SeqLock<Value> lock;
+  std::atomic<bool> stop {false};
+  std::atomic<uint32_t> nbSuccessfulReads {0};
+  std::atomic<uint32_t> nbFailedReads {0};
+
+  std::vector<std::thread> readers;
+  for (uint8_t i = 0; i < nbReaders; i++) {
+    readers.emplace_back([&] {
+      Value value {};
+      uint32_t previous = 0;
+      while (!stop.load()) {
+        uint32_t version = lock.Version();
+        if (!lock.Read(value)) {
+          nbFailedReads++;
+          continue;
+        }
+        for (auto word : value.words) {
+          CHECK(word == value.words[0]);
+        }
+        // A reader never goes back in time
+        CHECK(value.words[0] >= previous);
+        CHECK(value.words[0] >= version / 2);
+        previous = value.words[0];
+        nbSuccessfulReads++;
+      }
+    });
+  }
+
+  std::thread writer([&] {
+    for (uint32_t i = 1; i <= nbWrites; i++) {
+      lock.Write([i](Value& value) {
+        for (auto& word : value.words) {
+          word = i;
+        }
+      });
+    }
+    stop.store(true);
+  });
+
+  writer.join();
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  Value value {};
+  CHECK(lock.Read(value));
+  CHECK(value.words[0] == nbWrites);
+  CHECK(lock.Version() == 2 * nbWrites);
+  CHECK(nbSuccessfulReads.load() > 0);
+  std::printf("%u successful reads, %u failed reads\n", nbSuccessfulReads.load(), nbFailedReads.load());
+  return 0;
+}
@@ -0,0 +1,259 @@
+// Writes CBOR events to the weather service through chains of mbufs, fuzzes the decoder with corrupted writes
+// and prints the decoding throughput on the host.
+#include "components/ble/weather/WeatherService.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "Check.h"
+#include "NimbleStubs.h"
+#include "systemtask/SystemTask.h"
+
+using namespace Pinetime::Controllers;
+
+namespace {
+  constexpr uint64_t now = 1700000000;
+  // Segment sizes of the writes : in place (a single mbuf), MTU of 247 bytes, MTU of 23 bytes
+  constexpr size_t segmentSizes[] = {512, 244, 20};
+
+  class Encoder {
+  public:
+    Encoder() {
+      QCBOREncode_Init(&context, UsefulBuf_FROM_BYTE_ARRAY(buffer));
+    }
+
+    void OpenArray() {
+      QCBOREncode_OpenArray(&context);
+    }
+
+    void CloseArray() {
+      QCBOREncode_CloseArray(&context);
+    }
+
+    void OpenEvent(WeatherData::eventtype type, uint64_t timestamp, uint32_t expires) {
+      QCBOREncode_OpenMap(&context);
+      QCBOREncode_AddInt64ToMap(&context, "Timestamp", static_cast<int64_t>(timestamp));
+      QCBOREncode_AddInt64ToMap(&context, "Expires", expires);
+      QCBOREncode_AddInt64ToMap(&context, "EventType", static_cast<int64_t>(type));
+    }
+
+    void Add(const char* label, int64_t value) {
+      QCBOREncode_AddInt64ToMap(&context, label, value);
+    }
+
+    void Add(const char* label, const char* value) {
+      QCBOREncode_AddTextToMap(&context, label, UsefulBuf_FromSZ(value));
+    }
+
+    void CloseEvent() {
+      QCBOREncode_CloseMap(&context);
+    }
+
+    std::vector<uint8_t> Finish() {
+      UsefulBufC encoded;
+      CHECK(QCBOREncode_Finish(&context, &encoded) == QCBOR_SUCCESS);
+      const auto* data = static_cast<const uint8_t*>(encoded.ptr);
+      return {data, data + encoded.len};
+    }
+
+  private:
+    uint8_t buffer[1024];
+    QCBOREncodeContext context;
+  };
+
+  void AddTemperature(Encoder& encoder, uint64_t timestamp, int16_t temperature) {
+    encoder.OpenEvent(WeatherData::eventtype::Temperature, timestamp, 3600);
+    encoder.Add("Temperature", temperature);
+    encoder.Add("DewPoint", temperature - 500);
+    encoder.CloseEvent();
+  }
+
+  class Harness {
+  public:
+    Harness() : service {system, dateTime} {
+      dateTime.SetCurrentTime(std::chrono::system_clock::time_point {std::chrono::seconds {now}});
+    }
+
+    int Write(const std::vector<uint8_t>& payload, size_t segmentSize) {
+      os_mbuf* om = Stubs::MakeMbufChain(payload.data(), payload.size(), segmentSize);
+      ble_gatt_access_ctxt context {};
+      context.op = BLE_GATT_ACCESS_OP_WRITE_CHR;
+      context.om = om;
+      int result = service.OnCommand(0, 0, &context);
+      Stubs::FreeMbufChain(om);
+      return result;
+    }
+
+    Pinetime::System::SystemTask system;
+    DateTime dateTime;
+    WeatherService service;
+  };
+
+  void TestEvents() {
+    for (size_t segmentSize : segmentSizes) {
+      Harness harness;
+
+      Encoder single;
+      AddTemperature(single, now - 10, -1250);
+      CHECK(harness.Write(single.Finish(), segmentSize) == 0);
+      CHECK(harness.service.GetCurrentTemperature().temperature == -1250);
+      CHECK(harness.service.GetCurrentTemperature().dewPoint == -1750);
+
+      // A batch of events of several types, longer than an mbuf of a 23 bytes MTU
+      Encoder batch;
+      batch.OpenArray();
+      AddTemperature(batch, now - 5, 2150);
+      batch.OpenEvent(WeatherData::eventtype::Wind, now - 5, 3600);
+      batch.Add("SpeedMin", 3);
+      batch.Add("SpeedMax", 12);
+      batch.Add("DirectionMin", 10);
+      batch.Add("DirectionMax", 40);
+      batch.CloseEvent();
+      batch.OpenEvent(WeatherData::eventtype::Location, now - 5, 86400);
+      batch.Add("Location", "Somewhere in the middle of a long street name");
+      batch.Add("Altitude", 412);
+      batch.Add("Latitude", 50850000);
+      batch.Add("Longitude", -4350000);
+      batch.CloseEvent();
+      batch.OpenEvent(WeatherData::eventtype::Humidity, now - 5, 3600);
+      batch.Add("Humidity", 64);
+      batch.CloseEvent();
+      batch.CloseArray();
+      auto payload = batch.Finish();
+      CHECK(payload.size() > 100);
+      CHECK(harness.Write(payload, segmentSize) == 0);
+
+      CHECK(harness.service.GetCurrentTemperature().temperature == 2150);
+      CHECK(harness.service.GetCurrentWind().speedMin == 3);
+      CHECK(harness.service.GetCurrentWind().speedMax == 12);
+      CHECK(harness.service.GetCurrentWind().directionMin == 10);
+      CHECK(harness.service.GetCurrentWind().directionMax == 40);
+      // Truncated to maxLocationLength
+      CHECK(std::strcmp(harness.service.GetCurrentLocation().location, "Somewhere in the middle of a lon") == 0);
+      CHECK(harness.service.GetCurrentLocation().altitude == 412);
+      CHECK(harness.service.GetCurrentLocation().latitude == 50850000);
+      CHECK(harness.service.GetCurrentLocation().longitude == -4350000);
+      CHECK(harness.service.GetCurrentHumidity().humidity == 64);
+      CHECK(harness.service.HasTimelineEventOfType(WeatherData::eventtype::Humidity));
+      CHECK(!harness.service.HasTimelineEventOfType(WeatherData::eventtype::Pressure));
+      CHECK(harness.service.GetTimelineLength() == 5);
+
+      // Rejected writes
+      Encoder outOfRange;
+      outOfRange.OpenEvent(WeatherData::eventtype::Humidity, now, 3600);
+      outOfRange.Add("Humidity", 1000);
+      outOfRange.CloseEvent();
+      CHECK(harness.Write(outOfRange.Finish(), segmentSize) == BLE_ATT_ERR_INVALID_ATTR_VALUE_LEN);
+
+      Encoder unknownType;
+      unknownType.OpenEvent(static_cast<WeatherData::eventtype>(200), now, 3600);
+      unknownType.CloseEvent();
+      CHECK(harness.Write(unknownType.Finish(), segmentSize) == BLE_ATT_ERR_INVALID_ATTR_VALUE_LEN);
+
+      CHECK(harness.Write(std::vector<uint8_t>(513, 0xa0), segmentSize) == BLE_ATT_ERR_INVALID_ATTR_VALUE_LEN);
+      CHECK(harness.service.GetTimelineLength() == 5);
+    }
+  }
+
+  // Corrupts valid writes : the result must not depend on how the write is split in mbufs,
+  // and the decoder must stay in the bounds of the write (checked by the sanitizers)
+  void Fuzz() {
+    std::mt19937 random(7);
+    Encoder encoder;
+    encoder.OpenArray();
+    for (int i = 0; i < 6; i++) {
+      AddTemperature(encoder, now - 100 + i * 10, static_cast<int16_t>(i * 100));
+    }
+    encoder.OpenEvent(WeatherData::eventtype::Location, now, 86400);
+    encoder.Add("Location", "Fuzzy town");
+    encoder.Add("Altitude", 10);
+    encoder.Add("Latitude", 1);
+    encoder.Add("Longitude", 2);
+    encoder.CloseEvent();
+    encoder.CloseArray();
+    const auto valid = encoder.Finish();
+
+    Harness harnesses[sizeof(segmentSizes) / sizeof(segmentSizes[0])];
+    int nbAccepted = 0;
+    for (int i = 0; i < 100000; i++) {
+      auto payload = valid;
+      switch (random() % 4) {
+        case 0:
+          payload.resize(1 + random() % payload.size());
+          break;
+        case 1:
+          for (int n = 1 + random() % 4; n > 0; n--) {
+            payload[random() % payload.size()] ^= 1 << (random() % 8);
+          }
+          break;
+        case 2:
+          payload[random() % payload.size()] = static_cast<uint8_t>(random());
+          break;
+        default:
+          payload.resize(1 + random() % 512);
+          for (auto& byte : payload) {
+            byte = static_cast<uint8_t>(random());
+          }
+          break;
+      }
+
+      int result = harnesses[0].Write(payload, segmentSizes[0]);
+      CHECK(result == 0 || result == BLE_ATT_ERR_INVALID_ATTR_VALUE_LEN || result == BLE_ATT_ERR_INSUFFICIENT_RES);
+      for (size_t h = 1; h < sizeof(segmentSizes) / sizeof(segmentSizes[0]); h++) {
+        CHECK(harnesses[h].Write(payload, segmentSizes[h]) == result);
+        CHECK(harnesses[h].service.GetTimelineLength() == harnesses[0].service.GetTimelineLength());
+      }
+      nbAccepted += (result == 0);
+    }
+    std::printf("Fuzzing : %d of 100000 corrupted writes accepted\n", nbAccepted);
+  }
+
+  void Benchmark() {
+    // The largest batch of temperatures that fits in a write
+    std::vector<uint8_t> payload;
+    int nbEvents = 0;
+    for (int n = 1;; n++) {
+      Encoder encoder;
+      encoder.OpenArray();
+      for (int i = 0; i < n; i++) {
+        AddTemperature(encoder, now + i * 3600, static_cast<int16_t>(i));
+      }
+      encoder.CloseArray();
+      auto candidate = encoder.Finish();
+      if (candidate.size() > 512) {
+        break;
+      }
+      payload = candidate;
+      nbEvents = n;
+    }
+
+    constexpr int nbWrites = 20000;
+    for (size_t segmentSize : segmentSizes) {
+      Harness harness;
+      ble_gatt_access_ctxt context {};
+      context.op = BLE_GATT_ACCESS_OP_WRITE_CHR;
+      context.om = Stubs::MakeMbufChain(payload.data(), payload.size(), segmentSize);
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < nbWrites; i++) {
+        CHECK(harness.service.OnCommand(0, 0, &context) == 0);
+      }
+      std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+      Stubs::FreeMbufChain(context.om);
+      std::printf("Writes of %d events (%zu bytes) in mbufs of %zu bytes : %.2f us per write, %.0f events/s\n",
+                  nbEvents,
+                  payload.size(),
+                  segmentSize,
+                  elapsed.count() / nbWrites,
+                  nbEvents * nbWrites / elapsed.count() * 1e6);
+    }
+  }
+}
+
+int main() {
+  TestEvents();
+  Fuzz();
+  Benchmark();
+  std::printf("WeatherServiceTest passed\n");
+  return 0;
+}
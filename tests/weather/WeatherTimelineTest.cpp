@@ -0,0 +1,190 @@
+// Checks the fixed capacity weather timeline against a simple model and prints the cost of its operations on the host.
+#include "components/ble/weather/WeatherData.h"
+#include "components/ble/weather/WeatherTimeline.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "Check.h"
+
+using namespace Pinetime::Controllers;
+
+namespace {
+  constexpr uint8_t capacity = 16;
+  using Timeline = WeatherTimeline<WeatherData::Temperature, capacity>;
+
+  WeatherData::Temperature MakeEvent(uint64_t timestamp, uint32_t expires, int16_t temperature) {
+    WeatherData::Temperature event {};
+    event.timestamp = timestamp;
+    event.expires = expires;
+    event.eventType = WeatherData::eventtype::Temperature;
+    event.temperature = temperature;
+    return event;
+  }
+
+  bool IsValid(const WeatherData::Temperature& event, uint64_t currentTimestamp) {
+    return event.timestamp + event.expires >= currentTimestamp;
+  }
+
+  // The rules of the timeline, written with a vector sorted by timestamp (newest first)
+  class Model {
+  public:
+    bool Insert(const WeatherData::Temperature& event, uint64_t currentTimestamp) {
+      auto sameTimestamp = std::find_if(events.begin(), events.end(), [&event](const WeatherData::Temperature& e) {
+        return e.timestamp == event.timestamp;
+      });
+      if (sameTimestamp != events.end()) {
+        *sameTimestamp = event;
+        return true;
+      }
+      if (events.size() == capacity) {
+        events.erase(std::remove_if(events.begin(),
+                                    events.end(),
+                                    [currentTimestamp](const WeatherData::Temperature& e) {
+                                      return !IsValid(e, currentTimestamp);
+                                    }),
+                     events.end());
+      }
+      if (events.size() == capacity) {
+        if (event.timestamp < events.back().timestamp) {
+          return false;
+        }
+        events.pop_back();
+      }
+      auto position = std::find_if(events.begin(), events.end(), [&event](const WeatherData::Temperature& e) {
+        return e.timestamp < event.timestamp;
+      });
+      events.insert(position, event);
+      return true;
+    }
+
+    const WeatherData::Temperature* Current(uint64_t currentTimestamp) const {
+      for (const auto& event : events) {
+        if (event.timestamp <= currentTimestamp) {
+          return IsValid(event, currentTimestamp) ? &event : nullptr;
+        }
+      }
+      return nullptr;
+    }
+
+    std::vector<WeatherData::Temperature> events;
+  };
+
+  void TestBasics() {
+    WeatherTimeline<WeatherData::Temperature, 4> timeline;
+    CHECK(timeline.Current(0) == nullptr);
+    CHECK(!timeline.HasValidEvent(0));
+
+    CHECK(timeline.Insert(MakeEvent(100, 50, 1), 120));
+    CHECK(timeline.Insert(MakeEvent(200, 50, 2), 120));
+    CHECK(timeline.Current(120)->temperature == 1);
+    CHECK(timeline.Current(210)->temperature == 2);
+    CHECK(timeline.Current(90) == nullptr);
+    CHECK(timeline.Current(260) == nullptr);
+
+    // Same timestamp : replaced
+    CHECK(timeline.Insert(MakeEvent(100, 50, 3), 120));
+    CHECK(timeline.Size() == 2);
+    CHECK(timeline.Current(120)->temperature == 3);
+
+    CHECK(timeline.Insert(MakeEvent(300, 50, 4), 120));
+    CHECK(timeline.Insert(MakeEvent(400, 50, 5), 120));
+    CHECK(timeline.Size() == 4);
+
+    // Full : the expired event is removed first
+    CHECK(timeline.Insert(MakeEvent(500, 50, 6), 200));
+    CHECK(timeline.Size() == 4);
+    CHECK(timeline.Current(200)->temperature == 2);
+
+    // Full of newer events
+    CHECK(!timeline.Insert(MakeEvent(50, 50, 7), 0));
+
+    // Full of valid events : the oldest one is dropped
+    CHECK(timeline.Insert(MakeEvent(600, 50, 8), 0));
+    CHECK(timeline.Size() == 4);
+    CHECK(timeline.Current(210) == nullptr);
+
+    timeline.RemoveExpired(580);
+    CHECK(timeline.Size() == 1);
+    CHECK(timeline.HasValidEvent(580));
+    CHECK(!timeline.HasValidEvent(651));
+  }
+
+  void TestAgainstModel() {
+    std::mt19937 random(42);
+    for (int round = 0; round < 200; round++) {
+      Timeline timeline;
+      Model model;
+      uint64_t now = 1000;
+      for (int i = 0; i < 2000; i++) {
+        now += random() % 30;
+        if (random() % 4 != 0) {
+          auto event = MakeEvent(now - 200 + random() % 400, random() % 300, static_cast<int16_t>(random()));
+          CHECK(timeline.Insert(event, now) == model.Insert(event, now));
+        } else {
+          timeline.RemoveExpired(now);
+          model.events.erase(std::remove_if(model.events.begin(),
+                                            model.events.end(),
+                                            [now](const WeatherData::Temperature& e) {
+                                              return !IsValid(e, now);
+                                            }),
+                             model.events.end());
+        }
+
+        CHECK(timeline.Size() == model.events.size());
+        CHECK(std::equal(timeline.begin(), timeline.end(), model.events.begin(), [](const auto& a, const auto& b) {
+          return a.timestamp == b.timestamp && a.expires == b.expires && a.temperature == b.temperature;
+        }));
+        for (uint64_t t = now - 250; t < now + 250; t += 17) {
+          const auto* current = timeline.Current(t);
+          const auto* expected = model.Current(t);
+          CHECK((current == nullptr) == (expected == nullptr));
+          CHECK(current == nullptr || current->timestamp == expected->timestamp);
+        }
+        CHECK(timeline.HasValidEvent(now) == std::any_of(model.events.begin(), model.events.end(), [now](const auto& e) {
+                return IsValid(e, now);
+              }));
+      }
+    }
+  }
+
+  template <class Function> double NanosecondsPerCall(int nbCalls, Function function) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nbCalls; i++) {
+      function(i);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / nbCalls;
+  }
+
+  void Benchmark() {
+    constexpr int nbCalls = 2000000;
+    Timeline timeline;
+    volatile int64_t sink = 0;
+    uint64_t now = 1000000;
+
+    // Forecasts arrive in order, the timeline stays full and the oldest event is replaced
+    double insert = NanosecondsPerCall(nbCalls, [&](int i) {
+      timeline.Insert(MakeEvent(now + i * uint64_t {3600}, 3600, static_cast<int16_t>(i)), now);
+    });
+    double insertSame = NanosecondsPerCall(nbCalls, [&](int i) {
+      timeline.Insert(MakeEvent(now + (nbCalls - 1 - i % capacity) * uint64_t {3600}, 3600, static_cast<int16_t>(i)), now);
+    });
+    uint64_t first = timeline.end()[-1].timestamp;
+    double current = NanosecondsPerCall(nbCalls, [&](int i) {
+      const auto* event = timeline.Current(first + (i % (capacity * 3600)));
+      sink = sink + (event != nullptr ? event->temperature : 0);
+    });
+    CHECK(timeline.Size() == capacity);
+    std::printf("Capacity %u : Insert %.1f ns, Insert (replace) %.1f ns, Current %.1f ns\n", capacity, insert, insertSame, current);
+  }
+}
+
+int main() {
+  TestBasics();
+  TestAgainstModel();
+  Benchmark();
+  std::printf("WeatherTimelineTest passed\n");
+  return 0;
+}
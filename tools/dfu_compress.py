@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+
+# Compresses a DFU image (or a patch generated by dfu_delta.py) for a compressed update.
+# The watch decompresses the data as they are received, see
+# src/components/ble/DfuDecompressor.h for the format.
+#
+#   ./dfu_compress.py pinetime-mcuboot-app-image.bin -o image.bin.z
+#   adafruit-nrfutil dfu genpkg --dev-type 0x0052 --application image.bin.z pinetime-mcuboot-app-dfu-compressed.zip
+
+import argparse
+import struct
+import sys
+
+MAGIC = b'ITDZ'
+WINDOW_BITS = 11  # The decoder on the watch supports up to 11 bits (2KB)
+MIN_MATCH = 3
+MAX_CHAIN = 64
+
+
+def crc16(data):
+    """CRC16-CCITT (0x1021, initial value 0xFFFF), as computed by the watch."""
+    crc = 0xffff
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xffff
+    return crc
+
+
+def varint(value):
+    out = bytearray()
+    while True:
+        b = value & 0x7f
+        value >>= 7
+        if value:
+            out.append(b | 0x80)
+        else:
+            out.append(b)
+            return bytes(out)
+
+
+def compress(data, window_bits=WINDOW_BITS):
+    window = 1 << window_bits
+    length_bits = 16 - window_bits
+    length_mask = (1 << length_bits) - 1
+    max_length = 4096
+
+    out = bytearray(MAGIC + struct.pack('<IHBB', len(data), crc16(data), window_bits, 0))
+    heads = {}
+    chain = [0] * len(data)
+    tokens = []
+
+    def insert(pos):
+        if pos + MIN_MATCH <= len(data):
+            key = data[pos:pos + MIN_MATCH]
+            chain[pos] = heads.get(key, -1)
+            heads[key] = pos
+
+    i = 0
+    while i < len(data):
+        best_length, best_distance = 0, 0
+        candidate = heads.get(data[i:i + MIN_MATCH], -1)
+        tries = 0
+        while candidate >= 0 and i - candidate <= window and tries < MAX_CHAIN:
+            length = 0
+            limit = min(max_length, len(data) - i)
+            while length < limit and data[candidate + length] == data[i + length]:
+                length += 1
+            if length > best_length:
+                best_length, best_distance = length, i - candidate
+                if length == limit:
+                    break
+            candidate = chain[candidate]
+            tries += 1
+
+        if best_length >= MIN_MATCH:
+            code = best_length - MIN_MATCH
+            if code >= length_mask:
+                token = struct.pack('<H', (best_distance - 1) | (length_mask << window_bits)) + varint(code - length_mask)
+            else:
+                token = struct.pack('<H', (best_distance - 1) | (code << window_bits))
+            tokens.append((1, token))
+            for p in range(i, i + best_length):
+                insert(p)
+            i += best_length
+        else:
+            tokens.append((0, data[i:i + 1]))
+            insert(i)
+            i += 1
+
+    for g in range(0, len(tokens), 8):
+        group = tokens[g:g + 8]
+        flags = 0
+        for bit, (is_match, _) in enumerate(group):
+            flags |= is_match << bit
+        out.append(flags)
+        for _, token in group:
+            out += token
+    return bytes(out)
+
+
+def decompress(data):
+    """Reference implementation of the decompression done by the watch."""
+    if data[:4] != MAGIC:
+        raise ValueError('Not a compressed image')
+    size, crc, window_bits, _ = struct.unpack('<IHBB', data[4:12])
+    length_mask = (1 << (16 - window_bits)) - 1
+    out = bytearray()
+    i = 12
+    while len(out) < size:
+        flags = data[i]
+        i += 1
+        for bit in range(8):
+            if len(out) == size:
+                break
+            if flags & (1 << bit):
+                token = data[i] | (data[i + 1] << 8)
+                i += 2
+                distance = (token & ((1 << window_bits) - 1)) + 1
+                length = (token >> window_bits) + MIN_MATCH
+                if token >> window_bits == length_mask:
+                    extra, shift = 0, 0
+                    while True:
+                        b = data[i]
+                        i += 1
+                        extra |= (b & 0x7f) << shift
+                        shift += 7
+                        if not b & 0x80:
+                            break
+                    length += extra
+                for _ in range(length):
+                    out.append(out[-distance])
+            else:
+                out.append(data[i])
+                i += 1
+    if crc16(out) != crc:
+        raise ValueError('Bad CRC')
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='InfiniTime compressed DFU generator.')
+    parser.add_argument('input', help='MCUBoot image or patch')
+    parser.add_argument('-o', '--output', help='compressed file')
+    parser.add_argument('--window-bits', type=int, default=WINDOW_BITS, choices=range(8, WINDOW_BITS + 1),
+                        help='size of the window (log2)')
+    args = parser.parse_args()
+
+    with open(args.input, 'rb') as f:
+        data = f.read()
+    compressed = compress(data, args.window_bits)
+    if decompress(compressed) != data:
+        print('Round trip failed', file=sys.stderr)
+        sys.exit(1)
+    print(f'{args.input}: {len(data)} -> {len(compressed)} bytes ({len(data) / len(compressed):.2f}x)')
+
+    if args.output:
+        with open(args.output, 'wb') as f:
+            f.write(compressed)
+
+
+if __name__ == '__main__':
+    main()
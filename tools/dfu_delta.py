@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+
+# Generates a delta update (patch) between two MCUBoot images of InfiniTime.
+# The watch rebuilds the new image from the image it is running and the patch,
+# see src/components/ble/DfuPatch.h for the format.
+#
+# The patch is sent instead of the image, in a regular DFU package :
+#   ./dfu_delta.py pinetime-mcuboot-app-image-old.bin pinetime-mcuboot-app-image-new.bin -o patch.bin
+#   adafruit-nrfutil dfu genpkg --dev-type 0x0052 --application patch.bin pinetime-mcuboot-app-dfu-delta.zip
+#
+# The old image must be exactly the one installed on the watch.
+
+import argparse
+import struct
+import sys
+
+MAGIC = b'ITDP'
+MAX_IMAGE_SIZE = 475136 - 2 * 4096  # OTA slot minus the MCUBoot trailer
+KEY_SIZE = 8
+MIN_COPY = 12
+MAX_CANDIDATES = 16
+
+
+def crc16(data):
+    """CRC16-CCITT (0x1021, initial value 0xFFFF), as computed by the watch."""
+    crc = 0xffff
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xffff
+    return crc
+
+
+def varint(value):
+    out = bytearray()
+    while True:
+        b = value & 0x7f
+        value >>= 7
+        if value:
+            out.append(b | 0x80)
+        else:
+            out.append(b)
+            return bytes(out)
+
+
+def zigzag(value):
+    return (value << 1) if value >= 0 else ((-value << 1) - 1)
+
+
+def diff(old, new):
+    index = {}
+    for i in range(len(old) - KEY_SIZE + 1):
+        candidates = index.setdefault(old[i:i + KEY_SIZE], [])
+        if len(candidates) < MAX_CANDIDATES:
+            candidates.append(i)
+
+    out = bytearray()
+    literal = bytearray()
+    source_position = 0
+
+    def flush_literal():
+        if literal:
+            out.extend(varint(len(literal) << 1))
+            out.extend(literal)
+            literal.clear()
+
+    i = 0
+    while i < len(new):
+        best_length, best_offset = 0, 0
+        # The continuation of the previous copy is the cheapest one to encode
+        candidates = [source_position] + index.get(new[i:i + KEY_SIZE], [])
+        for offset in candidates:
+            length = 0
+            while (offset + length < len(old) and i + length < len(new)
+                   and old[offset + length] == new[i + length]):
+                length += 1
+            if length > best_length:
+                best_length, best_offset = length, offset
+        if best_length >= MIN_COPY:
+            flush_literal()
+            out.extend(varint((best_length << 1) | 1))
+            out.extend(varint(zigzag(best_offset - source_position)))
+            source_position = best_offset + best_length
+            i += best_length
+        else:
+            literal.append(new[i])
+            i += 1
+    flush_literal()
+
+    header = MAGIC + struct.pack('<IIHH', len(old), len(new), crc16(old), crc16(new))
+    return header + bytes(out)
+
+
+def read_varint(data, i):
+    value, shift = 0, 0
+    while True:
+        b = data[i]
+        i += 1
+        value |= (b & 0x7f) << shift
+        shift += 7
+        if not b & 0x80:
+            return value, i
+
+
+def apply(old, patch):
+    """Reference implementation of the patch application done by the watch."""
+    if patch[:4] != MAGIC:
+        raise ValueError('Not a patch')
+    source_size, target_size, source_crc, target_crc = struct.unpack('<IIHH', patch[4:16])
+    if source_size != len(old) or crc16(old) != source_crc:
+        raise ValueError('The patch does not apply to this image')
+    new = bytearray()
+    source_position = 0
+    i = 16
+    while len(new) < target_size:
+        command, i = read_varint(patch, i)
+        length = command >> 1
+        if command & 1:
+            delta, i = read_varint(patch, i)
+            source_position += (delta >> 1) ^ -(delta & 1)
+            new += old[source_position:source_position + length]
+            source_position += length
+        else:
+            new += patch[i:i + length]
+            i += length
+    if crc16(new) != target_crc:
+        raise ValueError('Bad CRC')
+    return bytes(new)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='InfiniTime delta update generator.')
+    parser.add_argument('old', help='MCUBoot image currently installed on the watch')
+    parser.add_argument('new', help='new MCUBoot image')
+    parser.add_argument('-o', '--output', help='patch file')
+    args = parser.parse_args()
+
+    with open(args.old, 'rb') as f:
+        old = f.read()
+    with open(args.new, 'rb') as f:
+        new = f.read()
+    if len(old) > 475136 or len(new) > MAX_IMAGE_SIZE:
+        print('The images are too large for the OTA slot', file=sys.stderr)
+        sys.exit(1)
+
+    patch = diff(old, new)
+    if apply(old, patch) != new:
+        print('Round trip failed', file=sys.stderr)
+        sys.exit(1)
+    print(f'{args.new}: {len(new)} bytes, patch : {len(patch)} bytes ({100 * len(patch) / len(new):.1f}%)')
+
+    if args.output:
+        with open(args.output, 'wb') as f:
+            f.write(patch)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+
+# Palette RLE encoder, see src/components/rle/PaletteRleDecoder.h for the format.
+#
+# Images with more than 256 colors are quantized. The number of bits per
+# index (2, 4 or 8) is chosen from the number of colors in the image.
+#
+# By default, the images are printed as C arrays for Gfx::DrawImage(). With
+# --file, each image is written to <name>.bin, preceded by an LVGL image
+# header, in the format read by FileImageDecoder
+# (src/displayapp/FileImageDecoder.h). The file can be copied to the
+# filesystem and displayed with lv_img_set_src(img, "F:/path/to/file.bin").
+
+import argparse
+import os.path
+import struct
+import sys
+from PIL import Image
+
+LV_IMG_CF_USER_ENCODED_0 = 24
+
+
+def rgb565(r, g, b):
+    return ((r & 0xf8) << 8) | ((g & 0xfc) << 3) | (b >> 3)
+
+
+def load(fname):
+    im = Image.open(fname).convert('RGB')
+    if len(set(im.getdata())) > 256:
+        im = im.quantize(256).convert('RGB')
+    return im.width, im.height, [rgb565(*px) for px in im.getdata()]
+
+
+def encode(pixels):
+    colors = sorted(set(pixels))
+    if len(colors) > 256:
+        raise ValueError('Too many colors ({})'.format(len(colors)))
+    index = {c: i for i, c in enumerate(colors)}
+
+    if len(colors) <= 4:
+        bits = 2
+    elif len(colors) <= 16:
+        bits = 4
+    else:
+        bits = 8
+    max_run = 256 if bits == 8 else (1 << (8 - bits))
+
+    out = bytearray([bits, len(colors) - 1])
+    for c in colors:
+        out += bytes([c >> 8, c & 0xff])
+
+    i = 0
+    while i < len(pixels):
+        rl = 1
+        while i + rl < len(pixels) and rl < max_run and pixels[i + rl] == pixels[i]:
+            rl += 1
+        if bits == 8:
+            out += bytes([rl - 1, index[pixels[i]]])
+        else:
+            out.append(((rl - 1) << bits) | index[pixels[i]])
+        i += rl
+    return bytes(out)
+
+
+def decode(data):
+    """Reference decoder, returns the list of RGB565 pixels."""
+    bits = data[0]
+    colors = data[1] + 1
+    palette = [(data[2 + 2 * i] << 8) | data[3 + 2 * i] for i in range(colors)]
+    pixels = []
+    i = 2 + 2 * colors
+    while i < len(data):
+        if bits == 8:
+            rl, idx = data[i] + 1, data[i + 1]
+            i += 2
+        else:
+            rl, idx = (data[i] >> bits) + 1, data[i] & ((1 << bits) - 1)
+            i += 1
+        pixels += [palette[idx]] * rl
+    return pixels
+
+
+def varname(p):
+    return os.path.basename(os.path.splitext(p)[0]).replace('-', '_')
+
+
+def lv_img_header(width, height):
+    # lv_img_header_t : cf (5 bits), always_zero (3 bits), reserved (2 bits), w (11 bits), h (11 bits)
+    if width > 2047 or height > 2047:
+        raise ValueError('Image too big ({}x{})'.format(width, height))
+    return struct.pack('<I', LV_IMG_CF_USER_ENCODED_0 | (width << 10) | (height << 21))
+
+
+def write_file(data, fname, width, height):
+    output = os.path.splitext(os.path.basename(fname))[0] + '.bin'
+    with open(output, 'wb') as f:
+        f.write(lv_img_header(width, height) + data)
+    print(f'{fname} -> {output}')
+
+
+def render_c(data, fname, bits):
+    print(f'// {bits}-bit palette RLE, generated from {os.path.basename(fname)}, {len(data)} bytes')
+    print(f'static const uint8_t {varname(fname)}[] = {{')
+    print(' ', end='')
+    for i, b in enumerate(data):
+        print(f' {hex(b)},', end='')
+        if i % 12 == 11:
+            print('\n ', end='')
+    print('\n};')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Palette RLE encoder tool.')
+    parser.add_argument('files', nargs='+', help='files to be encoded')
+    parser.add_argument('--stats', action='store_true',
+                        help='Only print the compression ratio of each file')
+    parser.add_argument('--file', action='store_true',
+                        help='Write each image to <name>.bin, for the LVGL file image decoder')
+    args = parser.parse_args()
+
+    for fname in args.files:
+        width, height, pixels = load(fname)
+        data = encode(pixels)
+        if decode(data) != pixels:
+            print(f'{fname}: decoding failed', file=sys.stderr)
+            sys.exit(1)
+
+        if args.stats:
+            raw = width * height * 2
+            print(f'{fname}: {width}x{height}, {data[1] + 1} colors, {data[0]} bits, '
+                  f'{len(data)} bytes ({raw / len(data):.1f}x smaller than RGB565)')
+        elif args.file:
+            try:
+                write_file(data, fname, width, height)
+            except ValueError as e:
+                print(f'{fname}: {e}', file=sys.stderr)
+                sys.exit(1)
+        else:
+            render_c(data, fname, data[0])
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+
+# Converts a trace dumped by the watch (/trace.bin, see doc/DebugService.md) into the Chrome trace event format,
+# which can be opened with chrome://tracing or https://ui.perfetto.dev :
+#   ./trace_decode.py trace.bin -o trace.json
+#
+# The event IDs are read from src/logging/Trace.h, so that the decoder always matches the firmware of the tree.
+# Each event is displayed in the track named after the first word of its name (Display, Spi, Twi, Ble, Fs).
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+MAGIC = b'ITTR'
+VERSION = 1
+HEADER = struct.Struct('<4sBBHI')
+RECORD = struct.Struct('<IBBH')
+ISR_FLAG = 0x80
+PHASES = {0: 'B', 1: 'E', 2: 'i'}
+DEFAULT_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'src', 'logging', 'Trace.h')
+
+
+def read_events(header_path):
+    """Returns {id: name} from the Events enum of Trace.h."""
+    with open(header_path) as f:
+        source = f.read()
+    enum = re.search(r'enum class Events : uint8_t \{(.*?)\};', source, re.S)
+    if enum is None:
+        sys.exit('Events enum not found in {}'.format(header_path))
+    return {int(value): name for name, value in re.findall(r'(\w+)\s*=\s*(\d+)', enum.group(1))}
+
+
+def track_of(name):
+    return re.match(r'[A-Z][a-z0-9]*', name).group(0)
+
+
+def decode(data, events):
+    if len(data) < HEADER.size:
+        sys.exit('The file is too small')
+    magic, version, record_size, count, frequency = HEADER.unpack_from(data)
+    if magic != MAGIC or version != VERSION or record_size != RECORD.size:
+        sys.exit('Unsupported trace (magic {}, version {}, record size {})'.format(magic, version, record_size))
+    if len(data) < HEADER.size + count * RECORD.size:
+        sys.exit('The file is truncated')
+
+    tracks = {}
+    trace_events = []
+    wraps = 0
+    previous = None
+    for i in range(count):
+        timestamp, event, flags, argument = RECORD.unpack_from(data, HEADER.size + i * RECORD.size)
+        # The 32 bits timer wraps around every 71 minutes at 1MHz
+        if previous is not None and timestamp < previous:
+            wraps += 1
+        previous = timestamp
+
+        name = events.get(event, 'Unknown{}'.format(event))
+        track = tracks.setdefault(track_of(name), len(tracks) + 1)
+        phase = PHASES.get(flags & ~ISR_FLAG, 'i')
+        trace_event = {
+            'name': name,
+            'cat': track_of(name),
+            'ph': phase,
+            'ts': ((wraps << 32) + timestamp) * 1000000 / frequency,
+            'pid': 1,
+            'tid': track,
+            'args': {'argument': argument, 'isr': bool(flags & ISR_FLAG)},
+        }
+        if phase == 'i':
+            trace_event['s'] = 't'
+        trace_events.append(trace_event)
+
+    metadata = [{'name': 'process_name', 'ph': 'M', 'pid': 1, 'args': {'name': 'InfiniTime'}}]
+    for name, tid in tracks.items():
+        metadata.append({'name': 'thread_name', 'ph': 'M', 'pid': 1, 'tid': tid, 'args': {'name': name}})
+    return {'traceEvents': metadata + trace_events, 'displayTimeUnit': 'ms'}
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Converts an InfiniTime trace into a Chrome trace (JSON)')
+    parser.add_argument('trace', help='trace file downloaded from the watch')
+    parser.add_argument('-o', '--output', help='output file (default: stdout)')
+    parser.add_argument('--header', default=DEFAULT_HEADER, help='path to src/logging/Trace.h')
+    args = parser.parse_args()
+
+    with open(args.trace, 'rb') as f:
+        data = f.read()
+    result = decode(data, read_events(args.header))
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(result, f)
+    else:
+        json.dump(result, sys.stdout)
+
+
+if __name__ == '__main__':
+    main()